@@ -0,0 +1,61 @@
+#!/bin/bash
+# bench_bridge.sh - Replay a bridge trace against a headless editor
+#
+# Usage: ./bench_bridge.sh [small|medium|large] [trace.jsonl] [extra replay args...]
+# Without a trace, a synthetic one (get_scene_tree, search_in_scripts,
+# map_set_cells_batch, capture_viewport) is generated for the fixture size.
+# Set GODOT_BIN to the editor binary (defaults to the one build_godot.sh makes).
+
+set -e
+
+SCRIPT_DIR="$(cd "$(dirname "$0")" && pwd)"
+REPLAY="$SCRIPT_DIR/modules/godot_bridge/tools/bridge_replay.py"
+SIZE="${1:-small}"
+TRACE="$2"
+shift $(( $# > 2 ? 2 : $# ))
+
+if [ -z "$GODOT_BIN" ]; then
+    GODOT_BIN="$(ls "$SCRIPT_DIR"/godot-engine/bin/godot.*.editor.* 2>/dev/null | head -n 1)"
+fi
+if [ ! -x "$GODOT_BIN" ]; then
+    echo "Error: editor binary not found, set GODOT_BIN"
+    exit 1
+fi
+
+WORK_DIR="$(mktemp -d)"
+trap 'kill $EDITOR_PID 2>/dev/null || true; rm -rf "$WORK_DIR"' EXIT
+
+echo "=== Bridge Benchmark ($SIZE) ==="
+python3 "$REPLAY" make-fixture "$SIZE" "$WORK_DIR/project"
+if [ -z "$TRACE" ]; then
+    TRACE="$WORK_DIR/bench_$SIZE.jsonl"
+    python3 "$REPLAY" make-trace "$SIZE" "$TRACE"
+fi
+
+# Import once so the first replayed commands don't pay for it
+"$GODOT_BIN" --headless --editor --path "$WORK_DIR/project" --quit >/dev/null 2>&1 || true
+
+"$GODOT_BIN" --headless --editor --path "$WORK_DIR/project" "$WORK_DIR/project/main.tscn" >"$WORK_DIR/editor.log" 2>&1 &
+EDITOR_PID=$!
+
+echo "Waiting for bridge on port 9876..."
+BRIDGE_UP=0
+for i in $(seq 1 120); do
+    if python3 -c "import socket; socket.create_connection(('127.0.0.1', 9876), 1).close()" 2>/dev/null; then
+        BRIDGE_UP=1
+        break
+    fi
+    if ! kill -0 $EDITOR_PID 2>/dev/null; then
+        echo "Editor exited early, log:"
+        cat "$WORK_DIR/editor.log"
+        exit 1
+    fi
+    sleep 0.5
+done
+if [ "$BRIDGE_UP" != 1 ]; then
+    echo "Bridge did not come up within 60s, log:"
+    cat "$WORK_DIR/editor.log"
+    exit 1
+fi
+
+python3 "$REPLAY" replay "$TRACE" "$@"
@@ -6,12 +6,62 @@
 //*****************************************************************************
 
 #include "gdbrowser.h"
+#include "gdshared_texture.h"
 
 #include "core/string/print_string.h"
+#include "core/os/os.h"
+#include "core/io/json.h"
+#include "core/crypto/crypto_core.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#include <emmintrin.h>
+#define GDBROWSER_SWIZZLE_SSE2
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define GDBROWSER_SWIZZLE_NEON
+#endif
 
 // Callback wrappers called from gdbrowser_impl.cpp
-extern "C" void gdbrowser_owner_on_paint(GDBrowserView* owner, const void* buffer, int width, int height) {
-    if (owner) owner->on_paint(buffer, width, height);
+extern "C" void gdbrowser_owner_on_paint(GDBrowserView* owner, const void* buffer, int width, int height,
+                                         const int* dirty_rects, int dirty_rect_count) {
+    if (owner) owner->on_paint(buffer, width, height, dirty_rects, dirty_rect_count);
+}
+
+//------------------------------------------------------------------------------
+// BGRA -> RGBA for one row of pixels. Swaps bytes 0 and 2 of every pixel,
+// 4 (SSE2) or 16 (NEON) pixels per step.
+//------------------------------------------------------------------------------
+static void swizzle_bgra_row(const uint8_t* src, uint8_t* dst, int pixels) {
+    int i = 0;
+#if defined(GDBROWSER_SWIZZLE_SSE2)
+    const __m128i keep = _mm_set1_epi32((int)0xFF00FF00);
+    const __m128i low = _mm_set1_epi32(0x000000FF);
+    for (; i + 4 <= pixels; i += 4) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 4));
+        __m128i swapped = _mm_or_si128(_mm_and_si128(v, keep),
+                          _mm_or_si128(_mm_and_si128(_mm_srli_epi32(v, 16), low),
+                                       _mm_slli_epi32(_mm_and_si128(v, low), 16)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4), swapped);
+    }
+#elif defined(GDBROWSER_SWIZZLE_NEON)
+    for (; i + 16 <= pixels; i += 16) {
+        uint8x16x4_t v = vld4q_u8(src + i * 4);
+        uint8x16_t b = v.val[0];
+        v.val[0] = v.val[2];
+        v.val[2] = b;
+        vst4q_u8(dst + i * 4, v);
+    }
+#endif
+    for (; i < pixels; i++) {
+        dst[i * 4 + 0] = src[i * 4 + 2];  // R <- B
+        dst[i * 4 + 1] = src[i * 4 + 1];  // G <- G
+        dst[i * 4 + 2] = src[i * 4 + 0];  // B <- R
+        dst[i * 4 + 3] = src[i * 4 + 3];  // A <- A
+    }
+}
+
+extern "C" void gdbrowser_owner_on_accelerated_paint(GDBrowserView* owner, uint64_t handle) {
+    if (owner) owner->on_accelerated_paint(handle);
 }
 
 extern "C" void gdbrowser_owner_on_load(GDBrowserView* owner, bool success, const char* url) {
@@ -22,6 +72,11 @@ extern "C" void gdbrowser_owner_on_title(GDBrowserView* owner, const char* title
     if (owner) owner->on_title_change(title);
 }
 
+extern "C" void gdbrowser_owner_on_query_result(GDBrowserView* owner, int query_id, bool success,
+                                                const char* json, size_t size) {
+    if (owner) owner->on_query_result(query_id, success, json, size);
+}
+
 // Forward declaration - do not include impl headers
 class GDBrowserImpl;
 class GDCefImpl;
@@ -31,7 +86,8 @@ extern "C" {
     GDBrowserImpl* gdbrowser_impl_create(GDBrowserView* owner);
     void gdbrowser_impl_destroy(GDBrowserImpl* impl);
     bool gdbrowser_impl_init(GDBrowserImpl* impl, GDCefImpl* cef_impl,
-                             const char* url, int width, int height, int frame_rate);
+                             const char* url, int width, int height, int frame_rate,
+                             bool async);
     void gdbrowser_impl_close(GDBrowserImpl* impl);
     int gdbrowser_impl_id(GDBrowserImpl* impl);
     bool gdbrowser_impl_is_valid(GDBrowserImpl* impl);
@@ -51,6 +107,7 @@ extern "C" {
     void gdbrowser_impl_send_char(GDBrowserImpl* impl, char c);
     void gdbrowser_impl_set_focus(GDBrowserImpl* impl, bool focused);
     void gdbrowser_impl_execute_javascript(GDBrowserImpl* impl, const char* js);
+    int gdbrowser_impl_evaluate_javascript(GDBrowserImpl* impl, const char* expression);
     void gdbrowser_impl_set_muted(GDBrowserImpl* impl, bool muted);
     void gdbrowser_impl_set_hidden(GDBrowserImpl* impl, bool hidden);
     void gdbrowser_impl_was_resized(GDBrowserImpl* impl, int width, int height);
@@ -79,6 +136,8 @@ void GDBrowserView::_bind_methods() {
     ClassDB::bind_method(D_METHOD("send_text", "text"), &GDBrowserView::send_text);
     ClassDB::bind_method(D_METHOD("set_focus", "focused"), &GDBrowserView::set_focus);
     ClassDB::bind_method(D_METHOD("execute_javascript", "javascript"), &GDBrowserView::execute_javascript);
+    ClassDB::bind_method(D_METHOD("query_javascript", "expression", "callback", "timeout_msec"), &GDBrowserView::query_javascript, DEFVAL(Callable()), DEFVAL(10000));
+    ClassDB::bind_method(D_METHOD("get_pending_query_count"), &GDBrowserView::get_pending_query_count);
     ClassDB::bind_method(D_METHOD("set_muted", "muted"), &GDBrowserView::set_muted);
     ClassDB::bind_method(D_METHOD("is_muted"), &GDBrowserView::is_muted);
     ClassDB::bind_method(D_METHOD("set_hidden", "hidden"), &GDBrowserView::set_hidden);
@@ -93,13 +152,15 @@ void GDBrowserView::_bind_methods() {
     ADD_SIGNAL(MethodInfo("page_loaded", PropertyInfo(Variant::STRING, "url")));
     ADD_SIGNAL(MethodInfo("page_failed", PropertyInfo(Variant::STRING, "url"), PropertyInfo(Variant::STRING, "error")));
     ADD_SIGNAL(MethodInfo("title_changed", PropertyInfo(Variant::STRING, "title")));
+    ADD_SIGNAL(MethodInfo("query_completed", PropertyInfo(Variant::INT, "id"), PropertyInfo(Variant::NIL, "result", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NIL_IS_VARIANT), PropertyInfo(Variant::STRING, "error")));
 }
 
 //------------------------------------------------------------------------------
 GDBrowserView::GDBrowserView() {
     print_line("[gdCEF] GDBrowserView created");
     m_texture.instantiate();
-    m_image.instantiate();
+    m_frames[0].instantiate();
+    m_frames[1].instantiate();
 }
 
 //------------------------------------------------------------------------------
@@ -110,11 +171,11 @@ GDBrowserView::~GDBrowserView() {
 
 //------------------------------------------------------------------------------
 bool GDBrowserView::init(const String &url, TextureRect *texture_rect, 
-                         GDCefImpl *cef_impl, Dictionary config) {
+                         GDCefImpl *cef_impl, Dictionary config, bool pooled) {
     m_texture_rect = texture_rect;
     m_url = url;
     
-    Vector2 size = texture_rect->get_size();
+    Vector2 size = texture_rect ? texture_rect->get_size() : Vector2(config.get("width", 0), config.get("height", 0));
     m_width = (int)size.x;
     m_height = (int)size.y;
     if (m_width <= 0) m_width = 800;
@@ -128,12 +189,14 @@ bool GDBrowserView::init(const String &url, TextureRect *texture_rect,
     m_impl = gdbrowser_impl_create(this);
     
     // Initialize image
-    m_image->initialize_data(m_width, m_height, false, Image::FORMAT_RGBA8);
-    m_texture->set_image(m_image);
-    m_texture_rect->set_texture(m_texture);
+    _reset_frames();
+    if (m_texture_rect) m_texture_rect->set_texture(m_texture);
+    
+    // Pooled browsers never paint until attached
+    if (pooled) set_hidden(true);
     
     // Create browser
-    if (!gdbrowser_impl_init(m_impl, cef_impl, url.utf8().get_data(), m_width, m_height, m_frame_rate)) {
+    if (!gdbrowser_impl_init(m_impl, cef_impl, url.utf8().get_data(), m_width, m_height, m_frame_rate, pooled)) {
         gdbrowser_impl_destroy(m_impl);
         m_impl = nullptr;
         return false;
@@ -142,6 +205,20 @@ bool GDBrowserView::init(const String &url, TextureRect *texture_rect,
     return true;
 }
 
+void GDBrowserView::attach(TextureRect *texture_rect) {
+    m_texture_rect = texture_rect;
+    if (!m_texture_rect) return;
+    m_texture_rect->set_texture(get_texture());
+    Vector2 size = m_texture_rect->get_size();
+    if (size.x > 0 && size.y > 0 && ((int)size.x != m_width || (int)size.y != m_height)) {
+        resize(size);
+    }
+}
+
+void GDBrowserView::detach() {
+    m_texture_rect = nullptr;
+}
+
 //------------------------------------------------------------------------------
 int GDBrowserView::id() const { return m_impl ? gdbrowser_impl_id(m_impl) : -1; }
 String GDBrowserView::get_error() const { return m_error; }
@@ -173,7 +250,10 @@ bool GDBrowserView::has_next_page() const { return m_impl ? gdbrowser_impl_can_g
 void GDBrowserView::previous_page() { if (m_impl) gdbrowser_impl_go_back(m_impl); }
 void GDBrowserView::next_page() { if (m_impl) gdbrowser_impl_go_forward(m_impl); }
 
-Ref<ImageTexture> GDBrowserView::get_texture() const { return m_texture; }
+Ref<Texture2D> GDBrowserView::get_texture() const {
+    if (m_shared_texture && m_shared_texture->get_width() > 0) return m_shared_texture->get_texture();
+    return m_texture;
+}
 
 void GDBrowserView::resize(Vector2 size) {
     m_width = (int)size.x;
@@ -181,8 +261,7 @@ void GDBrowserView::resize(Vector2 size) {
     if (m_width <= 0) m_width = 800;
     if (m_height <= 0) m_height = 600;
     
-    m_image->initialize_data(m_width, m_height, false, Image::FORMAT_RGBA8);
-    m_texture->set_image(m_image);
+    _reset_frames();
     
     if (m_impl) gdbrowser_impl_was_resized(m_impl, m_width, m_height);
 }
@@ -221,6 +300,145 @@ void GDBrowserView::execute_javascript(const String &javascript) {
     if (m_impl) gdbrowser_impl_execute_javascript(m_impl, javascript.utf8().get_data());
 }
 
+//------------------------------------------------------------------------------
+// JS queries
+// The expression runs inside an async wrapper that awaits it and JSON-encodes
+// the value, with binary data tagged and base64'd so it survives the trip
+//------------------------------------------------------------------------------
+static const char *QUERY_PRELUDE =
+    "(async () => {"
+    "const b64 = (u8) => { let s = ''; for (let i = 0; i < u8.length; i += 0x8000) s += String.fromCharCode.apply(null, u8.subarray(i, i + 0x8000)); return btoa(s); };"
+    "const enc = (x) => {"
+    " if (typeof ImageData !== 'undefined' && x instanceof ImageData) return { __gd_image: b64(new Uint8Array(x.data.buffer, x.data.byteOffset, x.data.byteLength)), width: x.width, height: x.height };"
+    " if (x instanceof ArrayBuffer) return { __gd_bytes: b64(new Uint8Array(x)) };"
+    " if (ArrayBuffer.isView(x)) return { __gd_bytes: b64(new Uint8Array(x.buffer, x.byteOffset, x.byteLength)) };"
+    " if (Array.isArray(x)) return x.map(enc);"
+    " if (x && typeof x === 'object') { const o = {}; for (const k in x) o[k] = enc(x[k]); return o; }"
+    " return x === undefined ? null : x; };"
+    "return JSON.stringify(enc(await (";
+static const char *QUERY_EPILOGUE = "\n)));})()";
+
+int GDBrowserView::query_javascript(const String &expression, const Callable &callback, int timeout_msec) {
+    if (!m_impl) return -1;
+    
+    String wrapped = String(QUERY_PRELUDE) + expression + String(QUERY_EPILOGUE);
+    int query_id = gdbrowser_impl_evaluate_javascript(m_impl, wrapped.utf8().get_data());
+    if (query_id <= 0) return -1;
+    
+    PendingQuery query;
+    query.callback = callback;
+    query.deadline_msec = OS::get_singleton()->get_ticks_msec() + (uint64_t)MAX(timeout_msec, 1);
+    m_queries.insert(query_id, query);
+    set_process(true);  // Timeout checks while queries are pending
+    return query_id;
+}
+
+int GDBrowserView::get_pending_query_count() const { return m_queries.size(); }
+
+Variant GDBrowserView::_decode_query_value(const Variant &value) {
+    if (value.get_type() == Variant::ARRAY) {
+        Array in = value;
+        Array out;
+        out.resize(in.size());
+        for (int i = 0; i < in.size(); i++) {
+            out[i] = _decode_query_value(in[i]);
+        }
+        return out;
+    }
+    if (value.get_type() != Variant::DICTIONARY) {
+        return value;
+    }
+    
+    Dictionary dict = value;
+    String encoded;
+    if (dict.has("__gd_bytes")) {
+        encoded = dict["__gd_bytes"];
+    } else if (dict.has("__gd_image")) {
+        encoded = dict["__gd_image"];
+    } else {
+        Dictionary out;
+        for (const Variant *key = dict.next(nullptr); key; key = dict.next(key)) {
+            out[*key] = _decode_query_value(dict[*key]);
+        }
+        return out;
+    }
+    
+    CharString ascii = encoded.ascii();
+    PackedByteArray bytes;
+    bytes.resize(ascii.length() / 4 * 3 + 3);
+    size_t decoded = 0;
+    if (CryptoCore::b64_decode(bytes.ptrw(), bytes.size(), &decoded, (const uint8_t *)ascii.get_data(), ascii.length()) != OK) {
+        return Variant();
+    }
+    bytes.resize(decoded);
+    
+    if (dict.has("__gd_bytes")) {
+        return bytes;
+    }
+    int width = dict.get("width", 0);
+    int height = dict.get("height", 0);
+    if (width <= 0 || height <= 0 || (int64_t)bytes.size() != (int64_t)width * height * 4) {
+        return Variant();
+    }
+    return Image::create_from_data(width, height, false, Image::FORMAT_RGBA8, bytes);
+}
+
+void GDBrowserView::on_query_result(int query_id, bool success, const char* json, size_t size) {
+    if (!m_queries.has(query_id)) return;  // Timed out already, or not ours
+    
+    String text = String::utf8(json, (int)size);
+    JSON parser;
+    if (parser.parse(text) != OK || parser.get_data().get_type() != Variant::DICTIONARY) {
+        _finish_query(query_id, Variant(), "Malformed DevTools response");
+        return;
+    }
+    Dictionary response = parser.get_data();
+    if (!success) {
+        _finish_query(query_id, Variant(), response.get("message", "Runtime.evaluate failed"));
+        return;
+    }
+    
+    if (response.has("exceptionDetails")) {
+        Dictionary details = response["exceptionDetails"];
+        Dictionary exception = details.get("exception", Dictionary());
+        String message = exception.get("description", details.get("text", "JavaScript exception"));
+        _finish_query(query_id, Variant(), message);
+        return;
+    }
+    
+    Dictionary result = response.get("result", Dictionary());
+    String value = result.get("value", "null");
+    if (parser.parse(value) != OK) {
+        _finish_query(query_id, Variant(), "Result is not JSON-serializable");
+        return;
+    }
+    _finish_query(query_id, _decode_query_value(parser.get_data()), String());
+}
+
+void GDBrowserView::_finish_query(int query_id, const Variant &result, const String &error) {
+    PendingQuery query = m_queries[query_id];
+    m_queries.erase(query_id);
+    if (m_queries.is_empty()) set_process(false);
+    
+    if (query.callback.is_valid()) {
+        query.callback.call(query_id, result, error);
+    }
+    emit_signal("query_completed", query_id, result, error);
+}
+
+void GDBrowserView::_notification(int p_what) {
+    if (p_what != NOTIFICATION_PROCESS || m_queries.is_empty()) return;
+    
+    uint64_t now = OS::get_singleton()->get_ticks_msec();
+    LocalVector<int> expired;
+    for (const KeyValue<int, PendingQuery> &kv : m_queries) {
+        if (now >= kv.value.deadline_msec) expired.push_back(kv.key);
+    }
+    for (int query_id : expired) {
+        _finish_query(query_id, Variant(), "Query timed out");
+    }
+}
+
 void GDBrowserView::set_muted(bool muted) {
     if (m_impl) {
         gdbrowser_impl_set_muted(m_impl, muted);
@@ -247,43 +465,106 @@ void GDBrowserView::set_frame_rate(int fps) {
 int GDBrowserView::get_frame_rate() const { return m_frame_rate; }
 
 void GDBrowserView::close() {
+    // Pending queries can't complete any more
+    while (!m_queries.is_empty()) {
+        _finish_query(m_queries.begin()->key, Variant(), "Browser closed");
+    }
     if (m_impl) {
         gdbrowser_impl_close(m_impl);
         gdbrowser_impl_destroy(m_impl);
         m_impl = nullptr;
     }
+    if (m_shared_texture) {
+        memdelete(m_shared_texture);
+        m_shared_texture = nullptr;
+    }
 }
 
 //------------------------------------------------------------------------------
 // Callbacks from impl - these are called from gdbrowser_impl.cpp
 //------------------------------------------------------------------------------
-void GDBrowserView::on_paint(const void* buffer, int width, int height) {
-    static int paint_count = 0;
-    if (paint_count++ % 30 == 0) {  // Log every 30 frames to avoid spam
-        print_line(String("[gdCEF] on_paint: ") + itos(width) + "x" + itos(height) + 
-                   " texture_rect=" + (m_texture_rect ? "valid" : "null"));
+void GDBrowserView::_reset_frames() {
+    for (Ref<Image> &frame : m_frames) {
+        frame->initialize_data(m_width, m_height, false, Image::FORMAT_RGBA8);
     }
+    m_texture->set_image(m_frames[m_back_frame]);
+    m_back_frame ^= 1;
+    m_prev_dirty.clear();
+    m_texture_sized = true;
+}
+
+void GDBrowserView::on_paint(const void* buffer, int width, int height,
+                             const int* dirty_rects, int dirty_rect_count) {
+    if (!m_texture.is_valid() || !m_texture_rect || width <= 0 || height <= 0) return;
     
-    if (!m_image.is_valid() || !m_texture.is_valid() || !m_texture_rect) return;
+    Ref<Image> &frame = m_frames[m_back_frame];
+    bool full = !m_texture_sized || frame->get_width() != width || frame->get_height() != height;
+    if (full) {
+        // CEF caught up with a resize (or the first paint): both frames start over
+        for (Ref<Image> &f : m_frames) {
+            f->initialize_data(width, height, false, Image::FORMAT_RGBA8);
+        }
+        m_prev_dirty.clear();
+    }
     
-    // BGRA -> RGBA conversion
-    PackedByteArray data;
-    data.resize(width * height * 4);
+    const Rect2i bounds(0, 0, width, height);
+    Vector<Rect2i> dirty;
+    if (full || dirty_rect_count <= 0) {
+        dirty.push_back(bounds);
+    } else {
+        for (int i = 0; i < dirty_rect_count; i++) {
+            const int* r = dirty_rects + i * 4;
+            Rect2i rect = Rect2i(r[0], r[1], r[2], r[3]).intersection(bounds);
+            if (rect.has_area()) dirty.push_back(rect);
+        }
+        if (dirty.is_empty()) return;
+    }
     
     const uint8_t* src = static_cast<const uint8_t*>(buffer);
-    uint8_t* dst = data.ptrw();
+    uint8_t* dst = frame->ptrw();
+    const int stride = width * 4;
+    int swizzled = 0;
+    auto swizzle_rect = [&](const Rect2i &rect) {
+        for (int y = rect.position.y; y < rect.position.y + rect.size.y; y++) {
+            int offset = y * stride + rect.position.x * 4;
+            swizzle_bgra_row(src + offset, dst + offset, rect.size.x);
+        }
+        swizzled += rect.size.x * rect.size.y;
+    };
+    for (const Rect2i &rect : dirty) swizzle_rect(rect);
+    for (const Rect2i &rect : m_prev_dirty) swizzle_rect(rect);
+    m_prev_dirty = dirty;
     
-    for (int i = 0; i < width * height; i++) {
-        dst[i * 4 + 0] = src[i * 4 + 2];  // R <- B
-        dst[i * 4 + 1] = src[i * 4 + 1];  // G <- G
-        dst[i * 4 + 2] = src[i * 4 + 0];  // B <- R
-        dst[i * 4 + 3] = src[i * 4 + 3];  // A <- A
+    // Same size and format: update() reuses the texture instead of recreating it
+    if (full) {
+        m_texture->set_image(frame);
+        m_texture_sized = true;
+    } else {
+        m_texture->update(frame);
+    }
+    m_back_frame ^= 1;
+    
+    print_verbose(String("[gdCEF] on_paint: ") + itos(width) + "x" + itos(height) +
+                  " dirty=" + itos(dirty.size()) + " swizzled_px=" + itos(swizzled));
+}
+
+void GDBrowserView::on_accelerated_paint(uint64_t handle) {
+    if (!m_texture_rect || m_shared_texture_failed) return;
+    
+    if (!m_shared_texture) {
+        m_shared_texture = memnew(GDSharedTexture);
+    }
+    if (!m_shared_texture->update(handle)) {
+        // Logged once; the view keeps showing its last frame
+        m_shared_texture_failed = true;
+        print_line("[gdCEF] ERROR: Could not import shared texture, accelerated frames are dropped");
+        return;
     }
     
-    // Use set_data to update existing image (not create_from_data which makes new ref)
-    m_image->set_data(width, height, false, Image::FORMAT_RGBA8, data);
-    m_texture->set_image(m_image);
-    m_texture_rect->set_texture(m_texture);
+    Ref<Texture2D> texture = m_shared_texture->get_texture();
+    if (m_texture_rect->get_texture() != texture) {
+        m_texture_rect->set_texture(texture);
+    }
 }
 
 void GDBrowserView::on_load_complete(bool success, const char* url) {
@@ -15,10 +15,13 @@
 #include "core/variant/dictionary.h"
 #include "core/variant/callable.h"
 #include "core/io/image.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
 
 // Forward declaration for pimpl
 class GDBrowserImpl;
 class GDCefImpl;
+class GDSharedTexture;
 
 //*****************************************************************************
 // GDBrowserView - A single browser instance
@@ -29,6 +32,7 @@ class GDBrowserView : public Node {
 
 protected:
     static void _bind_methods();
+    void _notification(int p_what);
 
 public:
     GDBrowserView();
@@ -37,7 +41,11 @@ public:
     // -------------------------------------------------------------------------
     // Initialization (called by GDCef::create_browser)
     // -------------------------------------------------------------------------
-    bool init(const String &url, TextureRect *texture_rect, GDCefImpl *cef_impl, Dictionary config);
+    // texture_rect may be null for pooled browsers, which are created
+    // asynchronously and hidden until attach()
+    bool init(const String &url, TextureRect *texture_rect, GDCefImpl *cef_impl, Dictionary config, bool pooled = false);
+    void attach(TextureRect *texture_rect);
+    void detach();
 
     // -------------------------------------------------------------------------
     // Properties
@@ -68,7 +76,8 @@ public:
     // -------------------------------------------------------------------------
     // Rendering
     // -------------------------------------------------------------------------
-    Ref<ImageTexture> get_texture() const;
+    // ImageTexture in software mode, Texture2DRD once accelerated frames arrive
+    Ref<Texture2D> get_texture() const;
     void resize(Vector2 size);
     
     // -------------------------------------------------------------------------
@@ -87,6 +96,14 @@ public:
     // -------------------------------------------------------------------------
     void execute_javascript(const String &javascript);
     
+    // Evaluate an expression (a Promise is awaited) and get its value back.
+    // Returns the query id, or -1 if the browser isn't ready. The result
+    // arrives through query_completed and the optional callback as
+    // (id, result, error). ArrayBuffer/typed arrays become PackedByteArray,
+    // ImageData becomes an RGBA8 Image.
+    int query_javascript(const String &expression, const Callable &callback = Callable(), int timeout_msec = 10000);
+    int get_pending_query_count() const;
+    
     // -------------------------------------------------------------------------
     // Audio
     // -------------------------------------------------------------------------
@@ -109,9 +126,13 @@ public:
     // -------------------------------------------------------------------------
     // Callbacks from impl (called from CEF thread)
     // -------------------------------------------------------------------------
-    void on_paint(const void* buffer, int width, int height);
+    // dirty_rects holds dirty_rect_count rects as x, y, width, height
+    void on_paint(const void* buffer, int width, int height,
+                  const int* dirty_rects, int dirty_rect_count);
+    void on_accelerated_paint(uint64_t handle);
     void on_load_complete(bool success, const char* url);
     void on_title_change(const char* title);
+    void on_query_result(int query_id, bool success, const char* json, size_t size);
 
 private:
     GDBrowserImpl* m_impl = nullptr;
@@ -119,7 +140,30 @@ private:
     // Godot objects
     TextureRect* m_texture_rect = nullptr;
     Ref<ImageTexture> m_texture;
-    Ref<Image> m_image;
+    
+    // Double-buffered RGBA staging: each paint only swizzles its dirty rects
+    // (plus the previous paint's, which the back frame hasn't seen yet) into
+    // the back frame while the renderer may still read the front one
+    Ref<Image> m_frames[2];
+    int m_back_frame = 0;
+    Vector<Rect2i> m_prev_dirty;
+    bool m_texture_sized = false;  // Texture matches the frame size, so update() suffices
+    
+    void _reset_frames();
+    
+    // JS queries waiting for their Runtime.evaluate result
+    struct PendingQuery {
+        Callable callback;
+        uint64_t deadline_msec = 0;
+    };
+    HashMap<int, PendingQuery> m_queries;
+    
+    void _finish_query(int query_id, const Variant &result, const String &error);
+    static Variant _decode_query_value(const Variant &value);
+    
+    // Accelerated mode: frames stay on the GPU
+    GDSharedTexture* m_shared_texture = nullptr;
+    bool m_shared_texture_failed = false;
     
     // State
     String m_error;
@@ -10,10 +10,14 @@
 #include "include/cef_render_handler.h"
 #include "include/cef_load_handler.h"
 #include "include/cef_display_handler.h"
+#include "include/cef_devtools_message_observer.h"
+#include "include/cef_values.h"
 
 #include <string>
 #include <iostream>
 #include <functional>
+#include <vector>
+#include <cstdint>
 
 // Forward declarations from gdcef_impl.cpp
 class GDCefImpl;
@@ -23,6 +27,27 @@ extern "C" CefBrowserSettings* gdcef_impl_get_browser_settings(GDCefImpl* impl);
 // Forward declaration for callback owner
 class GDBrowserView;
 
+//*****************************************************************************
+// QueryObserver - Receives Runtime.evaluate results for JS queries
+// DevTools methods run in the browser process, so the prebuilt helper needs
+// no renderer-side message router
+//*****************************************************************************
+class QueryObserver : public CefDevToolsMessageObserver {
+public:
+    using ResultCallback = std::function<void(int, bool, const char*, size_t)>;
+
+    explicit QueryObserver(ResultCallback cb) : m_cb(cb) {}
+
+    void OnDevToolsMethodResult(CefRefPtr<CefBrowser> browser, int message_id, bool success,
+                                const void* result, size_t result_size) override {
+        if (m_cb) m_cb(message_id, success, static_cast<const char*>(result), result_size);
+    }
+
+private:
+    ResultCallback m_cb;
+    IMPLEMENT_REFCOUNTING(QueryObserver);
+};
+
 //*****************************************************************************
 // BrowserHandler - Combined CEF handler
 //*****************************************************************************
@@ -32,7 +57,10 @@ class BrowserHandler : public CefClient,
                        public CefLoadHandler,
                        public CefDisplayHandler {
 public:
-    using PaintCallback = std::function<void(const void*, int, int)>;
+    // Dirty rects arrive flattened as x, y, width, height per rect
+    using PaintCallback = std::function<void(const void*, int, int, const int*, int)>;
+    // Shared texture handle (IOSurfaceRef on macOS), only valid during the call
+    using AcceleratedPaintCallback = std::function<void(uint64_t)>;
     using LoadCallback = std::function<void(bool, const char*)>;
     using TitleCallback = std::function<void(const char*)>;
 
@@ -40,11 +68,17 @@ public:
     virtual ~BrowserHandler() {}
 
     void set_paint_callback(PaintCallback cb) { m_paint_cb = cb; }
+    void set_accelerated_paint_callback(AcceleratedPaintCallback cb) { m_accelerated_paint_cb = cb; }
     void set_load_callback(LoadCallback cb) { m_load_cb = cb; }
     void set_title_callback(TitleCallback cb) { m_title_cb = cb; }
     void set_viewport_size(int w, int h) { m_width = w; m_height = h; if (m_browser) m_browser->GetHost()->WasResized(); }
     void set_hidden(bool h) { m_hidden = h; }
     CefRefPtr<CefBrowser> browser() { return m_browser; }
+    // Browsers created asynchronously (pooled) may be navigated before
+    // OnAfterCreated; the latest url is loaded once the browser exists
+    void set_initial_url(const std::string& url) { m_initial_url = url; }
+    void set_pending_url(const std::string& url) { m_pending_url = url; }
+    const std::string& pending_url() const { return m_pending_url.empty() ? m_initial_url : m_pending_url; }
 
     // CefClient
     CefRefPtr<CefLifeSpanHandler> GetLifeSpanHandler() override { return this; }
@@ -56,6 +90,12 @@ public:
     void OnAfterCreated(CefRefPtr<CefBrowser> browser) override {
         m_browser = browser;
         std::cout << "[gdCEF] Browser created, ID: " << browser->GetIdentifier() << std::endl;
+        // Asynchronously created (pooled) browsers may have been hidden already
+        if (m_hidden) browser->GetHost()->WasHidden(true);
+        if (!m_pending_url.empty() && m_pending_url != m_initial_url) {
+            browser->GetMainFrame()->LoadURL(CefString(m_pending_url));
+        }
+        m_pending_url.clear();
     }
     bool DoClose(CefRefPtr<CefBrowser> browser) override { return false; }
     void OnBeforeClose(CefRefPtr<CefBrowser> browser) override {
@@ -69,8 +109,26 @@ public:
     void OnPaint(CefRefPtr<CefBrowser> browser, PaintElementType type,
                  const RectList& dirtyRects, const void* buffer,
                  int width, int height) override {
-        if (m_hidden || type != PET_VIEW) return;
-        if (m_paint_cb) m_paint_cb(buffer, width, height);
+        if (m_hidden || type != PET_VIEW || !m_paint_cb) return;
+        m_dirty.clear();
+        m_dirty.reserve(dirtyRects.size() * 4);
+        for (const CefRect& r : dirtyRects) {
+            m_dirty.push_back(r.x);
+            m_dirty.push_back(r.y);
+            m_dirty.push_back(r.width);
+            m_dirty.push_back(r.height);
+        }
+        m_paint_cb(buffer, width, height, m_dirty.data(), (int)dirtyRects.size());
+    }
+    void OnAcceleratedPaint(CefRefPtr<CefBrowser> browser, PaintElementType type,
+                            const RectList& dirtyRects, const CefAcceleratedPaintInfo& info) override {
+        if (m_hidden || type != PET_VIEW || !m_accelerated_paint_cb) return;
+#if defined(__APPLE__)
+        void* handle = info.shared_texture_io_surface;
+#else
+        void* handle = nullptr;  // DXGI / dmabuf import is not implemented
+#endif
+        if (handle) m_accelerated_paint_cb((uint64_t)(uintptr_t)handle);
     }
 
     // CefLoadHandler
@@ -101,7 +159,11 @@ private:
     CefRefPtr<CefBrowser> m_browser;
     int m_width = 800, m_height = 600;
     bool m_hidden = false;
+    std::string m_initial_url;
+    std::string m_pending_url;
     PaintCallback m_paint_cb;
+    AcceleratedPaintCallback m_accelerated_paint_cb;
+    std::vector<int> m_dirty;  // Reused between paints
     LoadCallback m_load_cb;
     TitleCallback m_title_cb;
     IMPLEMENT_REFCOUNTING(BrowserHandler);
@@ -115,6 +177,7 @@ public:
     CefRefPtr<BrowserHandler> handler;
     GDBrowserView* owner = nullptr;
     std::string cached_url;
+    CefRefPtr<CefRegistration> query_registration;  // Observer stays registered while held
 };
 
 //*****************************************************************************
@@ -139,20 +202,27 @@ void gdbrowser_impl_destroy(GDBrowserImpl* impl) {
 }
 
 // Forward declaration for callback - defined in gdbrowser.cpp
-void gdbrowser_owner_on_paint(GDBrowserView* owner, const void* buffer, int width, int height);
+void gdbrowser_owner_on_paint(GDBrowserView* owner, const void* buffer, int width, int height, const int* dirty_rects, int dirty_rect_count);
+void gdbrowser_owner_on_accelerated_paint(GDBrowserView* owner, uint64_t handle);
 void gdbrowser_owner_on_load(GDBrowserView* owner, bool success, const char* url);
+void gdbrowser_owner_on_query_result(GDBrowserView* owner, int query_id, bool success, const char* json, size_t size);
 void gdbrowser_owner_on_title(GDBrowserView* owner, const char* title);
 
 bool gdbrowser_impl_init(GDBrowserImpl* impl, GDCefImpl* cef_impl,
-                          const char* url, int width, int height, int frame_rate)
+                          const char* url, int width, int height, int frame_rate,
+                          bool async)
 {
     if (!impl || !cef_impl) return false;
     
     impl->handler->set_viewport_size(width, height);
+    impl->handler->set_initial_url(url);
     
     // Set callbacks that forward to GDBrowserView
-    impl->handler->set_paint_callback([impl](const void* buf, int w, int h) {
-        gdbrowser_owner_on_paint(impl->owner, buf, w, h);
+    impl->handler->set_paint_callback([impl](const void* buf, int w, int h, const int* rects, int rect_count) {
+        gdbrowser_owner_on_paint(impl->owner, buf, w, h, rects, rect_count);
+    });
+    impl->handler->set_accelerated_paint_callback([impl](uint64_t handle) {
+        gdbrowser_owner_on_accelerated_paint(impl->owner, handle);
     });
     impl->handler->set_load_callback([impl](bool success, const char* url) {
         gdbrowser_owner_on_load(impl->owner, success, url);
@@ -167,7 +237,11 @@ bool gdbrowser_impl_init(GDBrowserImpl* impl, GDCefImpl* cef_impl,
     
     settings->windowless_frame_rate = frame_rate;
 
-    std::cout << "[gdCEF] Creating browser: " << url << std::endl;
+    std::cout << "[gdCEF] Creating browser: " << url << (async ? " (async)" : "") << std::endl;
+    if (async) {
+        // Returns at once; the browser arrives in OnAfterCreated
+        return CefBrowserHost::CreateBrowser(*win_info, impl->handler, CefString(url), *settings, nullptr, nullptr);
+    }
     CefRefPtr<CefBrowser> browser = CefBrowserHost::CreateBrowserSync(
         *win_info, impl->handler, CefString(url), *settings, nullptr, nullptr);
     
@@ -175,6 +249,7 @@ bool gdbrowser_impl_init(GDBrowserImpl* impl, GDCefImpl* cef_impl,
 }
 
 void gdbrowser_impl_close(GDBrowserImpl* impl) {
+    if (impl) impl->query_registration = nullptr;
     if (impl && impl->handler && impl->handler->browser()) {
         impl->handler->browser()->GetHost()->CloseBrowser(true);
     }
@@ -191,8 +266,11 @@ bool gdbrowser_impl_is_valid(GDBrowserImpl* impl) {
 }
 
 void gdbrowser_impl_load_url(GDBrowserImpl* impl, const char* url) {
-    if (impl && impl->handler && impl->handler->browser()) {
+    if (!impl || !impl->handler) return;
+    if (impl->handler->browser()) {
         impl->handler->browser()->GetMainFrame()->LoadURL(CefString(url));
+    } else {
+        impl->handler->set_pending_url(url);
     }
 }
 
@@ -201,6 +279,11 @@ const char* gdbrowser_impl_get_url(GDBrowserImpl* impl) {
         impl->cached_url = impl->handler->browser()->GetMainFrame()->GetURL().ToString();
         return impl->cached_url.c_str();
     }
+    if (impl && impl->handler) {
+        // Not created yet: report where it is headed
+        impl->cached_url = impl->handler->pending_url();
+        return impl->cached_url.c_str();
+    }
     return "";
 }
 
@@ -287,6 +370,26 @@ void gdbrowser_impl_execute_javascript(GDBrowserImpl* impl, const char* js) {
     }
 }
 
+int gdbrowser_impl_evaluate_javascript(GDBrowserImpl* impl, const char* expression) {
+    if (!impl || !impl->handler || !impl->handler->browser()) return 0;
+    CefRefPtr<CefBrowserHost> host = impl->handler->browser()->GetHost();
+    
+    if (!impl->query_registration) {
+        CefRefPtr<QueryObserver> observer = new QueryObserver(
+            [impl](int id, bool success, const char* json, size_t size) {
+                gdbrowser_owner_on_query_result(impl->owner, id, success, json, size);
+            });
+        impl->query_registration = host->AddDevToolsMessageObserver(observer);
+    }
+    
+    CefRefPtr<CefDictionaryValue> params = CefDictionaryValue::Create();
+    params->SetString("expression", CefString(expression));
+    params->SetBool("awaitPromise", true);
+    params->SetBool("returnByValue", true);
+    // 0 lets CEF assign the id it returns (0 on failure)
+    return host->ExecuteDevToolsMethod(0, "Runtime.evaluate", params);
+}
+
 void gdbrowser_impl_set_muted(GDBrowserImpl* impl, bool muted) {
     if (impl && impl->handler && impl->handler->browser())
         impl->handler->browser()->GetHost()->SetAudioMuted(muted);
@@ -314,6 +417,8 @@ void gdbrowser_impl_set_frame_rate(GDBrowserImpl* impl, int fps) {
 // These need to be declared here so they link properly
 //*****************************************************************************
 // Note: These are defined in gdbrowser.cpp but need forward declaration
-extern "C" void gdbrowser_owner_on_paint(GDBrowserView* owner, const void* buffer, int width, int height);
+extern "C" void gdbrowser_owner_on_paint(GDBrowserView* owner, const void* buffer, int width, int height, const int* dirty_rects, int dirty_rect_count);
+extern "C" void gdbrowser_owner_on_accelerated_paint(GDBrowserView* owner, uint64_t handle);
 extern "C" void gdbrowser_owner_on_load(GDBrowserView* owner, bool success, const char* url);
 extern "C" void gdbrowser_owner_on_title(GDBrowserView* owner, const char* title);
+extern "C" void gdbrowser_owner_on_query_result(GDBrowserView* owner, int query_id, bool success, const char* json, size_t size);
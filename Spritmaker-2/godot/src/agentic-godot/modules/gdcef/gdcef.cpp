@@ -8,6 +8,7 @@
 
 #include "gdcef.h"
 #include "gdbrowser.h"
+#include "gdshared_texture.h"
 
 #include "core/os/os.h"
 #include "core/config/project_settings.h"
@@ -23,9 +24,11 @@ extern "C" {
     void gdcef_impl_destroy(GDCefImpl* impl);
     bool gdcef_impl_initialize(GDCefImpl* impl, const char* artifacts_path,
                                int remote_debugging_port, int frame_rate,
-                               bool enable_media_stream, const char* user_agent);
+                               bool enable_media_stream, const char* user_agent,
+                               bool accelerated_paint, bool external_message_pump,
+                               const char* cache_path);
     void gdcef_impl_shutdown(GDCefImpl* impl);
-    void gdcef_impl_do_message_loop_work(GDCefImpl* impl);
+    bool gdcef_impl_pump(GDCefImpl* impl, int min_interval_ms);
     const char* gdcef_impl_get_version(GDCefImpl* impl);
     const char* gdcef_impl_get_error(GDCefImpl* impl);
     bool gdcef_impl_is_initialized(GDCefImpl* impl);
@@ -39,7 +42,12 @@ void GDCef::_bind_methods() {
     ClassDB::bind_method(D_METHOD("is_alive"), &GDCef::is_alive);
     ClassDB::bind_method(D_METHOD("get_error"), &GDCef::get_error);
     ClassDB::bind_method(D_METHOD("version"), &GDCef::version);
+    ClassDB::bind_method(D_METHOD("is_accelerated_paint"), &GDCef::is_accelerated_paint);
     ClassDB::bind_method(D_METHOD("create_browser", "url", "texture_rect", "config"), &GDCef::create_browser);
+    ClassDB::bind_method(D_METHOD("warm_pool", "url", "count", "config"), &GDCef::warm_pool, DEFVAL(1), DEFVAL(Dictionary()));
+    ClassDB::bind_method(D_METHOD("acquire_browser", "url", "texture_rect", "config"), &GDCef::acquire_browser);
+    ClassDB::bind_method(D_METHOD("release_browser", "browser"), &GDCef::release_browser);
+    ClassDB::bind_method(D_METHOD("get_pool_size"), &GDCef::get_pool_size);
     ClassDB::bind_method(D_METHOD("shutdown"), &GDCef::shutdown);
 }
 
@@ -97,11 +105,31 @@ bool GDCef::initialize(Dictionary config) {
     int frame_rate = config.has("frame_rate") ? (int)config["frame_rate"] : 30;
     bool enable_media = config.has("enable_media_stream") ? (bool)config["enable_media_stream"] : false;
     String user_agent_str = config.has("user_agent") ? String(config["user_agent"]) : "";
+    bool accelerated = config.has("accelerated_paint") ? (bool)config["accelerated_paint"] : false;
+    bool external_pump = config.has("external_message_pump") ? (bool)config["external_message_pump"] : true;
+    
+    // Shared textures need a Vulkan RenderingDevice to import into
+    if (accelerated && !GDSharedTexture::is_supported()) {
+        print_line("[gdCEF] Accelerated paint not supported by this renderer, using software rendering");
+        accelerated = false;
+    }
+    
+    // Persistent cache in the user's cache dir: the artifacts folder sits in
+    // the (possibly read-only) editor bundle, and a working HTTP/code cache is
+    // what makes the second editor load fast
+    String cache_path = config.has("cache_path") ? String(config["cache_path"])
+                                                 : OS::get_singleton()->get_cache_path().path_join("gdcef");
+    if (DirAccess::make_dir_recursive_absolute(cache_path) != OK) {
+        print_line("[gdCEF] WARNING: Could not create cache dir " + cache_path + ", falling back to the artifacts folder");
+        cache_path = m_artifacts_path.path_join("cache");
+    }
     
     m_default_frame_rate = frame_rate;
+    m_accelerated_paint = accelerated;
     
     if (!gdcef_impl_initialize(m_impl, m_artifacts_path.utf8().get_data(), remote_port, frame_rate,
-                               enable_media, user_agent_str.utf8().get_data())) {
+                               enable_media, user_agent_str.utf8().get_data(), accelerated,
+                               external_pump, cache_path.utf8().get_data())) {
         m_error = String(gdcef_impl_get_error(m_impl));
         gdcef_impl_destroy(m_impl);
         m_impl = nullptr;
@@ -109,7 +137,7 @@ bool GDCef::initialize(Dictionary config) {
     }
     
     m_initialized = true;
-    set_process(true);  // Enable _process() to call CefDoMessageLoopWork()
+    set_process(true);  // Enable _process() to pump the CEF message loop
     print_line("[gdCEF] CEF initialized successfully!");
     return true;
 }
@@ -119,6 +147,11 @@ bool GDCef::is_alive() {
     return m_initialized;
 }
 
+//------------------------------------------------------------------------------
+bool GDCef::is_accelerated_paint() {
+    return m_accelerated_paint;
+}
+
 //------------------------------------------------------------------------------
 String GDCef::get_error() {
     return m_error;
@@ -146,11 +179,17 @@ GDBrowserView* GDCef::create_browser(const String &url, TextureRect *texture_rec
         return nullptr;
     }
     
-    print_line("[gdCEF] Creating browser for: " + url);
+    return _create_browser_view(url, texture_rect, config, false);
+}
+
+//------------------------------------------------------------------------------
+GDBrowserView* GDCef::_create_browser_view(const String &url, TextureRect *texture_rect, Dictionary config, bool pooled) {
+    print_line("[gdCEF] Creating " + String(pooled ? "pooled " : "") + "browser for: " + url);
     
     GDBrowserView *browser = memnew(GDBrowserView);
     
-    if (!browser->init(url, texture_rect, m_impl, config)) {
+    // Pooled browsers are created asynchronously and start hidden
+    if (!browser->init(url, texture_rect, m_impl, config, pooled)) {
         memdelete(browser);
         m_error = "Failed to initialize browser";
         print_line("[gdCEF] ERROR: " + m_error);
@@ -162,6 +201,108 @@ GDBrowserView* GDCef::create_browser(const String &url, TextureRect *texture_rec
     return browser;
 }
 
+//------------------------------------------------------------------------------
+void GDCef::warm_pool(const String &url, int count, Dictionary config) {
+    if (!m_initialized || !m_impl) {
+        m_error = "CEF not initialized";
+        return;
+    }
+    m_pool_url = url;
+    m_pool_config = config;
+    m_pool_target = CLAMP(count, 0, 4);
+    _refill_pool();
+}
+
+//------------------------------------------------------------------------------
+GDBrowserView* GDCef::_take_pooled(const String &url) {
+    // Prefer a browser already showing this url, then any live one
+    int best = -1;
+    for (int i = m_pool.size() - 1; i >= 0; i--) {
+        GDBrowserView *browser = Object::cast_to<GDBrowserView>(ObjectDB::get_instance(m_pool[i]));
+        if (!browser) {
+            m_pool.remove_at(i);
+            if (best > i) best--;
+            continue;
+        }
+        if (best < 0 || browser->get_url() == url) {
+            best = i;
+        }
+    }
+    if (best < 0) return nullptr;
+    GDBrowserView *browser = Object::cast_to<GDBrowserView>(ObjectDB::get_instance(m_pool[best]));
+    m_pool.remove_at(best);
+    return browser;
+}
+
+//------------------------------------------------------------------------------
+GDBrowserView* GDCef::acquire_browser(const String &url, TextureRect *texture_rect, Dictionary config) {
+    if (!m_initialized || !m_impl) {
+        m_error = "CEF not initialized";
+        print_line("[gdCEF] ERROR: " + m_error);
+        return nullptr;
+    }
+    if (texture_rect == nullptr) {
+        m_error = "texture_rect cannot be null";
+        print_line("[gdCEF] ERROR: " + m_error);
+        return nullptr;
+    }
+    
+    GDBrowserView *browser = _take_pooled(url);
+    if (!browser) {
+        return _create_browser_view(url, texture_rect, config, false);
+    }
+    
+    print_line("[gdCEF] Reusing pooled browser for: " + url);
+    if (config.has("frame_rate")) {
+        browser->set_frame_rate(config["frame_rate"]);
+    }
+    browser->attach(texture_rect);
+    if (browser->get_url() != url) {
+        // The renderer and the HTTP cache are warm, so this is a fast load
+        browser->load_url(url);
+    }
+    browser->set_hidden(false);
+    
+    // warm_pool() counts browsers to have ready for upcoming acquires, not
+    // idle spares to keep: a consumer that holds on to its browser must not
+    // leave a second renderer running. Refill only if more were asked for.
+    if (m_pool_target > 0) m_pool_target--;
+    if (m_pool.size() < m_pool_target && !m_refill_queued) {
+        m_refill_queued = true;
+        callable_mp(this, &GDCef::_refill_pool).call_deferred();
+    }
+    return browser;
+}
+
+//------------------------------------------------------------------------------
+void GDCef::release_browser(GDBrowserView *browser) {
+    if (!browser) return;
+    if (!m_initialized || m_pool.size() >= MAX(m_pool_target, 1)) {
+        browser->close();
+        browser->queue_free();
+        return;
+    }
+    browser->set_hidden(true);
+    browser->detach();
+    m_pool.push_back(browser->get_instance_id());
+}
+
+//------------------------------------------------------------------------------
+int GDCef::get_pool_size() const {
+    return m_pool.size();
+}
+
+//------------------------------------------------------------------------------
+void GDCef::_refill_pool() {
+    m_refill_queued = false;
+    if (!m_initialized || !m_impl || m_pool_url.is_empty()) return;
+    while (m_pool.size() < m_pool_target) {
+        GDBrowserView *browser = _create_browser_view(m_pool_url, nullptr, m_pool_config, true);
+        if (!browser) break;
+        m_pool.push_back(browser->get_instance_id());
+    }
+}
+
 //------------------------------------------------------------------------------
 void GDCef::shutdown() {
     if (!m_initialized) {
@@ -174,6 +315,9 @@ void GDCef::shutdown() {
     m_initialized = false;
     set_process(false);  // Stop _process() from calling CefDoMessageLoopWork
     
+    m_pool.clear();
+    m_pool_target = 0;
+    
     // Close all browser children (don't remove/free - parent will handle that)
     int64_t count = get_child_count();
     for (int64_t i = count - 1; i >= 0; i--) {
@@ -195,9 +339,16 @@ void GDCef::shutdown() {
 
 //------------------------------------------------------------------------------
 void GDCef::_process(double delta) {
-    if (m_impl) {
-        gdcef_impl_do_message_loop_work(m_impl);
+    if (!m_impl) return;
+    
+    // Nobody sees the pages while every view is hidden: pump just often
+    // enough to keep IPC and page timers alive
+    bool any_visible = false;
+    for (int i = 0; i < get_child_count() && !any_visible; i++) {
+        GDBrowserView *browser = Object::cast_to<GDBrowserView>(get_child(i));
+        any_visible = browser && !browser->is_hidden();
     }
+    gdcef_impl_pump(m_impl, any_visible ? 0 : HIDDEN_PUMP_INTERVAL_MS);
 }
 
 //------------------------------------------------------------------------------
@@ -43,6 +43,10 @@ public:
     // Check if CEF is running
     bool is_alive();
     
+    // Whether browsers render on the GPU into shared textures. Requested with
+    // config "accelerated_paint"; false when the renderer can't import them
+    bool is_accelerated_paint();
+    
     // Get last error message
     String get_error();
     
@@ -52,6 +56,22 @@ public:
     // Create a new browser view
     GDBrowserView* create_browser(const String &url, TextureRect *texture_rect, Dictionary config);
     
+    // -------------------------------------------------------------------------
+    // Browser pool
+    // Hidden browsers created in the background and loaded with url, so that
+    // acquire_browser() hands out a running renderer with the page shell
+    // already loaded instead of paying creation and page load on demand.
+    // count is how many upcoming acquire_browser() calls to prepare for; each
+    // pooled browser handed out lowers it, so nothing is created behind it.
+    // -------------------------------------------------------------------------
+    void warm_pool(const String &url, int count, Dictionary config);
+    // A pooled browser attached to texture_rect (navigated to url if it is
+    // elsewhere), or a newly created one when the pool is empty
+    GDBrowserView* acquire_browser(const String &url, TextureRect *texture_rect, Dictionary config);
+    // Detach and hide a browser and keep it for the next acquire_browser()
+    void release_browser(GDBrowserView *browser);
+    int get_pool_size() const;
+    
     // Shutdown CEF (call before exit)
     void shutdown();
 
@@ -68,13 +88,27 @@ public:
     GDCefImpl* get_impl() { return m_impl; }
 
 private:
+    // Minimum time between message loop pumps while no browser is visible
+    static const int HIDDEN_PUMP_INTERVAL_MS = 100;
+    
     GDCefImpl* m_impl = nullptr;
     bool m_initialized = false;
     String m_error;
     String m_artifacts_path;
     int m_default_frame_rate = 30;
+    bool m_accelerated_paint = false;
+    
+    // Browser pool
+    Vector<ObjectID> m_pool;
+    String m_pool_url;
+    Dictionary m_pool_config;
+    int m_pool_target = 0;
+    bool m_refill_queued = false;
     
     bool verify_artifacts();
+    GDBrowserView* _create_browser_view(const String &url, TextureRect *texture_rect, Dictionary config, bool pooled);
+    GDBrowserView* _take_pooled(const String &url);
+    void _refill_pool();
 };
 
 #endif // GDCEF_H
@@ -15,6 +15,17 @@
 
 #include <string>
 #include <iostream>
+#include <atomic>
+#include <chrono>
+
+// Longest wait between pumps with the external pump. CEF does not schedule
+// everything it needs (cefclient uses the same fallback).
+static const int64_t MAX_PUMP_DELAY_MS = 1000 / 30;
+
+static int64_t pump_clock_ms() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
 
 //*****************************************************************************
 // CEF Framework Loading for macOS
@@ -55,13 +66,16 @@ public:
         CefRefPtr<CefCommandLine> command_line) override
     {
         if (!command_line) return;
-        command_line->AppendSwitchWithValue("use-angle", "swiftshader");
+        if (!m_accelerated_paint) {
+            // Software mode: rasterize on the CPU, frames arrive through OnPaint
+            command_line->AppendSwitchWithValue("use-angle", "swiftshader");
+            command_line->AppendSwitch("disable-gpu");
+            command_line->AppendSwitch("disable-gpu-compositing");
+        }
         command_line->AppendSwitchWithValue("use-gl", "angle");
         if (m_enable_media_stream) command_line->AppendSwitch("enable-media-stream");
         if (!m_user_agent.empty()) command_line->AppendSwitchWithValue("user-agent", m_user_agent);
         command_line->AppendSwitchWithValue("autoplay-policy", "user-gesture-required");
-        command_line->AppendSwitch("disable-gpu");
-        command_line->AppendSwitch("disable-gpu-compositing");
         
         // macOS-specific: Prevent keychain access prompts by using a mock keychain
         command_line->AppendSwitch("use-mock-keychain");
@@ -69,11 +83,23 @@ public:
 
     virtual void OnContextInitialized() override {}
 
+    // Called on any thread when external_message_pump is enabled; the next
+    // GDCef::_process at or after that time pumps
+    virtual void OnScheduleMessagePumpWork(int64_t delay_ms) override {
+        m_next_pump_ms.store(pump_clock_ms() + (delay_ms > 0 ? delay_ms : 0));
+    }
+
+    int64_t next_pump_ms() const { return m_next_pump_ms.load(); }
+    void set_next_pump_ms(int64_t ms) { m_next_pump_ms.store(ms); }
+
     void set_enable_media_stream(bool v) { m_enable_media_stream = v; }
     void set_user_agent(const std::string& ua) { m_user_agent = ua; }
+    void set_accelerated_paint(bool v) { m_accelerated_paint = v; }
 
 private:
     bool m_enable_media_stream = false;
+    bool m_accelerated_paint = false;
+    std::atomic<int64_t> m_next_pump_ms{0};
     std::string m_user_agent;
     IMPLEMENT_REFCOUNTING(CefAppHandler);
 };
@@ -88,6 +114,7 @@ public:
     CefWindowInfo window_info;
     CefBrowserSettings browser_settings;
     bool initialized = false;
+    int64_t last_pump_ms = 0;
     std::string error;
 };
 
@@ -106,7 +133,9 @@ void gdcef_impl_destroy(GDCefImpl* impl) {
 
 bool gdcef_impl_initialize(GDCefImpl* impl, const char* artifacts_path,
                             int remote_debugging_port, int frame_rate,
-                            bool enable_media_stream, const char* user_agent)
+                            bool enable_media_stream, const char* user_agent,
+                            bool accelerated_paint, bool external_message_pump,
+                            const char* cache_dir)
 {
     if (!impl || impl->initialized) {
         if (impl) impl->error = "Already initialized";
@@ -128,10 +157,12 @@ bool gdcef_impl_initialize(GDCefImpl* impl, const char* artifacts_path,
     CefString(&impl->settings.main_bundle_path).FromString(main_bundle);
     CefString(&impl->settings.browser_subprocess_path).FromString(subprocess);
     
-    // Cache path
-    std::string cache_path = path + "/cache";
+    // Cache path. cache_path is a profile below root_cache_path so the disk
+    // cache, code cache and storage persist between editor sessions
+    std::string root_cache = (cache_dir && cache_dir[0]) ? std::string(cache_dir) : path + "/cache";
+    std::string cache_path = root_cache + "/default";
     std::cout << "[gdCEF] Cache path: " << cache_path << std::endl;
-    CefString(&impl->settings.root_cache_path).FromString(cache_path);
+    CefString(&impl->settings.root_cache_path).FromString(root_cache);
     CefString(&impl->settings.cache_path).FromString(cache_path);
     
     // Log file
@@ -142,16 +173,21 @@ bool gdcef_impl_initialize(GDCefImpl* impl, const char* artifacts_path,
     impl->settings.remote_debugging_port = remote_debugging_port;
     impl->settings.windowless_rendering_enabled = true;
     impl->settings.no_sandbox = true;
+    // multi_threaded_message_loop is not supported on macOS; the external
+    // pump lets CEF say when it needs work instead of pumping every frame
     impl->settings.multi_threaded_message_loop = false;
-    impl->settings.external_message_pump = false;
+    impl->settings.external_message_pump = external_message_pump;
     
     impl->window_info.SetAsWindowless(0);
-    impl->window_info.shared_texture_enabled = false;
+    // Accelerated: GPU raster, frames arrive as shared textures through OnAcceleratedPaint
+    impl->window_info.shared_texture_enabled = accelerated_paint;
     impl->browser_settings.windowless_frame_rate = frame_rate;
 
     impl->app = new CefAppHandler();
     impl->app->set_enable_media_stream(enable_media_stream);
     if (user_agent && user_agent[0]) impl->app->set_user_agent(user_agent);
+    impl->app->set_accelerated_paint(accelerated_paint);
+    std::cout << "[gdCEF] Paint mode: " << (accelerated_paint ? "accelerated (shared textures)" : "software") << std::endl;
 
     std::cout << "[gdCEF] Calling CefInitialize..." << std::endl;
 
@@ -186,10 +222,21 @@ void gdcef_impl_shutdown(GDCefImpl* impl) {
     std::cout << "[gdCEF] CEF shutdown complete" << std::endl;
 }
 
-void gdcef_impl_do_message_loop_work(GDCefImpl* impl) {
-    if (impl && impl->initialized) {
-        CefDoMessageLoopWork();
+bool gdcef_impl_pump(GDCefImpl* impl, int min_interval_ms) {
+    if (!impl || !impl->initialized) return false;
+    
+    int64_t now = pump_clock_ms();
+    bool external = impl->settings.external_message_pump;
+    if (external && now < impl->app->next_pump_ms()) return false;
+    if (min_interval_ms > 0 && now - impl->last_pump_ms < min_interval_ms) return false;
+    
+    impl->last_pump_ms = now;
+    if (external) {
+        // Set before the work so schedules made during it take precedence
+        impl->app->set_next_pump_ms(now + MAX_PUMP_DELAY_MS);
     }
+    CefDoMessageLoopWork();
+    return true;
 }
 
 const char* gdcef_impl_get_version(GDCefImpl* impl) {
@@ -0,0 +1,310 @@
+//*****************************************************************************
+// GDSharedTexture - Godot/Vulkan side of CEF accelerated painting
+//
+// macOS: CEF paints into IOSurfaces. Godot renders through MoltenVK there,
+// which can bind an IOSurface as a VkImage (VK_EXT_metal_objects); that image
+// is wrapped with RenderingDevice::texture_create_from_extension and copied
+// into a texture Godot owns. Other platforms are not wired up yet and report
+// unsupported, so GDCef keeps software rendering.
+//*****************************************************************************
+
+#include "gdshared_texture.h"
+
+#include "core/config/engine.h"
+#include "core/string/print_string.h"
+#include "servers/rendering/rendering_device.h"
+#include "servers/rendering_server.h"
+
+#if defined(__APPLE__) && defined(VULKAN_ENABLED)
+#define GDSHARED_TEXTURE_IOSURFACE
+#ifndef VK_USE_PLATFORM_METAL_EXT
+#define VK_USE_PLATFORM_METAL_EXT
+#endif
+#include "drivers/vulkan/godot_vulkan.h"
+#include <CoreFoundation/CoreFoundation.h>
+#include <IOSurface/IOSurfaceRef.h>
+#endif
+
+//------------------------------------------------------------------------------
+GDSharedTexture::GDSharedTexture() {
+    m_texture.instantiate();
+}
+
+//------------------------------------------------------------------------------
+GDSharedTexture::~GDSharedTexture() {
+    clear();
+    // Browsers close at shutdown or with their view; no more frames will read these
+    _collect_retired(true);
+}
+
+//------------------------------------------------------------------------------
+bool GDSharedTexture::is_supported() {
+#ifdef GDSHARED_TEXTURE_IOSURFACE
+    RenderingDevice *rd = RenderingServer::get_singleton() ? RenderingServer::get_singleton()->get_rendering_device() : nullptr;
+    // Compatibility renderer has no RenderingDevice; Metal has its own import path
+    if (!rd || rd->get_device_api_name() != "Vulkan") return false;
+    VkDevice device = (VkDevice)rd->get_driver_resource(RenderingDevice::DRIVER_RESOURCE_LOGICAL_DEVICE, RID(), 0);
+    if (device == VK_NULL_HANDLE) return false;
+    // IOSurface import needs VK_EXT_metal_objects enabled on Godot's device, not
+    // just offered by MoltenVK; its commands only resolve when it is enabled
+    return vkGetDeviceProcAddr(device, "vkExportMetalObjectsEXT") != nullptr;
+#else
+    return false;
+#endif
+}
+
+//------------------------------------------------------------------------------
+bool GDSharedTexture::update(uint64_t handle) {
+#ifdef GDSHARED_TEXTURE_IOSURFACE
+    RenderingDevice *rd = RenderingServer::get_singleton()->get_rendering_device();
+    IOSurfaceRef surface = reinterpret_cast<IOSurfaceRef>(handle);
+    if (!rd || !surface) return false;
+    _collect_retired(false);
+
+    int width = (int)IOSurfaceGetWidth(surface);
+    int height = (int)IOSurfaceGetHeight(surface);
+    if (width <= 0 || height <= 0) return false;
+
+    if (width != m_width || height != m_height || !m_target.is_valid()) {
+        clear();
+        RD::TextureFormat format;
+        format.format = RD::DATA_FORMAT_B8G8R8A8_UNORM;
+        format.width = width;
+        format.height = height;
+        format.usage_bits = RD::TEXTURE_USAGE_SAMPLING_BIT | RD::TEXTURE_USAGE_CAN_COPY_TO_BIT;
+        m_target = rd->texture_create(format, RD::TextureView());
+        if (!m_target.is_valid()) return false;
+        m_width = width;
+        m_height = height;
+        m_texture->set_texture_rd_rid(m_target);
+    }
+
+    Imported *imported = m_imported.getptr(handle);
+    if (!imported) {
+        if (m_imported.size() >= MAX_IMPORTED) {
+            _release_imports();
+        }
+        Imported entry;
+        if (!_import(handle, width, height, entry)) return false;
+        m_imported.insert(handle, entry);
+        imported = m_imported.getptr(handle);
+    }
+
+    return rd->texture_copy(imported->rid, m_target, Vector3(), Vector3(),
+                            Vector3(width, height, 1), 0, 0, 0, 0) == OK;
+#else
+    return false;
+#endif
+}
+
+//------------------------------------------------------------------------------
+void GDSharedTexture::clear() {
+    _release_imports();
+    if (m_target.is_valid()) {
+        // Drop the Texture2DRD's reference before freeing the RID under it
+        m_texture->set_texture_rd_rid(RID());
+        RenderingServer::get_singleton()->get_rendering_device()->free(m_target);
+        m_target = RID();
+    }
+    m_width = 0;
+    m_height = 0;
+}
+
+//------------------------------------------------------------------------------
+bool GDSharedTexture::_import(uint64_t handle, int width, int height, Imported &r_imported) {
+#ifdef GDSHARED_TEXTURE_IOSURFACE
+    RenderingDevice *rd = RenderingServer::get_singleton()->get_rendering_device();
+    VkDevice device = (VkDevice)rd->get_driver_resource(RenderingDevice::DRIVER_RESOURCE_LOGICAL_DEVICE, RID(), 0);
+    VkPhysicalDevice physical_device = (VkPhysicalDevice)rd->get_driver_resource(RenderingDevice::DRIVER_RESOURCE_PHYSICAL_DEVICE, RID(), 0);
+    IOSurfaceRef surface = reinterpret_cast<IOSurfaceRef>(handle);
+
+    VkImportMetalIOSurfaceInfoEXT import_info = {};
+    import_info.sType = VK_STRUCTURE_TYPE_IMPORT_METAL_IO_SURFACE_INFO_EXT;
+    import_info.ioSurface = surface;
+
+    VkImageCreateInfo image_info = {};
+    image_info.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+    image_info.pNext = &import_info;
+    image_info.imageType = VK_IMAGE_TYPE_2D;
+    image_info.format = VK_FORMAT_B8G8R8A8_UNORM;
+    image_info.extent = { (uint32_t)width, (uint32_t)height, 1 };
+    image_info.mipLevels = 1;
+    image_info.arrayLayers = 1;
+    image_info.samples = VK_SAMPLE_COUNT_1_BIT;
+    image_info.tiling = VK_IMAGE_TILING_OPTIMAL;
+    image_info.usage = VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+    image_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    image_info.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+    VkImage image = VK_NULL_HANDLE;
+    if (vkCreateImage(device, &image_info, nullptr, &image) != VK_SUCCESS) {
+        print_line("[gdCEF] ERROR: Could not import IOSurface as VkImage");
+        return false;
+    }
+
+    // MoltenVK backs the image with the IOSurface itself; the allocation only
+    // satisfies Vulkan's bind rules
+    VkMemoryRequirements requirements;
+    vkGetImageMemoryRequirements(device, image, &requirements);
+    VkPhysicalDeviceMemoryProperties properties;
+    vkGetPhysicalDeviceMemoryProperties(physical_device, &properties);
+    uint32_t memory_type = UINT32_MAX;
+    for (uint32_t i = 0; i < properties.memoryTypeCount; i++) {
+        if ((requirements.memoryTypeBits & (1u << i)) &&
+            (properties.memoryTypes[i].propertyFlags & VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT)) {
+            memory_type = i;
+            break;
+        }
+    }
+
+    VkDeviceMemory memory = VK_NULL_HANDLE;
+    VkMemoryAllocateInfo alloc_info = {};
+    alloc_info.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    alloc_info.allocationSize = requirements.size;
+    alloc_info.memoryTypeIndex = memory_type;
+    if (memory_type == UINT32_MAX ||
+        vkAllocateMemory(device, &alloc_info, nullptr, &memory) != VK_SUCCESS ||
+        vkBindImageMemory(device, image, memory, 0) != VK_SUCCESS) {
+        if (memory != VK_NULL_HANDLE) vkFreeMemory(device, memory, nullptr);
+        vkDestroyImage(device, image, nullptr);
+        print_line("[gdCEF] ERROR: Could not bind memory for shared texture");
+        return false;
+    }
+
+    if (!_transition(image)) {
+        vkFreeMemory(device, memory, nullptr);
+        vkDestroyImage(device, image, nullptr);
+        print_line("[gdCEF] ERROR: Could not transition shared texture layout");
+        return false;
+    }
+
+    RID rid = rd->texture_create_from_extension(RD::TEXTURE_TYPE_2D, RD::DATA_FORMAT_B8G8R8A8_UNORM,
+                                                RD::TEXTURE_SAMPLES_1,
+                                                RD::TEXTURE_USAGE_SAMPLING_BIT | RD::TEXTURE_USAGE_CAN_COPY_FROM_BIT,
+                                                (uint64_t)image, width, height, 1, 1);
+    if (!rid.is_valid()) {
+        vkFreeMemory(device, memory, nullptr);
+        vkDestroyImage(device, image, nullptr);
+        return false;
+    }
+
+    CFRetain(surface);  // Keeps the surface alive for as long as it is imported
+    r_imported.rid = rid;
+    r_imported.image = (uint64_t)image;
+    r_imported.memory = (uint64_t)memory;
+    return true;
+#else
+    return false;
+#endif
+}
+
+//------------------------------------------------------------------------------
+bool GDSharedTexture::_transition(uint64_t image) {
+#ifdef GDSHARED_TEXTURE_IOSURFACE
+    // A new image starts out UNDEFINED, where reads (texture_copy) see garbage
+    // and the surface's frame may be discarded. Move it to GENERAL once, on
+    // Godot's queue, before RenderingDevice records anything against it.
+    RenderingDevice *rd = RenderingServer::get_singleton()->get_rendering_device();
+    VkDevice device = (VkDevice)rd->get_driver_resource(RenderingDevice::DRIVER_RESOURCE_LOGICAL_DEVICE, RID(), 0);
+    VkQueue queue = (VkQueue)rd->get_driver_resource(RenderingDevice::DRIVER_RESOURCE_COMMAND_QUEUE, RID(), 0);
+    uint32_t queue_family = (uint32_t)rd->get_driver_resource(RenderingDevice::DRIVER_RESOURCE_QUEUE_FAMILY, RID(), 0);
+    if (device == VK_NULL_HANDLE || queue == VK_NULL_HANDLE) return false;
+
+    VkCommandPoolCreateInfo pool_info = {};
+    pool_info.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+    pool_info.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+    pool_info.queueFamilyIndex = queue_family;
+    VkCommandPool pool = VK_NULL_HANDLE;
+    if (vkCreateCommandPool(device, &pool_info, nullptr, &pool) != VK_SUCCESS) return false;
+
+    VkCommandBufferAllocateInfo alloc_info = {};
+    alloc_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+    alloc_info.commandPool = pool;
+    alloc_info.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    alloc_info.commandBufferCount = 1;
+    VkCommandBuffer cmd = VK_NULL_HANDLE;
+    VkFence fence = VK_NULL_HANDLE;
+    VkFenceCreateInfo fence_info = {};
+    fence_info.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+    bool ok = vkAllocateCommandBuffers(device, &alloc_info, &cmd) == VK_SUCCESS &&
+              vkCreateFence(device, &fence_info, nullptr, &fence) == VK_SUCCESS;
+
+    if (ok) {
+        VkCommandBufferBeginInfo begin_info = {};
+        begin_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        begin_info.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+        vkBeginCommandBuffer(cmd, &begin_info);
+
+        VkImageMemoryBarrier barrier = {};
+        barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        barrier.srcAccessMask = 0;
+        barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_SHADER_READ_BIT;
+        barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        barrier.newLayout = VK_IMAGE_LAYOUT_GENERAL;
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.image = (VkImage)image;
+        barrier.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 };
+        vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                             0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+        VkSubmitInfo submit_info = {};
+        submit_info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        submit_info.commandBufferCount = 1;
+        submit_info.pCommandBuffers = &cmd;
+        // Imports happen once per surface in CEF's small pool, so waiting here is cheap
+        ok = vkEndCommandBuffer(cmd) == VK_SUCCESS &&
+             vkQueueSubmit(queue, 1, &submit_info, fence) == VK_SUCCESS &&
+             vkWaitForFences(device, 1, &fence, VK_TRUE, UINT64_MAX) == VK_SUCCESS;
+    }
+
+    if (fence != VK_NULL_HANDLE) vkDestroyFence(device, fence, nullptr);
+    vkDestroyCommandPool(device, pool, nullptr);  // Frees the command buffer too
+    return ok;
+#else
+    return false;
+#endif
+}
+
+//------------------------------------------------------------------------------
+void GDSharedTexture::_destroy(const Retired &retired) {
+#ifdef GDSHARED_TEXTURE_IOSURFACE
+    RenderingDevice *rd = RenderingServer::get_singleton()->get_rendering_device();
+    VkDevice device = (VkDevice)rd->get_driver_resource(RenderingDevice::DRIVER_RESOURCE_LOGICAL_DEVICE, RID(), 0);
+    // RD only wraps external images; destroying them is up to us
+    vkDestroyImage(device, (VkImage)retired.imported.image, nullptr);
+    vkFreeMemory(device, (VkDeviceMemory)retired.imported.memory, nullptr);
+    CFRelease(reinterpret_cast<IOSurfaceRef>(retired.handle));
+#endif
+}
+
+//------------------------------------------------------------------------------
+void GDSharedTexture::_release_imports() {
+    if (m_imported.is_empty()) return;
+    RenderingDevice *rd = RenderingServer::get_singleton()->get_rendering_device();
+    uint64_t frame = Engine::get_singleton()->get_frames_drawn();
+    for (KeyValue<uint64_t, Imported> &kv : m_imported) {
+        rd->free(kv.value.rid);  // RD defers this until its frames are done
+        Retired retired;
+        retired.handle = kv.key;
+        retired.imported = kv.value;
+        retired.frame = frame;
+        m_retired.push_back(retired);
+    }
+    m_imported.clear();
+}
+
+//------------------------------------------------------------------------------
+void GDSharedTexture::_collect_retired(bool force) {
+    if (m_retired.is_empty()) return;
+    uint64_t now = Engine::get_singleton()->get_frames_drawn();
+    uint64_t delay = RenderingServer::get_singleton()->get_rendering_device()->get_frame_delay() + 1;
+    for (uint32_t i = 0; i < m_retired.size();) {
+        if (force || now - m_retired[i].frame > delay) {
+            _destroy(m_retired[i]);
+            m_retired.remove_at_unordered(i);
+        } else {
+            i++;
+        }
+    }
+}
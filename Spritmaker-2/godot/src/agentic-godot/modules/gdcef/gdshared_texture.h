@@ -0,0 +1,75 @@
+//*****************************************************************************
+// GDSharedTexture - GPU texture sharing for accelerated off-screen rendering
+// Imports the shared texture handed out by CefRenderHandler::OnAcceleratedPaint
+// into a RenderingDevice texture, so frames never go through the CPU
+//
+// Godot side only - the handle arrives as an opaque integer
+//*****************************************************************************
+
+#ifndef GDSHARED_TEXTURE_H
+#define GDSHARED_TEXTURE_H
+
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/rid.h"
+#include "scene/resources/texture_rd.h"
+
+//*****************************************************************************
+// GDSharedTexture - One per GDBrowserView in accelerated mode
+// CEF cycles through a few shared surfaces; each is imported once and copied
+// on the GPU into a persistent texture, because a surface is only guaranteed
+// to hold the frame during the paint callback.
+//*****************************************************************************
+class GDSharedTexture {
+public:
+    GDSharedTexture();
+    ~GDSharedTexture();
+
+    // Whether the running renderer and platform can import CEF's shared
+    // textures (Vulkan with VK_EXT_metal_objects enabled on the device).
+    // GDCef falls back to software rendering when this is false.
+    static bool is_supported();
+
+    // Copies the frame in the shared handle (IOSurfaceRef on macOS) into
+    // the persistent texture. Returns false if the import failed.
+    bool update(uint64_t handle);
+
+    Ref<Texture2DRD> get_texture() const { return m_texture; }
+    int get_width() const { return m_width; }
+    int get_height() const { return m_height; }
+
+    void clear();
+
+private:
+    struct Imported {
+        RID rid;
+        uint64_t image = 0;   // VkImage
+        uint64_t memory = 0;  // VkDeviceMemory
+    };
+
+    // CEF's surface pool is small; anything beyond this means the pool was
+    // recreated (e.g. resize) and the old imports are stale
+    static const int MAX_IMPORTED = 4;
+
+    // Released imports wait here until the GPU is done with them
+    struct Retired {
+        uint64_t handle = 0;
+        Imported imported;
+        uint64_t frame = 0;
+    };
+
+    HashMap<uint64_t, Imported> m_imported;
+    LocalVector<Retired> m_retired;
+    RID m_target;
+    Ref<Texture2DRD> m_texture;
+    int m_width = 0;
+    int m_height = 0;
+
+    bool _import(uint64_t handle, int width, int height, Imported &r_imported);
+    bool _transition(uint64_t image);
+    void _destroy(const Retired &retired);
+    void _release_imports();
+    void _collect_retired(bool force);
+};
+
+#endif // GDSHARED_TEXTURE_H
@@ -1,4 +1,5 @@
 #include "ai_panel.h"
+#include "bridge_line_diff.h"
 #include "scene/gui/separator.h"
 #include "scene/gui/label.h"
 #include "scene/gui/texture_rect.h"
@@ -326,7 +327,9 @@ void AIPanel::_scroll_to_bottom() {
 	// If user scrolled up, don't force them back down
 }
 
-void AIPanel::_add_message_bubble(const String &p_sender, const String &p_message, bool p_is_user) {
+PanelContainer *AIPanel::_create_message_bubble(const Dictionary &p_entry) {
+	bool is_user = p_entry.get("is_user", false);
+
 	// Cascade-style: minimal chrome, just content with subtle separation
 	PanelContainer *bubble = memnew(PanelContainer);
 	bubble->set_h_size_flags(SIZE_EXPAND_FILL);
@@ -335,7 +338,7 @@ void AIPanel::_add_message_bubble(const String &p_sender, const String &p_messag
 	style.instantiate();
 	style->set_corner_radius_all(0); // No rounding — flat Cascade style
 
-	if (p_is_user) {
+	if (is_user) {
 		// User: very subtle bg bump, no border
 		style->set_bg_color(Color(0.14, 0.14, 0.16, 0.6));
 		style->set_border_width_all(0);
@@ -368,32 +371,226 @@ void AIPanel::_add_message_bubble(const String &p_sender, const String &p_messag
 	msg->add_theme_font_size_override("normal_font_size", chat_font_size);
 	msg->add_theme_constant_override("line_separation", _scaled_ui_size(3));
 
-	if (p_is_user) {
+	if (is_user) {
 		msg->add_theme_color_override("default_color", Color(0.85, 0.85, 0.90));
 	} else {
 		msg->add_theme_color_override("default_color", Color(0.78, 0.78, 0.82));
 	}
-	msg->add_text(p_message);
+	msg->add_text(p_entry.get("text", ""));
 	content->add_child(msg);
 
-	messages_container->add_child(bubble);
+	return bubble;
+}
 
+void AIPanel::_add_message_bubble(const String &p_sender, const String &p_message, bool p_is_user) {
 	// Track message for session persistence
 	Dictionary msg_entry;
 	msg_entry["sender"] = p_sender;
 	msg_entry["text"] = p_message;
 	msg_entry["is_user"] = p_is_user;
 	current_messages.push_back(msg_entry);
+	_append_to_journal(msg_entry);
+
+	PanelContainer *bubble = _create_message_bubble(msg_entry);
+	bubble->set_meta("chat_order", 2 * (current_messages.size() - 1) + 1);
+	messages_container->add_child(bubble);
 
 	// Move thinking indicator to end
 	if (thinking_bubble && thinking_bubble->get_parent() == messages_container) {
 		messages_container->move_child(thinking_bubble, -1);
 	}
 
+	_trim_chat_window();
 	call_deferred("_scroll_to_bottom");
 }
 
+PanelContainer *AIPanel::_add_notice_bubble(const String &p_message) {
+	// Greetings and status lines: staying out of current_messages keeps a chat
+	// that has only these from being saved or opening a journal
+	Dictionary msg_entry;
+	msg_entry["sender"] = "AI";
+	msg_entry["text"] = p_message;
+	msg_entry["is_user"] = false;
+
+	PanelContainer *bubble = _create_message_bubble(msg_entry);
+	bubble->set_meta("chat_order", 2 * current_messages.size());
+	messages_container->add_child(bubble);
+
+	// Move thinking indicator to end
+	if (thinking_bubble && thinking_bubble->get_parent() == messages_container) {
+		messages_container->move_child(thinking_bubble, -1);
+	}
+
+	call_deferred("_scroll_to_bottom");
+	return bubble;
+}
+
+void AIPanel::_add_chat_bubble(const Dictionary &p_extra, Control *p_bubble) {
+	// Sits between the message before it and the next one
+	Dictionary extra = p_extra;
+	extra["chat_order"] = 2 * current_messages.size();
+	chat_extras.push_back(extra);
+	p_bubble->set_meta("chat_order", extra["chat_order"]);
+	messages_container->add_child(p_bubble);
+
+	// Move thinking indicator to end
+	if (thinking_bubble && thinking_bubble->get_parent() == messages_container) {
+		messages_container->move_child(thinking_bubble, -1);
+	}
+}
+
+static Ref<Image> _chat_image_from_png(const PackedByteArray &p_png) {
+	Ref<Image> img;
+	img.instantiate();
+	if (p_png.is_empty() || img->load_png_from_buffer(p_png) != OK) {
+		return Ref<Image>();
+	}
+	return img;
+}
+
+Control *AIPanel::_create_extra_bubble(const Dictionary &p_extra) {
+	String kind = p_extra.get("kind", "");
+	Control *bubble = nullptr;
+	if (kind == "image") {
+		bubble = _create_image_bubble(p_extra.get("path", ""), p_extra.get("caption", ""));
+	} else if (kind == "user_image") {
+		bubble = _create_user_image_bubble(_chat_image_from_png(p_extra.get("png", PackedByteArray())));
+	} else if (kind == "user_images") {
+		Vector<Ref<Image>> thumbs;
+		Array pngs = p_extra.get("pngs", Array());
+		for (int i = 0; i < pngs.size(); i++) {
+			thumbs.push_back(_chat_image_from_png(pngs[i]));
+		}
+		bubble = _create_user_images_bubble(thumbs);
+	} else if (kind == "thought") {
+		bubble = _create_thought_bubble(p_extra.get("duration", 0.0), p_extra.get("content", ""));
+	} else {
+		bubble = _create_approval_bubble(p_extra);
+	}
+	bubble->set_meta("chat_order", p_extra["chat_order"]);
+	return bubble;
+}
+
+void AIPanel::_insert_chat_bubble(Control *p_bubble) {
+	// Children stay sorted by chat_order; equal orders keep their log order
+	int order = p_bubble->get_meta("chat_order");
+	int insert_at = -1;
+	for (int j = 0; j < messages_container->get_child_count(); j++) {
+		Control *child = Object::cast_to<Control>(messages_container->get_child(j));
+		if (child && child->has_meta("chat_order") && int(child->get_meta("chat_order")) > order) {
+			insert_at = j;
+			break;
+		}
+	}
+	messages_container->add_child(p_bubble);
+	if (insert_at >= 0) {
+		messages_container->move_child(p_bubble, insert_at);
+	} else if (thinking_bubble && thinking_bubble->get_parent() == messages_container) {
+		messages_container->move_child(thinking_bubble, -1);
+	}
+}
+
+void AIPanel::_trim_chat_window() {
+	int live = current_messages.size() - first_live_message;
+	if (live <= CHAT_LIVE_MESSAGES || loading_earlier) return;
+
+	// Leave paged-in history alone while the user is reading it
+	if (chat_scroll) {
+		float max_scroll = chat_scroll->get_v_scroll_bar()->get_max();
+		float distance_from_bottom = max_scroll - chat_scroll->get_size().y - chat_scroll->get_v_scroll();
+		if (distance_from_bottom >= _scaled_ui_size(150)) return;
+	}
+
+	int new_first = current_messages.size() - CHAT_LIVE_MESSAGES;
+	int cutoff = 2 * new_first + 1;
+	Vector<Node *> to_remove;
+	for (int i = 0; i < messages_container->get_child_count(); i++) {
+		Control *child = Object::cast_to<Control>(messages_container->get_child(i));
+		if (!child || !child->has_meta("chat_order")) continue;
+		int order = child->get_meta("chat_order");
+		if (order >= cutoff) break;
+		to_remove.push_back(child);
+	}
+	for (Node *n : to_remove) {
+		if (current_typing_label && n->is_ancestor_of(current_typing_label)) {
+			current_typing_label = nullptr;
+			typing_full_text = "";
+		}
+		if (n == welcome_bubble) {
+			welcome_bubble = nullptr;
+		}
+		messages_container->remove_child(n);
+		memdelete(n);
+	}
+	first_live_message = new_first;
+	_update_earlier_button();
+}
+
+void AIPanel::_show_earlier_messages() {
+	if (first_live_message <= 0 || loading_earlier) return;
+
+	int start = MAX(0, first_live_message - CHAT_PAGE_MESSAGES);
+
+	// Keep the message the user is looking at in place while rows are prepended
+	if (chat_scroll) {
+		earlier_scroll_anchor = chat_scroll->get_v_scroll_bar()->get_max() - chat_scroll->get_v_scroll();
+	}
+
+	// Rebuild this page: messages [start, first_live_message) and the other
+	// bubbles trimmed with them (those after up to first_live_message messages)
+	for (int i = start; i < first_live_message; i++) {
+		PanelContainer *bubble = _create_message_bubble(current_messages[i]);
+		bubble->set_meta("chat_order", 2 * i + 1);
+		_insert_chat_bubble(bubble);
+	}
+	for (int i = 0; i < chat_extras.size(); i++) {
+		int order = chat_extras[i]["chat_order"];
+		if (order / 2 > first_live_message) break;
+		if (order / 2 > start || start == 0) {
+			_insert_chat_bubble(_create_extra_bubble(chat_extras[i]));
+		}
+	}
+
+	first_live_message = start;
+	_update_earlier_button();
+
+	// Scrollbar range only settles after the container re-sorts
+	loading_earlier = true;
+	get_tree()->connect("process_frame", callable_mp(this, &AIPanel::_restore_earlier_scroll), CONNECT_ONE_SHOT);
+}
+
+void AIPanel::_restore_earlier_scroll() {
+	loading_earlier = false;
+	if (!chat_scroll) return;
+	chat_scroll->set_v_scroll((int)(chat_scroll->get_v_scroll_bar()->get_max() - earlier_scroll_anchor));
+}
+
+void AIPanel::_on_chat_scrolled(double p_value) {
+	// Reaching the top pages in older history, like most chat clients
+	if (p_value <= 0.0 && first_live_message > 0 && !loading_earlier && messages_container->is_visible_in_tree()) {
+		_show_earlier_messages();
+	}
+}
+
+void AIPanel::_update_earlier_button() {
+	if (!earlier_button) return;
+	earlier_button->set_visible(first_live_message > 0);
+	earlier_button->set_text("Show " + itos(MIN(first_live_message, CHAT_PAGE_MESSAGES)) + " earlier messages (" + itos(first_live_message) + " hidden)");
+	messages_container->move_child(earlier_button, 0);
+}
+
 void AIPanel::_add_image_bubble(const String &p_path, const String &p_caption) {
+	// Reloaded from the file if the bubble is rebuilt
+	Dictionary extra;
+	extra["kind"] = "image";
+	extra["path"] = p_path;
+	extra["caption"] = p_caption;
+	_add_chat_bubble(extra, _create_image_bubble(p_path, p_caption));
+	
+	call_deferred("_scroll_to_bottom");
+}
+
+Control *AIPanel::_create_image_bubble(const String &p_path, const String &p_caption) {
 	// Create bubble panel for image display
 	PanelContainer *bubble = memnew(PanelContainer);
 	bubble->set_h_size_flags(SIZE_EXPAND_FILL);
@@ -447,19 +644,29 @@ void AIPanel::_add_image_bubble(const String &p_path, const String &p_caption) {
 		content->add_child(err_label);
 	}
 	
-	messages_container->add_child(bubble);
+	return bubble;
+}
+
+void AIPanel::_add_user_image_bubble(const Ref<Image> &p_image) {
+	if (!p_image.is_valid() || p_image->is_empty()) return;
 	
-	// Move thinking indicator to end
-	if (thinking_bubble && thinking_bubble->get_parent() == messages_container) {
-		messages_container->move_child(thinking_bubble, -1);
+	Ref<Image> display_img = p_image->duplicate();
+	// Resize if too large (max 300px wide)
+	if (display_img->get_width() > 300) {
+		float scale = 300.0f / display_img->get_width();
+		display_img->resize(300, int(display_img->get_height() * scale), Image::INTERPOLATE_LANCZOS);
 	}
 	
+	// Only the display-sized copy is kept, compressed, for rebuilding
+	Dictionary extra;
+	extra["kind"] = "user_image";
+	extra["png"] = display_img->save_png_to_buffer();
+	_add_chat_bubble(extra, _create_user_image_bubble(display_img));
+	
 	call_deferred("_scroll_to_bottom");
 }
 
-void AIPanel::_add_user_image_bubble(const Ref<Image> &p_image) {
-	if (!p_image.is_valid() || p_image->is_empty()) return;
-	
+Control *AIPanel::_create_user_image_bubble(const Ref<Image> &p_display_image) {
 	// Create bubble panel with user styling (right-aligned, blue tint)
 	PanelContainer *bubble = memnew(PanelContainer);
 	bubble->set_h_size_flags(SIZE_EXPAND_FILL);
@@ -478,17 +685,10 @@ void AIPanel::_add_user_image_bubble(const Ref<Image> &p_image) {
 	bubble->add_child(content);
 	
 	// Create texture from image
-	Ref<Image> display_img = p_image->duplicate();
-	// Resize if too large (max 300px wide)
-	if (display_img->get_width() > 300) {
-		float scale = 300.0f / display_img->get_width();
-		display_img->resize(300, int(display_img->get_height() * scale), Image::INTERPOLATE_LANCZOS);
-	}
-	
-	Ref<ImageTexture> tex = ImageTexture::create_from_image(display_img);
-	
 	TextureRect *img_display = memnew(TextureRect);
-	img_display->set_texture(tex);
+	if (p_display_image.is_valid()) {
+		img_display->set_texture(ImageTexture::create_from_image(p_display_image));
+	}
 	img_display->set_expand_mode(TextureRect::EXPAND_FIT_WIDTH_PROPORTIONAL);
 	img_display->set_stretch_mode(TextureRect::STRETCH_KEEP_ASPECT_CENTERED);
 	img_display->set_custom_minimum_size(Size2(_scaled_ui_size(150), _scaled_ui_size(100)));
@@ -503,20 +703,41 @@ void AIPanel::_add_user_image_bubble(const Ref<Image> &p_image) {
 	caption->add_theme_color_override("font_color", Color(0.6, 0.7, 0.8));
 	content->add_child(caption);
 	
-	messages_container->add_child(bubble);
-	
-	// Move thinking indicator to end
-	if (thinking_bubble && thinking_bubble->get_parent() == messages_container) {
-		messages_container->move_child(thinking_bubble, -1);
-	}
-	
-	call_deferred("_scroll_to_bottom");
+	return bubble;
 }
 
 // Display multiple images in a single horizontal row (side-by-side)
 void AIPanel::_add_user_images_row(const Vector<Ref<Image>> &p_images) {
 	if (p_images.is_empty()) return;
 	
+	// Create scaled thumbnails; only these are kept, compressed, for rebuilding
+	const int THUMB_SIZE = _scaled_ui_size(80);  // Size per thumbnail in row
+	Vector<Ref<Image>> thumbs;
+	Array pngs;
+	for (int i = 0; i < p_images.size(); i++) {
+		Ref<Image> img = p_images[i];
+		if (!img.is_valid() || img->is_empty()) continue;
+		
+		Ref<Image> thumb_img = img->duplicate();
+		int orig_w = thumb_img->get_width();
+		int orig_h = thumb_img->get_height();
+		float scale = MIN((float)THUMB_SIZE / orig_w, (float)THUMB_SIZE / orig_h);
+		int new_w = MAX(1, (int)(orig_w * scale));
+		int new_h = MAX(1, (int)(orig_h * scale));
+		thumb_img->resize(new_w, new_h);
+		thumbs.push_back(thumb_img);
+		pngs.push_back(thumb_img->save_png_to_buffer());
+	}
+	
+	Dictionary extra;
+	extra["kind"] = "user_images";
+	extra["pngs"] = pngs;
+	_add_chat_bubble(extra, _create_user_images_bubble(thumbs));
+	
+	call_deferred("_scroll_to_bottom");
+}
+
+Control *AIPanel::_create_user_images_bubble(const Vector<Ref<Image>> &p_thumbs) {
 	// Create bubble panel with user styling
 	PanelContainer *bubble = memnew(PanelContainer);
 	bubble->set_h_size_flags(SIZE_EXPAND_FILL);
@@ -538,18 +759,9 @@ void AIPanel::_add_user_images_row(const Vector<Ref<Image>> &p_images) {
 	
 	// Add each image as a thumbnail in the row
 	const int THUMB_SIZE = _scaled_ui_size(80);  // Size per thumbnail in row
-	for (int i = 0; i < p_images.size(); i++) {
-		Ref<Image> img = p_images[i];
-		if (!img.is_valid() || img->is_empty()) continue;
-		
-		// Create scaled thumbnail
-		Ref<Image> thumb_img = img->duplicate();
-		int orig_w = thumb_img->get_width();
-		int orig_h = thumb_img->get_height();
-		float scale = MIN((float)THUMB_SIZE / orig_w, (float)THUMB_SIZE / orig_h);
-		int new_w = MAX(1, (int)(orig_w * scale));
-		int new_h = MAX(1, (int)(orig_h * scale));
-		thumb_img->resize(new_w, new_h);
+	for (int i = 0; i < p_thumbs.size(); i++) {
+		Ref<Image> thumb_img = p_thumbs[i];
+		if (!thumb_img.is_valid() || thumb_img->is_empty()) continue;
 		
 		Ref<ImageTexture> tex = ImageTexture::create_from_image(thumb_img);
 		
@@ -561,14 +773,7 @@ void AIPanel::_add_user_images_row(const Vector<Ref<Image>> &p_images) {
 		row->add_child(img_display);
 	}
 	
-	messages_container->add_child(bubble);
-	
-	// Move thinking indicator to end
-	if (thinking_bubble && thinking_bubble->get_parent() == messages_container) {
-		messages_container->move_child(thinking_bubble, -1);
-	}
-	
-	call_deferred("_scroll_to_bottom");
+	return bubble;
 }
 
 
@@ -591,6 +796,7 @@ void AIPanel::_show_thinking() {
 			thinking_text->clear();
 		}
 	}
+	thinking_shows_thoughts = false;
 	waiting_for_response = true;
 	streaming_text = "";
 	current_thought_text = "";
@@ -601,6 +807,7 @@ void AIPanel::_show_thinking() {
 		send_button->add_theme_color_override("font_color", COLOR_ERROR);
 	}
 	
+	_update_anim_timer();
 	call_deferred("_scroll_to_bottom");
 }
 
@@ -653,6 +860,14 @@ void AIPanel::_on_thinking_toggle() {
 }
 
 void AIPanel::_add_thought_bubble(float p_duration, const String &p_content) {
+	Dictionary extra;
+	extra["kind"] = "thought";
+	extra["duration"] = p_duration;
+	extra["content"] = p_content;
+	_add_chat_bubble(extra, _create_thought_bubble(p_duration, p_content));
+}
+
+Control *AIPanel::_create_thought_bubble(float p_duration, const String &p_content) {
 	// Cascade-style: minimal "Thought for Xs >" collapsible line
 	PanelContainer *bubble = memnew(PanelContainer);
 	bubble->set_h_size_flags(SIZE_EXPAND_FILL);
@@ -706,7 +921,7 @@ void AIPanel::_add_thought_bubble(float p_duration, const String &p_content) {
 
 	header->connect("pressed", callable_mp(this, &AIPanel::_on_thought_toggle).bind(header, scroll, duration_str));
 
-	messages_container->add_child(bubble);
+	return bubble;
 }
 
 void AIPanel::_on_thought_toggle(Button *p_header, ScrollContainer *p_scroll, const String &p_duration) {
@@ -820,6 +1035,29 @@ void AIPanel::_on_ui_anim_tick() {
 		ambient_pulse -= 0.02f;
 		if (ambient_pulse < 0) ambient_pulse = 0;
 	}
+	
+	_update_anim_timer();
+}
+
+bool AIPanel::_is_animating() const {
+	return (waiting_for_response && thinking_bubble && thinking_bubble->is_visible()) ||
+			(current_typing_label && !typing_full_text.is_empty()) ||
+			ambient_pulse > 0;
+}
+
+void AIPanel::_update_anim_timer() {
+	if (!ui_anim_timer || !ui_anim_timer->is_inside_tree()) return;
+	
+	if (_is_animating()) {
+		if (ui_anim_timer->is_stopped()) {
+			ui_anim_timer->start();
+		}
+	} else if (!ui_anim_timer->is_stopped()) {
+		ui_anim_timer->stop();
+		// Idle: leave the connection dot solid instead of breathing
+		connection_breathe = Math_PI * 0.5f;
+		_update_connection_indicator();
+	}
 }
 
 // ═══════════════════════════════════════════════════════════════════════════
@@ -859,26 +1097,19 @@ void AIPanel::_update_typing_reveal() {
 	typing_phase += 0.15f;  // Characters per frame
 	
 	if (typing_phase >= 1.0f) {
-		typing_phase -= 1.0f;
-		typing_char_index++;
+		int count = int(typing_phase);
+		typing_phase -= count;
+		count = MIN(count, typing_full_text.length() - typing_char_index);
 		
-		// Reveal next character
-		if (typing_char_index <= typing_full_text.length()) {
-			current_typing_label->clear();
-			current_typing_label->add_text(typing_full_text.substr(0, typing_char_index));
-			
-			// Add blinking cursor if not done
-			if (typing_char_index < typing_full_text.length()) {
-				// Blinking cursor effect
-				float blink = sin(anim_time * 8.0f);
-				if (blink > 0) {
-					current_typing_label->add_text("|");  // Cursor
-				}
-			}
-		} else {
+		// Append only the newly revealed characters; RichTextLabel reshapes
+		// just the last paragraph instead of the whole text. There is no
+		// blinking "|" cursor any more: toggling it means clear() and re-adding
+		// everything revealed so far, which is the cost this avoids.
+		current_typing_label->add_text(typing_full_text.substr(typing_char_index, count));
+		typing_char_index += count;
+		
+		if (typing_char_index >= typing_full_text.length()) {
 			// Done typing
-			current_typing_label->clear();
-			current_typing_label->add_text(typing_full_text);
 			current_typing_label = nullptr;
 			typing_full_text = "";
 			typing_char_index = 0;
@@ -896,6 +1127,7 @@ void AIPanel::_start_typing_reveal(RichTextLabel *label, const String &text) {
 	if (label) {
 		label->clear();
 	}
+	_update_anim_timer();
 }
 
 void AIPanel::_update_neural_activity() {
@@ -1095,6 +1327,7 @@ void AIPanel::_poll_websocket() {
 			ws_connected = true;
 			ws_reconnect_attempts = 0; // Reset backoff on successful connection
 			print_line("AIPanel: WebSocket connected!");
+			_update_connection_indicator();
 		}
 		
 		// Process incoming packets
@@ -1110,8 +1343,9 @@ void AIPanel::_poll_websocket() {
 	} else if (state == WebSocketPeer::STATE_CLOSED) {
 		if (ws_connected) {
 			print_line("AIPanel: WebSocket disconnected, will retry...");
+			ws_connected = false;
+			_update_connection_indicator();
 		}
-		ws_connected = false;
 		
 		// Exponential backoff: don't spam reconnect attempts
 		uint64_t now = Time::get_singleton()->get_ticks_msec();
@@ -1144,9 +1378,9 @@ void AIPanel::_on_ws_message(const String &p_message) {
 		streaming_text = "";
 	} else if (type == "thought") {
 		String chunk = data.get("chunk", "");
-		String elapsed = data.get("elapsed", "0");
 		current_thought_text += chunk;
-		_update_thinking_text("[Thinking " + elapsed + "s...]\n" + current_thought_text);
+		// Elapsed time is already ticking in thinking_header
+		_append_thought_text(chunk);
 	} else if (type == "status") {
 		String text = data.get("text", "");
 		_update_thinking_text(text);
@@ -1271,26 +1505,8 @@ void AIPanel::_on_ws_message(const String &p_message) {
 			pending_approval_id = "";
 		} else if (!tool_id.is_empty()) {
 			// Late acknowledgment — dismiss the UI bubble for this tool_id
-			for (int i = messages_container->get_child_count() - 1; i >= 0; i--) {
-				Control *bubble = Object::cast_to<Control>(messages_container->get_child(i));
-				if (!bubble || !bubble->has_meta("approval_id")) {
-					continue;
-				}
-				if (String(bubble->get_meta("approval_id")) == tool_id) {
-					Control *actions = Object::cast_to<Control>(bubble->find_child("ApprovalActions", true, false));
-					if (actions) {
-						actions->set_visible(false);
-					}
-					Label *decision_label = Object::cast_to<Label>(bubble->find_child("ApprovalDecision", true, false));
-					if (decision_label) {
-						bool was_approved = data.get("approved", true);
-						decision_label->set_text(was_approved ? "Status: auto-approved" : "Status: dismissed");
-						decision_label->add_theme_color_override("font_color", Color(0.72, 0.75, 0.82));
-						decision_label->set_visible(true);
-					}
-					break;
-				}
-			}
+			bool was_approved = data.get("approved", true);
+			_set_approval_decision(tool_id, was_approved ? "Status: auto-approved" : "Status: dismissed", Color(0.72, 0.75, 0.82));
 			if (pending_approval_id == tool_id) {
 				pending_approval_id = "";
 			}
@@ -1443,70 +1659,47 @@ String AIPanel::_normalize_project_path(const String &p_path) const {
 	return candidate;
 }
 
-String AIPanel::_build_line_change_preview(const String &p_before, const String &p_after, int p_max_change_lines, int &r_added, int &r_removed) const {
-	r_added = 0;
-	r_removed = 0;
-
-	PackedStringArray before_lines = p_before.split("\n");
-	PackedStringArray after_lines = p_after.split("\n");
-
-	int i = 0;
-	int j = 0;
-	int emitted_lines = 0;
-	String preview;
+void AIPanel::_diff_job_task(DiffJob *p_job) {
+	BridgeLineDiff::Result result;
+	BridgeLineDiff::diff(p_job->before, p_job->after, result);
+	p_job->preview = BridgeLineDiff::format_preview(result, DIFF_PREVIEW_MAX_LINES);
+	p_job->added = result.added;
+	p_job->removed = result.removed;
+	p_job->done.set();
+	callable_mp(this, &AIPanel::_collect_diff_jobs).call_deferred();
+}
 
-	while (i < before_lines.size() || j < after_lines.size()) {
-		if (i < before_lines.size() && j < after_lines.size() && before_lines[i] == after_lines[j]) {
+void AIPanel::_collect_diff_jobs() {
+	for (uint32_t i = 0; i < diff_jobs.size();) {
+		DiffJob *job = diff_jobs[i];
+		if (!job->done.is_set()) {
 			i++;
-			j++;
 			continue;
 		}
+		// Only the task's return is left to wait for
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(job->task_id);
+		diff_jobs.remove_at(i);
 
-		if (emitted_lines >= p_max_change_lines) {
-			preview += "... (diff truncated)\n";
-			break;
-		}
-
-		bool deletion = i < before_lines.size() &&
-			(j >= after_lines.size() || (i + 1 < before_lines.size() && j < after_lines.size() && before_lines[i + 1] == after_lines[j]));
-		bool addition = j < after_lines.size() &&
-			(i >= before_lines.size() || (j + 1 < after_lines.size() && i < before_lines.size() && before_lines[i] == after_lines[j + 1]));
-
-		if (deletion) {
-			preview += "- " + itos(i + 1) + ": " + before_lines[i] + "\n";
-			r_removed++;
-			i++;
-			emitted_lines++;
-			continue;
+		Button *header = Object::cast_to<Button>(ObjectDB::get_instance(job->header_id));
+		if (header) {
+			header->set_text("[M] " + job->file_name + " (+" + itos(job->added) + " -" + itos(job->removed) + ")");
 		}
-
-		if (addition) {
-			preview += "+ " + itos(j + 1) + ": " + after_lines[j] + "\n";
-			r_added++;
-			j++;
-			emitted_lines++;
-			continue;
-		}
-
-		if (i < before_lines.size()) {
-			preview += "- " + itos(i + 1) + ": " + before_lines[i] + "\n";
-			r_removed++;
-			i++;
-			emitted_lines++;
-		}
-		if (j < after_lines.size() && emitted_lines < p_max_change_lines) {
-			preview += "+ " + itos(j + 1) + ": " + after_lines[j] + "\n";
-			r_added++;
-			j++;
-			emitted_lines++;
+		RichTextLabel *changes_text = Object::cast_to<RichTextLabel>(ObjectDB::get_instance(job->text_id));
+		if (changes_text) {
+			changes_text->clear();
+			changes_text->add_text(job->preview);
 		}
+		memdelete(job);
 	}
+}
 
-	if (preview.is_empty()) {
-		preview = "No line-level differences detected.";
+void AIPanel::_cancel_diff_jobs() {
+	// Jobs can't be interrupted; they are short once capped, so just drain them
+	for (DiffJob *job : diff_jobs) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(job->task_id);
+		memdelete(job);
 	}
-
-	return preview;
+	diff_jobs.clear();
 }
 
 void AIPanel::_show_approval_ui(const String &p_tool_id, const String &p_tool_name, const String &p_question, const Dictionary &p_params) {
@@ -1515,10 +1708,26 @@ void AIPanel::_show_approval_ui(const String &p_tool_id, const String &p_tool_na
 	// Hide thinking indicator during approval
 	_hide_thinking();
 	
+	Dictionary extra;
+	extra["kind"] = "approval";
+	extra["tool_id"] = p_tool_id;
+	extra["tool_name"] = p_tool_name;
+	extra["question"] = p_question;
+	extra["params"] = p_params;
+	_add_chat_bubble(extra, _create_approval_bubble(extra));
+	call_deferred("_scroll_to_bottom");
+}
+
+Control *AIPanel::_create_approval_bubble(const Dictionary &p_extra) {
+	String tool_id = p_extra.get("tool_id", "");
+	String tool_name = p_extra.get("tool_name", "");
+	String question = p_extra.get("question", "");
+	Dictionary params = p_extra.get("params", Dictionary());
+	
 	// Create approval bubble
 	PanelContainer *bubble = memnew(PanelContainer);
 	bubble->set_h_size_flags(SIZE_EXPAND_FILL);
-	bubble->set_meta("approval_id", p_tool_id);
+	bubble->set_meta("approval_id", tool_id);
 	
 	Ref<StyleBoxFlat> style;
 	style.instantiate();
@@ -1542,9 +1751,9 @@ void AIPanel::_show_approval_ui(const String &p_tool_id, const String &p_tool_na
 	
 	// Question/Info text - display friendly question if provided, otherwise tool name
 	Label *info = memnew(Label);
-	String question_text = p_question.strip_edges();
+	String question_text = question.strip_edges();
 	if (question_text.is_empty()) {
-		question_text = "Confirm action for tool: " + p_tool_name;
+		question_text = "Confirm action for tool: " + tool_name;
 	}
 	info->set_text(question_text);
 	info->set_autowrap_mode(TextServer::AUTOWRAP_WORD_SMART);
@@ -1553,12 +1762,12 @@ void AIPanel::_show_approval_ui(const String &p_tool_id, const String &p_tool_na
 	vbox->add_child(info);
 	
 	// Show some params
-	if (p_params.has("node") || p_params.has("path") || p_params.has("name")) {
+	if (params.has("node") || params.has("path") || params.has("name")) {
 		Label *params_label = memnew(Label);
 		String param_text = "Context:\n";
-		if (p_params.has("node")) param_text += "Node: " + String(p_params["node"]) + "\n";
-		if (p_params.has("path")) param_text += "Path: " + String(p_params["path"]) + "\n";
-		if (p_params.has("name")) param_text += "Name: " + String(p_params["name"]);
+		if (params.has("node")) param_text += "Node: " + String(params["node"]) + "\n";
+		if (params.has("path")) param_text += "Path: " + String(params["path"]) + "\n";
+		if (params.has("name")) param_text += "Name: " + String(params["name"]);
 		params_label->set_text(param_text.strip_edges());
 		params_label->add_theme_color_override("font_color", Color(0.72, 0.75, 0.82));
 		params_label->add_theme_font_size_override("font_size", _theme_font_with_delta(this, -1, _scaled_ui_size(12)));
@@ -1643,8 +1852,49 @@ void AIPanel::_show_approval_ui(const String &p_tool_id, const String &p_tool_na
 	decision_label->add_theme_color_override("font_color", Color(0.72, 0.75, 0.82));
 	vbox->add_child(decision_label);
 	
-	messages_container->add_child(bubble);
-	call_deferred("_scroll_to_bottom");
+	// Rebuilt after a decision: show the outcome instead of the buttons
+	if (p_extra.has("decision")) {
+		buttons->set_visible(false);
+		decision_label->set_text(p_extra["decision"]);
+		decision_label->add_theme_color_override("font_color", p_extra.get("decision_color", Color(0.72, 0.75, 0.82)));
+		decision_label->set_visible(true);
+	}
+	
+	return bubble;
+}
+
+void AIPanel::_set_approval_decision(const String &p_tool_id, const String &p_text, const Color &p_color) {
+	// Record it for rebuilds, then update the bubble if it is live
+	for (int i = chat_extras.size() - 1; i >= 0; i--) {
+		Dictionary extra = chat_extras[i];
+		if (String(extra.get("kind", "")) == "approval" && String(extra.get("tool_id", "")) == p_tool_id) {
+			extra["decision"] = p_text;
+			extra["decision_color"] = p_color;
+			break;
+		}
+	}
+	
+	for (int i = messages_container->get_child_count() - 1; i >= 0; i--) {
+		Control *bubble = Object::cast_to<Control>(messages_container->get_child(i));
+		if (!bubble || !bubble->has_meta("approval_id")) {
+			continue;
+		}
+		if (String(bubble->get_meta("approval_id")) != p_tool_id) {
+			continue;
+		}
+		
+		Control *actions = Object::cast_to<Control>(bubble->find_child("ApprovalActions", true, false));
+		if (actions) {
+			actions->set_visible(false);
+		}
+		Label *decision_label = Object::cast_to<Label>(bubble->find_child("ApprovalDecision", true, false));
+		if (decision_label) {
+			decision_label->set_text(p_text);
+			decision_label->add_theme_color_override("font_color", p_color);
+			decision_label->set_visible(true);
+		}
+		break;
+	}
 }
 
 void AIPanel::_on_approval_response(bool p_approved) {
@@ -1667,33 +1917,10 @@ void AIPanel::_on_approval_response(bool p_approved) {
 	}
 
 	// Hide action buttons on the matching approval bubble and show final state.
-	for (int i = messages_container->get_child_count() - 1; i >= 0; i--) {
-		Control *bubble = Object::cast_to<Control>(messages_container->get_child(i));
-		if (!bubble || !bubble->has_meta("approval_id")) {
-			continue;
-		}
-		String bubble_approval_id = String(bubble->get_meta("approval_id"));
-		if (bubble_approval_id != approval_id) {
-			continue;
-		}
-
-		Control *actions = Object::cast_to<Control>(bubble->find_child("ApprovalActions", true, false));
-		if (actions) {
-			actions->set_visible(false);
-		}
-
-		Label *decision_label = Object::cast_to<Label>(bubble->find_child("ApprovalDecision", true, false));
-		if (decision_label) {
-			if (p_approved) {
-				decision_label->set_text("Status: approved");
-				decision_label->add_theme_color_override("font_color", Color(0.62, 0.90, 0.67));
-			} else {
-				decision_label->set_text("Status: rejected");
-				decision_label->add_theme_color_override("font_color", Color(0.93, 0.58, 0.58));
-			}
-			decision_label->set_visible(true);
-		}
-		break;
+	if (p_approved) {
+		_set_approval_decision(approval_id, "Status: approved", Color(0.62, 0.90, 0.67));
+	} else {
+		_set_approval_decision(approval_id, "Status: rejected", Color(0.93, 0.58, 0.58));
 	}
 	
 	// Add confirmation message
@@ -1947,6 +2174,7 @@ String AIPanel::_encode_image_base64(const Ref<Image> &p_image) {
 }
 
 void AIPanel::_update_thinking_text(const String &p_text) {
+	thinking_shows_thoughts = false;
 	if (thinking_text) {
 		thinking_text->clear();
 		thinking_text->add_text(p_text);
@@ -1955,6 +2183,20 @@ void AIPanel::_update_thinking_text(const String &p_text) {
 	call_deferred("_scroll_to_bottom");
 }
 
+void AIPanel::_append_thought_text(const String &p_chunk) {
+	if (thinking_text) {
+		if (thinking_shows_thoughts) {
+			// Append-only: reshaping the whole thought on every chunk is quadratic
+			thinking_text->add_text(p_chunk);
+		} else {
+			thinking_text->clear();
+			thinking_text->add_text(current_thought_text);
+			thinking_shows_thoughts = true;
+		}
+	}
+	call_deferred("_scroll_to_bottom");
+}
+
 void AIPanel::_send_via_websocket(const String &p_message) {
 	if (ws_peer.is_null() || ws_peer->get_ready_state() != WebSocketPeer::STATE_OPEN) {
 		// Fall back to HTTP
@@ -2214,11 +2456,7 @@ void AIPanel::_add_rich_diff_entry(const String &p_path, const String &p_tool, c
 	header_row->set_h_size_flags(SIZE_EXPAND_FILL);
 	
 	Button *header = memnew(Button);
-	int added_lines = 0;
-	int removed_lines = 0;
-	String line_preview = _build_line_change_preview(p_before, p_after, 120, added_lines, removed_lines);
-
-	header->set_text("[M] " + normalized_path.get_file() + " (+" + itos(added_lines) + " -" + itos(removed_lines) + ")");
+	header->set_text("[M] " + normalized_path.get_file() + " (diffing...)");
 	header->set_flat(true);
 	header->set_text_alignment(HORIZONTAL_ALIGNMENT_LEFT);
 	header->set_h_size_flags(SIZE_EXPAND_FILL);
@@ -2262,7 +2500,7 @@ void AIPanel::_add_rich_diff_entry(const String &p_path, const String &p_tool, c
 	changes_text->set_scroll_active(false);
 	changes_text->set_selection_enabled(true);
 	changes_text->set_custom_minimum_size(Size2(0, _scaled_ui_size(80)));
-	changes_text->add_text(line_preview);
+	changes_text->add_text("Computing diff...");
 	changes_text->add_theme_color_override("default_color", Color(0.78, 0.8, 0.86));
 	changes_text->add_theme_font_size_override("normal_font_size", _theme_font_with_delta(this, -3, _scaled_ui_size(10), "RichTextLabel"));
 	content->add_child(changes_text);
@@ -2275,6 +2513,16 @@ void AIPanel::_add_rich_diff_entry(const String &p_path, const String &p_tool, c
 	
 	diff_content->add_child(entry);
 	
+	// Splitting and diffing large generated scripts stays off the main thread
+	DiffJob *job = memnew(DiffJob);
+	job->before = p_before;
+	job->after = p_after;
+	job->file_name = normalized_path.get_file();
+	job->header_id = header->get_instance_id();
+	job->text_id = changes_text->get_instance_id();
+	job->task_id = WorkerThreadPool::get_singleton()->add_template_task(this, &AIPanel::_diff_job_task, job, false, "AIPanel diff");
+	diff_jobs.push_back(job);
+	
 	// Auto-switch to Diff tab when new diff arrives
 	if (tab_bar && current_tab != 2) {
 		tab_bar->set_current_tab(2);
@@ -2611,6 +2859,9 @@ void AIPanel::_on_multi_agent_toggle() {
 }
 
 void AIPanel::_on_new_session() {
+	// New ids must not collide with sessions still being compacted
+	_finish_legacy_compaction();
+	
 	// Save current session first
 	_save_current_session();
 	
@@ -2621,17 +2872,17 @@ void AIPanel::_on_new_session() {
 	}
 	_clear_chat();
 	_clear_diff_entries();
-	_add_message_bubble("AI", "New session started. How can I help you?", false);
+	_add_notice_bubble("New session started. How can I help you?");
 }
 
 void AIPanel::_clear_chat() {
 	if (!messages_container) return;
 	
-	// Remove all children except thinking bubble
+	// Remove all children except thinking bubble and the history pager
 	Vector<Node*> to_remove;
 	for (int i = 0; i < messages_container->get_child_count(); i++) {
 		Node *child = messages_container->get_child(i);
-		if (child != thinking_bubble) {
+		if (child != thinking_bubble && child != earlier_button) {
 			to_remove.push_back(child);
 		}
 	}
@@ -2639,12 +2890,20 @@ void AIPanel::_clear_chat() {
 		messages_container->remove_child(n);
 		memdelete(n);
 	}
+	welcome_bubble = nullptr;
+	current_typing_label = nullptr;
+	typing_full_text = "";
 	current_messages.clear();
+	chat_extras.clear();
+	_close_journal();
+	first_live_message = 0;
+	_update_earlier_button();
 }
 
 void AIPanel::_on_history_pressed() {
 	if (!history_popup) return;
 	
+	_finish_legacy_compaction();
 	history_popup->clear();
 	
 	if (saved_sessions.is_empty()) {
@@ -2684,7 +2943,7 @@ void AIPanel::_save_current_session() {
 	ChatSession session;
 	session.id = current_session_id;
 	session.name = session_name->get_text();
-	session.messages = current_messages;
+	// Body stays in the journal; it is re-read if the session is reopened
 	
 	if (existing_idx >= 0) {
 		saved_sessions.write[existing_idx] = session;
@@ -2703,18 +2962,26 @@ void AIPanel::_load_session(int p_id) {
 				session_name->set_text(saved_sessions[i].name);
 			}
 			_clear_chat();
+			journal_continues = true;
 			
-			// Replay all saved messages
-			for (int j = 0; j < saved_sessions[i].messages.size(); j++) {
-				Dictionary m = saved_sessions[i].messages[j];
-				String sender = m.get("sender", "AI");
-				String text = m.get("text", "");
-				bool is_user = m.get("is_user", false);
-				_add_message_bubble(sender, text, is_user);
+			// Restore the log, but only build controls for the newest
+			// messages; older ones page in from the top of the list. Only
+			// current_messages holds the bodies, so switching away frees them.
+			_read_session_journal(p_id, current_messages);
+			first_live_message = MAX(0, current_messages.size() - CHAT_LIVE_MESSAGES);
+			for (int j = first_live_message; j < current_messages.size(); j++) {
+				PanelContainer *bubble = _create_message_bubble(current_messages[j]);
+				bubble->set_meta("chat_order", 2 * j + 1);
+				messages_container->add_child(bubble);
+			}
+			if (thinking_bubble && thinking_bubble->get_parent() == messages_container) {
+				messages_container->move_child(thinking_bubble, -1);
 			}
+			_update_earlier_button();
+			call_deferred("_scroll_to_bottom");
 			
-			if (saved_sessions[i].messages.is_empty()) {
-				_add_message_bubble("AI", "Session '" + saved_sessions[i].name + "' restored (empty).", false);
+			if (current_messages.is_empty()) {
+				_add_notice_bubble("Session '" + saved_sessions[i].name + "' restored (empty).");
 			}
 			return;
 		}
@@ -2725,22 +2992,33 @@ void AIPanel::_load_session(int p_id) {
 // Disk Persistence - Save/Load sessions as JSON to user://
 // ═══════════════════════════════════════════════════════════════════════════
 
-String AIPanel::_get_sessions_path() const {
+String AIPanel::_get_sessions_dir() const {
+	return "user://ai_chat_sessions";
+}
+
+String AIPanel::_get_sessions_index_path() const {
+	return _get_sessions_dir().path_join("index.json");
+}
+
+String AIPanel::_get_session_journal_path(int p_id) const {
+	return _get_sessions_dir().path_join("session_" + itos(p_id) + ".jsonl");
+}
+
+String AIPanel::_get_legacy_sessions_path() const {
 	return "user://ai_chat_sessions.json";
 }
 
+String AIPanel::_get_legacy_moved_journal_path() const {
+	return _get_sessions_dir().path_join("session_legacy_moved.jsonl");
+}
+
 void AIPanel::_save_sessions_to_disk() {
+	// Index only — message bodies are already in the per-session journals
 	Array sessions_arr;
 	for (int i = 0; i < saved_sessions.size(); i++) {
 		Dictionary s;
 		s["id"] = saved_sessions[i].id;
 		s["name"] = saved_sessions[i].name;
-		
-		Array msgs;
-		for (int j = 0; j < saved_sessions[i].messages.size(); j++) {
-			msgs.push_back(saved_sessions[i].messages[j]);
-		}
-		s["messages"] = msgs;
 		sessions_arr.push_back(s);
 	}
 	
@@ -2748,28 +3026,33 @@ void AIPanel::_save_sessions_to_disk() {
 	root["session_counter"] = session_counter;
 	root["sessions"] = sessions_arr;
 	
-	String json_str = JSON::stringify(root, "\t");
-	
-	Ref<FileAccess> f = FileAccess::open(_get_sessions_path(), FileAccess::WRITE);
+	DirAccess::make_dir_recursive_absolute(_get_sessions_dir());
+	Ref<FileAccess> f = FileAccess::open(_get_sessions_index_path(), FileAccess::WRITE);
 	if (f.is_valid()) {
-		f->store_string(json_str);
-		print_line("[AIPanel] Saved " + itos(saved_sessions.size()) + " chat sessions to disk.");
+		f->store_string(JSON::stringify(root));
 	} else {
-		print_line("[AIPanel] Failed to save chat sessions.");
+		print_line("[AIPanel] Failed to save chat session index.");
+	}
+}
+
+void AIPanel::_start_legacy_compaction() {
+	// Older versions kept everything in one big JSON file; split it up in the
+	// background. It is renamed when done, so an interrupted run just repeats.
+	if (FileAccess::exists(_get_legacy_sessions_path())) {
+		legacy_task = WorkerThreadPool::get_singleton()->add_template_task(this, &AIPanel::_compact_legacy_sessions, current_session_id, false, "AIPanel session compaction");
 	}
 }
 
 void AIPanel::_load_sessions_from_disk() {
-	String path = _get_sessions_path();
+	String path = _get_sessions_index_path();
 	if (!FileAccess::exists(path)) return;
 	
 	Ref<FileAccess> f = FileAccess::open(path, FileAccess::READ);
 	if (!f.is_valid()) return;
 	
-	String json_str = f->get_as_text();
 	JSON json;
-	if (json.parse(json_str) != OK) {
-		print_line("[AIPanel] Failed to parse chat sessions JSON.");
+	if (json.parse(f->get_as_text()) != OK) {
+		print_line("[AIPanel] Failed to parse chat session index.");
 		return;
 	}
 	
@@ -2789,18 +3072,147 @@ void AIPanel::_load_sessions_from_disk() {
 		ChatSession session;
 		session.id = s.get("id", 0);
 		session.name = s.get("name", "Unnamed");
+		saved_sessions.push_back(session);
+	}
+	
+	print_line("[AIPanel] Loaded " + itos(saved_sessions.size()) + " chat sessions from index.");
+}
+
+void AIPanel::_append_to_journal(const Dictionary &p_entry) {
+	if (journal_file.is_null()) {
+		String path = _get_session_journal_path(current_session_id);
+		DirAccess::make_dir_recursive_absolute(_get_sessions_dir());
+		if (journal_continues && FileAccess::exists(path)) {
+			journal_file = FileAccess::open(path, FileAccess::READ_WRITE);
+			if (journal_file.is_valid()) {
+				journal_file->seek_end();
+			}
+		} else {
+			// Opened on the first real message of a chat under a fresh id
+			journal_file = FileAccess::open(path, FileAccess::WRITE);
+		}
+		if (journal_file.is_null()) {
+			print_line("[AIPanel] Failed to open chat journal: " + path);
+			return;
+		}
+		journal_continues = true;
+		// List the session right away so a crash doesn't orphan its journal
+		_save_current_session();
+	}
+	
+	journal_file->store_line(JSON::stringify(p_entry));
+	journal_file->flush();
+}
+
+void AIPanel::_close_journal() {
+	journal_file.unref();
+	journal_continues = false;
+}
+
+void AIPanel::_read_session_journal(int p_id, Vector<Dictionary> &r_messages) {
+	r_messages.clear();
+	
+	Ref<FileAccess> f = FileAccess::open(_get_session_journal_path(p_id), FileAccess::READ);
+	if (f.is_null()) return;
+	
+	while (!f->eof_reached()) {
+		String line = f->get_line();
+		if (line.is_empty()) continue;
+		// A torn last record (crash mid-write) just fails to parse
+		JSON json;
+		if (json.parse(line) == OK && json.get_data().get_type() == Variant::DICTIONARY) {
+			r_messages.push_back(json.get_data());
+		}
+	}
+}
+
+void AIPanel::_compact_legacy_sessions(int p_skip_id) {
+	// Worker thread: touches only files, never saved_sessions or the UI
+	String json_str = FileAccess::get_file_as_string(_get_legacy_sessions_path());
+	JSON json;
+	if (json.parse(json_str) != OK || json.get_data().get_type() != Variant::DICTIONARY) {
+		print_line("[AIPanel] Failed to parse legacy chat sessions JSON.");
+		callable_mp(this, &AIPanel::_finish_legacy_compaction).call_deferred();
+		return;
+	}
+	
+	Dictionary root = json.get_data();
+	legacy_session_counter = root.get("session_counter", 1);
+	Array sessions_arr = root.get("sessions", Array());
+	DirAccess::make_dir_recursive_absolute(_get_sessions_dir());
+	
+	for (int i = 0; i < sessions_arr.size(); i++) {
+		if (sessions_arr[i].get_type() != Variant::DICTIONARY) continue;
+		Dictionary s = sessions_arr[i];
+		
+		ChatSession session;
+		session.id = s.get("id", 0);
+		session.name = s.get("name", "Unnamed");
+		// The current session's journal belongs to the main thread, which
+		// replaces it on the first message. Journal that chat aside; it gets
+		// a fresh id once compaction finishes.
+		bool moved = session.id == p_skip_id;
 		
+		Ref<FileAccess> f = FileAccess::open(moved ? _get_legacy_moved_journal_path() : _get_session_journal_path(session.id), FileAccess::WRITE);
+		if (f.is_null()) continue;
 		Array msgs = s.get("messages", Array());
 		for (int j = 0; j < msgs.size(); j++) {
 			if (msgs[j].get_type() == Variant::DICTIONARY) {
-				session.messages.push_back(msgs[j]);
+				f->store_line(JSON::stringify(msgs[j]));
 			}
 		}
-		
-		saved_sessions.push_back(session);
+		if (moved) {
+			legacy_moved = true;
+			legacy_moved_name = session.name;
+		} else {
+			legacy_sessions.push_back(session);
+		}
+	}
+	
+	legacy_ok = true;
+	callable_mp(this, &AIPanel::_finish_legacy_compaction).call_deferred();
+}
+
+void AIPanel::_finish_legacy_compaction() {
+	if (legacy_task == WorkerThreadPool::INVALID_TASK_ID) return;
+	WorkerThreadPool::get_singleton()->wait_for_task_completion(legacy_task);
+	legacy_task = WorkerThreadPool::INVALID_TASK_ID;
+	if (!legacy_ok) return;
+	
+	for (int i = 0; i < legacy_sessions.size(); i++) {
+		bool exists = false;
+		for (int j = 0; j < saved_sessions.size(); j++) {
+			if (saved_sessions[j].id == legacy_sessions[i].id) {
+				exists = true;
+				break;
+			}
+		}
+		if (!exists) {
+			saved_sessions.push_back(legacy_sessions[i]);
+		}
+	}
+	session_counter = MAX(session_counter, legacy_session_counter);
+	legacy_sessions.clear();
+	
+	if (legacy_moved) {
+		legacy_moved = false;
+		Ref<DirAccess> sessions_dir = DirAccess::create(DirAccess::ACCESS_USERDATA);
+		int id = ++session_counter;
+		if (sessions_dir->rename(_get_legacy_moved_journal_path(), _get_session_journal_path(id)) == OK) {
+			ChatSession session;
+			session.id = id;
+			session.name = legacy_moved_name;
+			saved_sessions.push_back(session);
+		} else {
+			print_line("[AIPanel] Failed to move legacy chat session '" + legacy_moved_name + "'; kept in " + _get_legacy_sessions_path() + ".bak");
+		}
 	}
+	_save_sessions_to_disk();
 	
-	print_line("[AIPanel] Loaded " + itos(saved_sessions.size()) + " chat sessions from disk.");
+	// Keep the old file around once, renamed, instead of deleting history
+	Ref<DirAccess> da = DirAccess::create(DirAccess::ACCESS_USERDATA);
+	da->rename(_get_legacy_sessions_path(), _get_legacy_sessions_path() + ".bak");
+	print_line("[AIPanel] Compacted " + itos(saved_sessions.size()) + " legacy chat sessions into journals.");
 }
 
 AIPanel::AIPanel() {
@@ -2830,10 +3242,10 @@ AIPanel::AIPanel() {
 	ws_poll_timer->connect("timeout", callable_mp(this, &AIPanel::_poll_websocket));
 	add_child(ws_poll_timer);
 	
-	// 🌌 UI Animation Timer - 30fps for smooth aurora effects
+	// 🌌 UI Animation Timer - 30fps for smooth aurora effects.
+	// Only runs while something animates; see _update_anim_timer().
 	ui_anim_timer = memnew(Timer);
 	ui_anim_timer->set_wait_time(0.033);  // ~30fps
-	ui_anim_timer->set_autostart(true);
 	ui_anim_timer->connect("timeout", callable_mp(this, &AIPanel::_on_ui_anim_tick));
 	add_child(ui_anim_timer);
 	
@@ -2862,8 +3274,13 @@ AIPanel::AIPanel() {
 	// Connect to WebSocket server
 	_connect_websocket();
 	
-	// Load saved chat sessions from disk
+	// Load saved chat sessions from disk. This chat takes the next id, so it
+	// never truncates an earlier session's journal; the counter is only
+	// stored once the chat gets its first message.
 	_load_sessions_from_disk();
+	session_counter++;
+	current_session_id = session_counter;
+	_start_legacy_compaction();
 	
 	// === HEADER ===
 	HBoxContainer *header = memnew(HBoxContainer);
@@ -2886,6 +3303,7 @@ AIPanel::AIPanel() {
 	connection_indicator->add_theme_color_override("font_color", COLOR_SUCCESS);
 	connection_indicator->set_tooltip_text("WebSocket Status");
 	header->add_child(connection_indicator);
+	_update_connection_indicator();
 	
 	// Agentic Godot Icon - Embedded pixelated "A" with cyan glow
 	TextureRect *icon_rect = memnew(TextureRect);
@@ -2937,7 +3355,7 @@ AIPanel::AIPanel() {
 	header->add_child(title);
 	
 	session_name = memnew(LineEdit);
-	session_name->set_text("Session 1");
+	session_name->set_text("Session " + itos(current_session_id));
 	session_name->set_h_size_flags(SIZE_EXPAND_FILL);
 	session_name->set_flat(true);
 	session_name->add_theme_font_size_override("font_size", _theme_font_with_delta(this, 0, _scaled_ui_size(14), "LineEdit"));
@@ -2976,12 +3394,19 @@ AIPanel::AIPanel() {
 	messages_container->set_h_size_flags(SIZE_EXPAND_FILL);
 	messages_container->add_theme_constant_override("separation", _scaled_ui_size(6));
 	chat_scroll->add_child(messages_container);
+	chat_scroll->get_v_scroll_bar()->connect("value_changed", callable_mp(this, &AIPanel::_on_chat_scrolled));
+	
+	// Pager for history trimmed out of the live window
+	earlier_button = memnew(Button);
+	earlier_button->set_flat(true);
+	earlier_button->set_visible(false);
+	earlier_button->add_theme_color_override("font_color", Color(0.50, 0.50, 0.55));
+	earlier_button->add_theme_font_size_override("font_size", _theme_font_with_delta(this, -2, _scaled_ui_size(11), "Button"));
+	earlier_button->connect("pressed", callable_mp(this, &AIPanel::_show_earlier_messages));
+	messages_container->add_child(earlier_button);
 	
 	// Welcome message (stored so we can remove on first user input)
-	_add_message_bubble("AI", "Hello! I can help you create your game.\n\nTry: \"Create a player scene\" or ask me anything!", false);
-	if (messages_container->get_child_count() > 0) {
-		welcome_bubble = Object::cast_to<PanelContainer>(messages_container->get_child(messages_container->get_child_count() - 1));
-	}
+	welcome_bubble = _add_notice_bubble("Hello! I can help you create your game.\n\nTry: \"Create a player scene\" or ask me anything!");
 	
 	// === BLUEPRINT TAB (Tasks) ===
 	blueprint_tab = memnew(VBoxContainer);
@@ -3276,8 +3701,13 @@ AIPanel::AIPanel() {
 }
 
 AIPanel::~AIPanel() {
+	// Worker tasks hold this panel
+	_finish_legacy_compaction();
+	_cancel_diff_jobs();
+	
 	// Save current session before shutdown
 	_save_current_session();
+	_close_journal();
 	
 	// Kill AI Router process on cleanup
 	if (ai_router_pid > 0) {
@@ -23,6 +23,10 @@
 #include "godot_bridge.h"
 #include "editor/editor_interface.h"
 #include "core/io/resource_loader.h"
+#include "core/io/file_access.h"
+#include "core/object/worker_thread_pool.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
 
 class AIPanel : public VBoxContainer {
 	GDCLASS(AIPanel, VBoxContainer);
@@ -42,21 +46,43 @@ private:
 	LineEdit *session_name = nullptr;
 	Button *new_session_btn = nullptr;
 	int session_counter = 1;
-	int current_session_id = 0;
+	int current_session_id = 0;  // Fresh id per start, assigned after the index loads
 	
 	// Session storage
 	struct ChatSession {
 		int id;
-		String name;
-		Vector<Dictionary> messages;  // {sender, text, is_user}
+		String name;  // Messages live only in the journal and current_messages
 	};
 	Vector<ChatSession> saved_sessions;
 	Vector<Dictionary> current_messages;  // Live message log for current session
 	
-	// Disk persistence
-	void _save_sessions_to_disk();
-	void _load_sessions_from_disk();
-	String _get_sessions_path() const;
+	// Disk persistence: a small index plus one append-only journal per session
+	// (one JSON record per line, written as each message arrives). Bodies are
+	// read only when a session is opened from History.
+	Ref<FileAccess> journal_file;         // Append handle for current_session_id
+	bool journal_continues = false;       // current_messages came from the journal: append, don't truncate
+	void _save_sessions_to_disk();        // Writes the index only
+	void _load_sessions_from_disk();      // Reads the index only
+	void _start_legacy_compaction();      // Once current_session_id is final
+	void _append_to_journal(const Dictionary &p_entry);
+	void _close_journal();
+	void _read_session_journal(int p_id, Vector<Dictionary> &r_messages);
+	String _get_sessions_dir() const;
+	String _get_sessions_index_path() const;
+	String _get_session_journal_path(int p_id) const;
+	String _get_legacy_sessions_path() const;
+	
+	// One-time compaction of the old single-file store into journals, off the
+	// main thread. Sessions land in saved_sessions once it finishes.
+	WorkerThreadPool::TaskID legacy_task = WorkerThreadPool::INVALID_TASK_ID;
+	Vector<ChatSession> legacy_sessions;  // Written by the worker, merged on the main thread
+	int legacy_session_counter = 0;
+	bool legacy_ok = false;
+	bool legacy_moved = false;            // Legacy session with current_session_id's id, journaled under a new id
+	String legacy_moved_name;
+	String _get_legacy_moved_journal_path() const;
+	void _compact_legacy_sessions(int p_skip_id);
+	void _finish_legacy_compaction();
 	
 	// Blueprint tab elements
 	VBoxContainer *blueprint_content = nullptr;
@@ -80,6 +106,19 @@ private:
 	VBoxContainer *messages_container = nullptr;
 	ScrollContainer *chat_scroll = nullptr;
 	PanelContainer *welcome_bubble = nullptr;  // Removed on first user message
+	
+	// Chat virtualization: only bubbles for the newest messages exist as
+	// controls. Older ones are freed and rebuilt on demand: text bubbles from
+	// current_messages, image/thought/approval bubbles from chat_extras.
+	// Every bubble carries "chat_order" meta: 2*i+1 for message i, 2*k for a
+	// non-text bubble added after k messages.
+	static const int CHAT_LIVE_MESSAGES = 60;   // Text bubbles kept as controls
+	static const int CHAT_PAGE_MESSAGES = 20;   // Rebuilt per "show earlier"
+	int first_live_message = 0;                 // Oldest message with a control
+	Button *earlier_button = nullptr;           // "Show N earlier messages"
+	bool loading_earlier = false;               // Waiting to restore scroll anchor
+	float earlier_scroll_anchor = 0.0f;         // Distance from bottom before prepend
+	Vector<Dictionary> chat_extras;             // Non-text bubbles: kind, chat_order, rebuild data
 	LineEdit *input_field = nullptr;
 	Button *send_button = nullptr;
 	OptionButton *model_picker = nullptr;
@@ -108,11 +147,12 @@ private:
 	float thinking_duration = 0.0;
 	String streaming_text = "";
 	String current_thought_text = "";
+	bool thinking_shows_thoughts = false;  // thinking_text holds current_thought_text (append chunks)
 	
 	// ═══════════════════════════════════════════════════════════════════════
 	// 🌌 ANIMATION SYSTEM - Phase 2: Breathing Life
 	// ═══════════════════════════════════════════════════════════════════════
-	Timer *ui_anim_timer = nullptr;       // 30fps animation updates
+	Timer *ui_anim_timer = nullptr;       // 30fps animation updates, stopped when idle
 	float anim_time = 0.0f;               // Continuous animation time
 	float aurora_phase = 0.0f;            // 0-1 cycling for aurora gradient
 	float thinking_pulse = 0.0f;          // Breathing effect intensity
@@ -126,6 +166,8 @@ private:
 	void _update_aurora_border();         // Update thinking bubble border color
 	void _update_orbiting_dots();         // Update orbiting header text
 	void _update_smooth_scroll();         // Eased scroll animation
+	bool _is_animating() const;           // Anything for ui_anim_timer to drive
+	void _update_anim_timer();            // Start/stop ui_anim_timer to match
 	Color _get_aurora_color(float phase); // Get color from aurora gradient
 	
 	// ═══════════════════════════════════════════════════════════════════════
@@ -137,7 +179,7 @@ private:
 	// Typing reveal for AI responses
 	RichTextLabel *current_typing_label = nullptr;  // Currently revealing text
 	String typing_full_text = "";                   // Full text to reveal
-	int typing_char_index = 0;                      // Current character index
+	int typing_char_index = 0;                      // Characters already appended
 	float typing_phase = 0.0f;                      // Character reveal timing
 	
 	// Neural activity bar
@@ -174,6 +216,8 @@ private:
 	String pending_approval_id = "";
 	void _on_approval_response(bool p_approved);
 	void _show_approval_ui(const String &p_tool_id, const String &p_tool_name, const String &p_question, const Dictionary &p_params);
+	Control *_create_approval_bubble(const Dictionary &p_extra);
+	void _set_approval_decision(const String &p_tool_id, const String &p_text, const Color &p_color);
 	
 	// Image attachment (clipboard paste support) - MULTI-IMAGE
 	static const int MAX_PENDING_IMAGES = 5;            // Maximum images allowed
@@ -195,6 +239,7 @@ private:
 	void _on_popup_close();
 	void _clear_image_attachment();
 	void _add_user_images_row(const Vector<Ref<Image>> &p_images);  // Add images as horizontal row in chat
+	Control *_create_user_images_bubble(const Vector<Ref<Image>> &p_thumbs);
 	String _encode_image_base64(const Ref<Image> &p_image);
 
 	void _on_send_pressed();
@@ -209,16 +254,30 @@ private:
 	
 	// Message bubble helpers
 	void _add_message_bubble(const String &p_sender, const String &p_message, bool p_is_user);
+	PanelContainer *_add_notice_bubble(const String &p_message);  // AI-styled, but neither logged nor journaled
+	PanelContainer *_create_message_bubble(const Dictionary &p_entry);
+	void _add_chat_bubble(const Dictionary &p_extra, Control *p_bubble);  // Log as non-text, append before thinking_bubble
+	Control *_create_extra_bubble(const Dictionary &p_extra);  // Rebuild a chat_extras entry
+	void _insert_chat_bubble(Control *p_bubble);               // Insert at its chat_order
+	void _trim_chat_window();
+	void _show_earlier_messages();
+	void _restore_earlier_scroll();
+	void _on_chat_scrolled(double p_value);
+	void _update_earlier_button();
 	void _update_thinking_text(const String &p_text);
+	void _append_thought_text(const String &p_chunk);
 	void _show_thinking();
 	void _hide_thinking();
 	void _finalize_thinking();  // Hide streaming indicator
 	void _on_thinking_toggle();
 	void _add_thought_bubble(float p_duration, const String &p_content);
+	Control *_create_thought_bubble(float p_duration, const String &p_content);
 	void _on_thought_toggle(Button *p_header, ScrollContainer *p_scroll, const String &p_duration);
 	void _update_files_changed(const Array &p_results);
 	void _add_image_bubble(const String &p_path, const String &p_caption);
+	Control *_create_image_bubble(const String &p_path, const String &p_caption);
 	void _add_user_image_bubble(const Ref<Image> &p_image);  // Display user's attached image in chat
+	Control *_create_user_image_bubble(const Ref<Image> &p_display_image);
 	void _clear_files_section();
 	
 	void _send_to_ai_router(const String &p_message);
@@ -235,7 +294,29 @@ private:
 	void _clear_diff_entries();
 	String _normalize_project_path(const String &p_path) const;
 	String _find_res_path_by_basename(const String &p_basename, const String &p_dir) const;
-	String _build_line_change_preview(const String &p_before, const String &p_after, int p_max_change_lines, int &r_added, int &r_removed) const;
+	
+	// Diff previews are computed on WorkerThreadPool and filled into their
+	// entry when done; the entry's controls are looked up by id since the tab
+	// may have been cleared meanwhile.
+	struct DiffJob {
+		String before;
+		String after;
+		String file_name;
+		ObjectID header_id;
+		ObjectID text_id;
+		String preview;   // Worker output
+		int added = 0;
+		int removed = 0;
+		WorkerThreadPool::TaskID task_id = WorkerThreadPool::INVALID_TASK_ID;
+		// Set by the worker before it posts _collect_diff_jobs(); the pool may
+		// not report the task completed yet when that call runs
+		SafeFlag done;
+	};
+	static const int DIFF_PREVIEW_MAX_LINES = 120;
+	LocalVector<DiffJob *> diff_jobs;
+	void _diff_job_task(DiffJob *p_job);
+	void _collect_diff_jobs();
+	void _cancel_diff_jobs();
 	
 	// Agents tab methods
 	void _update_agents_tab();
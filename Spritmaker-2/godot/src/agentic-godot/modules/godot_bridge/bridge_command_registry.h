@@ -11,8 +11,47 @@ class GodotBridge;
 // Command handler function type - takes bridge instance and params, returns result
 using BridgeCommandHandler = std::function<Dictionary(GodotBridge*, const Dictionary&)>;
 
+// Where a command is allowed to run
+enum BridgeCommandThreading {
+	COMMAND_MAIN_THREAD,  // Touches the scene tree, editor UI or bridge state
+	COMMAND_THREAD_SAFE,  // Pure file/project reads, may run on WorkerThreadPool
+	COMMAND_CONNECTION,   // Changes connection state; runs on the main thread once
+	                      // the client has nothing in flight, response sent immediately
+};
+
+// Scheduling priority when several clients have work queued
+enum BridgeCommandPriority {
+	COMMAND_PRIORITY_BULK,         // Large mutations (tile batches, resource generation)
+	COMMAND_PRIORITY_NORMAL,       // Regular edits
+	COMMAND_PRIORITY_INTERACTIVE,  // Cheap queries an agent is usually blocked on
+};
+
+// Registry entry - assigning a handler keeps the existing flags
+struct BridgeCommand {
+	BridgeCommandHandler handler;
+	BridgeCommandThreading threading = COMMAND_MAIN_THREAD;
+	BridgeCommandPriority priority = COMMAND_PRIORITY_NORMAL;
+
+	BridgeCommand &operator=(const BridgeCommandHandler &p_handler) {
+		handler = p_handler;
+		return *this;
+	}
+};
+
 // Registry map type using Godot's HashMap
-using CommandRegistry = HashMap<String, BridgeCommandHandler>;
+using CommandRegistry = HashMap<String, BridgeCommand>;
+
+// Mark an already registered command as safe to run off the main thread
+#define SET_COMMAND_THREAD_SAFE(registry, name) \
+	registry[name].threading = COMMAND_THREAD_SAFE
+
+// Mark a command that renegotiates the connection (framing, encoding)
+#define SET_COMMAND_CONNECTION(registry, name) \
+	registry[name].threading = COMMAND_CONNECTION
+
+// Override the scheduling priority of an already registered command
+#define SET_COMMAND_PRIORITY(registry, name, prio) \
+	registry[name].priority = prio
 
 // Helper macro for registering commands - pass just method name, not method()
 #define REGISTER_COMMAND_0(registry, name, method_name) \
@@ -2,6 +2,7 @@
 // Advanced commands: Agent capabilities, TileMap, Navigation, Build Pipeline, Agentic AI
 
 #include "godot_bridge.h"
+#include "core/os/os.h"
 #include "core/os/time.h"
 #include "core/io/resource_saver.h"
 #include "core/io/resource_loader.h"
@@ -14,6 +15,9 @@
 #include "scene/3d/navigation_region_3d.h"
 #include "scene/resources/sprite_frames.h"
 #include "scene/resources/atlas_texture.h"
+#include "scene/resources/image_texture.h"
+#include "core/templates/sort_array.h"
+#include "core/templates/hashfuncs.h"
 
 #include "scene/gui/code_edit.h"
 
@@ -21,6 +25,7 @@
 #include "editor/editor_interface.h"
 #include "editor/editor_data.h"
 #include "editor/editor_node.h"
+#include "editor/editor_file_system.h"
 #include "editor/export/editor_export.h"
 #include "editor/plugins/script_editor_plugin.h"
 #include "editor/filesystem_dock.h"
@@ -330,7 +335,130 @@ Dictionary GodotBridge::tileset_create_atlas(const String &p_tileset_path, const
 	return result;
 }
 
-Dictionary GodotBridge::map_set_cells_batch(const String &p_tilemap, const Array &p_cells) {
+// Packed cell layouts shared by map_set_cells_batch and map_get_cells, so
+// large maps travel as a few int columns instead of one Dictionary per cell.
+//   columns: {x, y, source, atlas_x, atlas_y, alternative} parallel int arrays;
+//            any column but x/y may be a single int applied to every cell
+//   rle:     {origin: [x, y], width, runs: [count, source, atlas_x, atlas_y, alternative, ...]}
+//            row-major from origin, wrapping every width cells; source -1 is empty
+
+// Most cells one packed batch may write, or one map_get_cells rect may cover
+static const int64_t MAX_PACKED_CELLS = 4 * 1024 * 1024;
+
+// One column of a packed batch: an int array or a scalar broadcast to every cell
+struct PackedCellColumn {
+	PackedInt32Array values;
+	int32_t scalar = 0;
+	bool is_scalar = true;
+
+	bool read(const Dictionary &p_packed, const String &p_key, int32_t p_default) {
+		Variant v = p_packed.get(p_key, p_default);
+		if (v.get_type() == Variant::INT || v.get_type() == Variant::FLOAT) {
+			scalar = int32_t(v);
+			return true;
+		}
+		if (v.get_type() != Variant::ARRAY && v.get_type() != Variant::PACKED_INT32_ARRAY && v.get_type() != Variant::PACKED_INT64_ARRAY) {
+			return false;
+		}
+		values = v;
+		is_scalar = false;
+		return true;
+	}
+
+	_FORCE_INLINE_ int32_t get(int p_index) const {
+		return is_scalar ? scalar : values[p_index];
+	}
+};
+
+static void _map_set_cell(TileMapLayer *p_layer, TileMap *p_tilemap, const Vector2i &p_coords, int p_source, const Vector2i &p_atlas, int p_alternative) {
+	if (p_layer) {
+		p_layer->set_cell(p_coords, p_source, p_atlas, p_alternative);
+	} else {
+		p_tilemap->set_cell(0, p_coords, p_source, p_atlas, p_alternative);
+	}
+}
+
+// Apply a packed batch; returns the number of cells written or -1 with r_error set
+static int _map_apply_packed(TileMapLayer *p_layer, TileMap *p_tilemap, const Dictionary &p_packed, String &r_error) {
+	String format = p_packed.get("format", p_packed.has("runs") ? "rle" : "columns");
+	int cells_set = 0;
+
+	if (format == "rle") {
+		Array origin = p_packed.get("origin", Array());
+		int width = p_packed.get("width", 0);
+		PackedInt32Array runs = p_packed.get("runs", PackedInt32Array());
+		if (width <= 0 || runs.size() % 5 != 0) {
+			r_error = "rle needs width > 0 and runs as [count, source, atlas_x, atlas_y, alternative, ...]";
+			return -1;
+		}
+		Vector2i base = origin.size() >= 2 ? Vector2i(origin[0], origin[1]) : Vector2i();
+		const int32_t *r = runs.ptr();
+
+		// Validate the whole payload before touching the map
+		int64_t total = 0;
+		for (int i = 0; i < runs.size(); i += 5) {
+			if (r[i] < 0) {
+				r_error = "rle run counts must not be negative";
+				return -1;
+			}
+			total += r[i];
+			if (total > MAX_PACKED_CELLS) {
+				r_error = "rle payload covers more than " + itos(MAX_PACKED_CELLS) + " cells";
+				return -1;
+			}
+		}
+
+		int index = 0;
+		for (int i = 0; i < runs.size(); i += 5) {
+			int count = r[i];
+			Vector2i atlas(r[i + 2], r[i + 3]);
+			for (int n = 0; n < count; n++, index++) {
+				Vector2i coords = base + Vector2i(index % width, index / width);
+				_map_set_cell(p_layer, p_tilemap, coords, r[i + 1], atlas, r[i + 4]);
+			}
+			cells_set += count;
+		}
+		return cells_set;
+	}
+
+	if (format != "columns") {
+		r_error = "Unknown packed format: " + format + " (expected columns or rle)";
+		return -1;
+	}
+
+	PackedCellColumn x, y, source, atlas_x, atlas_y, alternative;
+	if (!x.read(p_packed, "x", 0) || !y.read(p_packed, "y", 0) || x.is_scalar || y.is_scalar) {
+		r_error = "columns needs x and y int arrays";
+		return -1;
+	}
+	if (!source.read(p_packed, "source", 0) || !atlas_x.read(p_packed, "atlas_x", 0) ||
+			!atlas_y.read(p_packed, "atlas_y", 0) || !alternative.read(p_packed, "alternative", 0)) {
+		r_error = "columns must be int arrays or single ints";
+		return -1;
+	}
+
+	int count = x.values.size();
+	if (count > MAX_PACKED_CELLS) {
+		r_error = "columns payload has more than " + itos(MAX_PACKED_CELLS) + " cells";
+		return -1;
+	}
+	const PackedCellColumn *columns[] = { &y, &source, &atlas_x, &atlas_y, &alternative };
+	for (const PackedCellColumn *column : columns) {
+		if (!column->is_scalar && column->values.size() != count) {
+			r_error = "All columns must have the same length (" + itos(count) + ")";
+			return -1;
+		}
+	}
+
+	const int32_t *xs = x.values.ptr();
+	const int32_t *ys = y.values.ptr();
+	for (int i = 0; i < count; i++) {
+		_map_set_cell(p_layer, p_tilemap, Vector2i(xs[i], ys[i]), source.get(i), Vector2i(atlas_x.get(i), atlas_y.get(i)), alternative.get(i));
+	}
+	return count;
+}
+
+Dictionary GodotBridge::map_set_cells_batch(const String &p_tilemap, const Array &p_cells, const Dictionary &p_packed) {
 	Dictionary result;
 #ifdef TOOLS_ENABLED
 	Node *node = _get_node_by_path(p_tilemap);
@@ -342,36 +470,33 @@ Dictionary GodotBridge::map_set_cells_batch(const String &p_tilemap, const Array
 	
 	TileMapLayer *tilemap_layer = Object::cast_to<TileMapLayer>(node);
 	TileMap *tilemap = Object::cast_to<TileMap>(node);
+	if (!tilemap_layer && !tilemap) {
+		result["error"] = "Node is not a TileMap or TileMapLayer";
+		result["success"] = false;
+		return result;
+	}
 	
 	int cells_set = 0;
 	
-	if (tilemap_layer) {
-		for (int i = 0; i < p_cells.size(); i++) {
-			Dictionary cell = p_cells[i];
-			Vector2i coords = cell.get("coords", Vector2i());
-			int source_id = cell.get("source_id", 0);
-			Vector2i atlas_coords = cell.get("atlas_coords", Vector2i());
-			int alternative = cell.get("alternative", 0);
-			
-			tilemap_layer->set_cell(coords, source_id, atlas_coords, alternative);
-			cells_set++;
-		}
-	} else if (tilemap) {
-		int layer = 0;
-		for (int i = 0; i < p_cells.size(); i++) {
-			Dictionary cell = p_cells[i];
-			Vector2i coords = cell.get("coords", Vector2i());
-			int source_id = cell.get("source_id", 0);
-			Vector2i atlas_coords = cell.get("atlas_coords", Vector2i());
-			int alternative = cell.get("alternative", 0);
-			
-			tilemap->set_cell(layer, coords, source_id, atlas_coords, alternative);
-			cells_set++;
+	if (!p_packed.is_empty()) {
+		String error;
+		cells_set = _map_apply_packed(tilemap_layer, tilemap, p_packed, error);
+		if (cells_set < 0) {
+			result["error"] = error;
+			result["success"] = false;
+			return result;
 		}
-	} else {
-		result["error"] = "Node is not a TileMap or TileMapLayer";
-		result["success"] = false;
-		return result;
+	}
+	
+	for (int i = 0; i < p_cells.size(); i++) {
+		Dictionary cell = p_cells[i];
+		Vector2i coords = cell.get("coords", Vector2i());
+		int source_id = cell.get("source_id", 0);
+		Vector2i atlas_coords = cell.get("atlas_coords", Vector2i());
+		int alternative = cell.get("alternative", 0);
+		
+		_map_set_cell(tilemap_layer, tilemap, coords, source_id, atlas_coords, alternative);
+		cells_set++;
 	}
 	
 	result["tilemap"] = p_tilemap;
@@ -384,35 +509,137 @@ Dictionary GodotBridge::map_set_cells_batch(const String &p_tilemap, const Array
 	return result;
 }
 
-Dictionary GodotBridge::navmesh_bake(const String &p_region) {
+Dictionary GodotBridge::map_get_cells(const String &p_tilemap, const Rect2i &p_rect, const String &p_format) {
 	Dictionary result;
 #ifdef TOOLS_ENABLED
-	Node *node = _get_node_by_path(p_region);
+	Node *node = _get_node_by_path(p_tilemap);
 	if (!node) {
-		result["error"] = "NavigationRegion not found: " + p_region;
+		result["error"] = "TileMap not found: " + p_tilemap;
 		result["success"] = false;
 		return result;
 	}
 	
-	NavigationRegion3D *region_3d = Object::cast_to<NavigationRegion3D>(node);
-	NavigationRegion2D *region_2d = Object::cast_to<NavigationRegion2D>(node);
+	TileMapLayer *tilemap_layer = Object::cast_to<TileMapLayer>(node);
+	TileMap *tilemap = Object::cast_to<TileMap>(node);
+	if (!tilemap_layer && !tilemap) {
+		result["error"] = "Node is not a TileMap or TileMapLayer";
+		result["success"] = false;
+		return result;
+	}
+	if (p_format != "columns" && p_format != "rle") {
+		result["error"] = "Unknown packed format: " + p_format + " (expected columns or rle)";
+		result["success"] = false;
+		return result;
+	}
 	
-	if (region_3d) {
-		region_3d->bake_navigation_mesh(true);
-		result["region"] = p_region;
-		result["type"] = "3D";
-		result["success"] = true;
-		result["message"] = "Bake initiated. Connect to 'bake_finished' signal for completion.";
-	} else if (region_2d) {
-		region_2d->bake_navigation_polygon(true);
-		result["region"] = p_region;
-		result["type"] = "2D";
-		result["success"] = true;
-		result["message"] = "Bake initiated for 2D navigation.";
-	} else {
-		result["error"] = "Node is not a NavigationRegion2D or NavigationRegion3D";
+	// Whole used rect when no size is given
+	Rect2i rect = p_rect;
+	if (rect.size.x <= 0 || rect.size.y <= 0) {
+		rect = tilemap_layer ? tilemap_layer->get_used_rect() : tilemap->get_used_rect();
+	}
+	int64_t end_x = int64_t(rect.position.x) + rect.size.x;
+	int64_t end_y = int64_t(rect.position.y) + rect.size.y;
+	if (end_x > INT32_MAX || end_y > INT32_MAX) {
+		result["error"] = "Rect extends past the tile coordinate range";
 		result["success"] = false;
+		return result;
 	}
+	
+	PackedInt32Array xs, ys, sources, atlas_xs, atlas_ys, alternatives, runs;
+	int run_count = 0;
+	int32_t run[4] = { 0, 0, 0, 0 };
+	int used = 0;
+	
+	if (p_format == "columns") {
+		// Sparse: walk the used cells instead of the rect, in row-major order
+		TypedArray<Vector2i> used_cells = tilemap_layer ? tilemap_layer->get_used_cells() : tilemap->get_used_cells(0);
+		LocalVector<Vector2i> cells;
+		for (int i = 0; i < used_cells.size(); i++) {
+			Vector2i coords = used_cells[i];
+			if (rect.has_point(coords)) {
+				cells.push_back(coords);
+			}
+		}
+		struct RowMajor {
+			_FORCE_INLINE_ bool operator()(const Vector2i &p_a, const Vector2i &p_b) const {
+				return p_a.y != p_b.y ? p_a.y < p_b.y : p_a.x < p_b.x;
+			}
+		};
+		cells.sort_custom<RowMajor>();
+		for (const Vector2i &coords : cells) {
+			xs.push_back(coords.x);
+			ys.push_back(coords.y);
+			sources.push_back(tilemap_layer ? tilemap_layer->get_cell_source_id(coords) : tilemap->get_cell_source_id(0, coords));
+			Vector2i atlas = tilemap_layer ? tilemap_layer->get_cell_atlas_coords(coords) : tilemap->get_cell_atlas_coords(0, coords);
+			atlas_xs.push_back(atlas.x);
+			atlas_ys.push_back(atlas.y);
+			alternatives.push_back(tilemap_layer ? tilemap_layer->get_cell_alternative_tile(coords) : tilemap->get_cell_alternative_tile(0, coords));
+		}
+		used = cells.size();
+	} else if (int64_t(rect.size.x) * rect.size.y > MAX_PACKED_CELLS) {
+		result["error"] = "rle rect covers more than " + itos(MAX_PACKED_CELLS) + " cells; request a smaller region";
+		result["success"] = false;
+		return result;
+	} else {
+		// Dense: every cell of the rect, empty ones as source -1
+		for (int y = rect.position.y; y < end_y; y++) {
+			for (int x = rect.position.x; x < end_x; x++) {
+				Vector2i coords(x, y);
+				int source = tilemap_layer ? tilemap_layer->get_cell_source_id(coords) : tilemap->get_cell_source_id(0, coords);
+				Vector2i atlas(-1, -1);
+				int alternative = -1;
+				if (source != -1) {
+					atlas = tilemap_layer ? tilemap_layer->get_cell_atlas_coords(coords) : tilemap->get_cell_atlas_coords(0, coords);
+					alternative = tilemap_layer ? tilemap_layer->get_cell_alternative_tile(coords) : tilemap->get_cell_alternative_tile(0, coords);
+					used++;
+				}
+				
+				int32_t cell[4] = { source, atlas.x, atlas.y, alternative };
+				if (run_count > 0 && cell[0] == run[0] && cell[1] == run[1] && cell[2] == run[2] && cell[3] == run[3]) {
+					run_count++;
+					continue;
+				}
+				if (run_count > 0) {
+					runs.push_back(run_count);
+					for (int32_t value : run) {
+						runs.push_back(value);
+					}
+				}
+				for (int i = 0; i < 4; i++) {
+					run[i] = cell[i];
+				}
+				run_count = 1;
+			}
+		}
+	}
+	
+	result["format"] = p_format;
+	if (p_format == "columns") {
+		result["x"] = xs;
+		result["y"] = ys;
+		result["source"] = sources;
+		result["atlas_x"] = atlas_xs;
+		result["atlas_y"] = atlas_ys;
+		result["alternative"] = alternatives;
+	} else {
+		if (run_count > 0) {
+			runs.push_back(run_count);
+			for (int32_t value : run) {
+				runs.push_back(value);
+			}
+		}
+		Array origin;
+		origin.push_back(rect.position.x);
+		origin.push_back(rect.position.y);
+		result["origin"] = origin;
+		result["width"] = rect.size.x;
+		result["height"] = rect.size.y;
+		result["runs"] = runs;
+	}
+	result["rect"] = rect;
+	result["used_cells"] = used;
+	result["tilemap"] = p_tilemap;
+	result["success"] = true;
 #else
 	result["error"] = "Editor tools not available";
 	result["success"] = false;
@@ -504,6 +731,244 @@ Dictionary GodotBridge::map_fill_rect(const String &p_tilemap, int p_start_x, in
 	return result;
 }
 
+// ============ Navigation Baking ============
+// navmesh_bake returns a job id immediately. Geometry is parsed on the main
+// thread and the bake itself runs on the navigation server's worker threads,
+// so several regions can bake at once. Running jobs report
+// navmesh_bake_progress a few times per second and navmesh_bake_done when the
+// region's bake_finished signal fires. The server reports no completion
+// fraction, so progress events are elapsed-time heartbeats. A bake the server
+// refused, or one that stopped without bake_finished, is dropped with an
+// error. The server can't abort a bake midway, so cancelling restores the
+// pre-bake resource once the bake completes.
+
+static bool _nav_region_is_baking(Object *p_region) {
+	if (NavigationRegion3D *region_3d = Object::cast_to<NavigationRegion3D>(p_region)) {
+		return region_3d->is_baking();
+	}
+	if (NavigationRegion2D *region_2d = Object::cast_to<NavigationRegion2D>(p_region)) {
+		return region_2d->is_baking();
+	}
+	return false;
+}
+
+Dictionary GodotBridge::_nav_bake_info(const String &p_job_id, const NavBakeJob &p_job, uint64_t p_now_msec) {
+	Dictionary info;
+	info["job_id"] = p_job_id;
+	info["region"] = p_job.region_path;
+	info["type"] = p_job.is_3d ? "3D" : "2D";
+	info["elapsed_msec"] = p_now_msec - p_job.started_msec;
+	info["cancelled"] = p_job.cancelled;
+	return info;
+}
+
+Dictionary GodotBridge::navmesh_bake(const String &p_region) {
+	Dictionary result;
+#ifdef TOOLS_ENABLED
+	Node *node = _get_node_by_path(p_region);
+	if (!node) {
+		result["error"] = "NavigationRegion not found: " + p_region;
+		result["success"] = false;
+		return result;
+	}
+	
+	NavigationRegion3D *region_3d = Object::cast_to<NavigationRegion3D>(node);
+	NavigationRegion2D *region_2d = Object::cast_to<NavigationRegion2D>(node);
+	if (!region_3d && !region_2d) {
+		result["error"] = "Node is not a NavigationRegion2D or NavigationRegion3D";
+		result["success"] = false;
+		return result;
+	}
+	
+	for (const KeyValue<String, NavBakeJob> &kv : nav_bake_jobs) {
+		if (kv.value.region == node->get_instance_id()) {
+			result["error"] = "Region is already baking";
+			result["job_id"] = kv.key;
+			result["success"] = false;
+			return result;
+		}
+	}
+	if (_nav_region_is_baking(node)) {
+		result["error"] = "Region is already baking (started outside the bridge)";
+		result["success"] = false;
+		return result;
+	}
+	
+	NavBakeJob job;
+	job.region = node->get_instance_id();
+	job.region_path = p_region;
+	job.is_3d = region_3d != nullptr;
+	job.started_msec = OS::get_singleton()->get_ticks_msec();
+	Ref<Resource> navigation = region_3d ? Ref<Resource>(region_3d->get_navigation_mesh()) : Ref<Resource>(region_2d->get_navigation_polygon());
+	if (navigation.is_null()) {
+		result["error"] = String(region_3d ? "NavigationRegion3D has no NavigationMesh" : "NavigationRegion2D has no NavigationPolygon");
+		result["success"] = false;
+		return result;
+	}
+	job.backup = navigation->duplicate();
+	
+	String job_id = "nav" + itos(next_nav_bake_id++);
+	nav_bake_jobs.insert(job_id, job);
+	node->connect("bake_finished", callable_mp(this, &GodotBridge::_on_nav_bake_finished).bind(job_id), CONNECT_ONE_SHOT);
+	if (region_3d) {
+		region_3d->bake_navigation_mesh(true);
+	} else {
+		region_2d->bake_navigation_polygon(true);
+	}
+	
+	// Refused bakes (no source geometry, server busy) never emit bake_finished
+	if (nav_bake_jobs.has(job_id) && !_nav_region_is_baking(node)) {
+		Callable finished = callable_mp(this, &GodotBridge::_on_nav_bake_finished).bind(job_id);
+		if (node->is_connected("bake_finished", finished)) {
+			node->disconnect("bake_finished", finished);
+		}
+		nav_bake_jobs.erase(job_id);
+		result["error"] = "Navigation server did not start the bake (see the editor log)";
+		result["success"] = false;
+		return result;
+	}
+	
+	result["job_id"] = job_id;
+	result["region"] = p_region;
+	result["type"] = job.is_3d ? "3D" : "2D";
+	result["success"] = true;
+	result["message"] = "Bake started. Watch navmesh_bake_progress / navmesh_bake_done events.";
+#else
+	result["error"] = "Editor tools not available";
+	result["success"] = false;
+#endif
+	return result;
+}
+
+void GodotBridge::_on_nav_bake_finished(const String &p_job_id) {
+	NavBakeJob *job = nav_bake_jobs.getptr(p_job_id);
+	if (!job) {
+		return;
+	}
+	
+	uint64_t now = OS::get_singleton()->get_ticks_msec();
+	Dictionary info = _nav_bake_info(p_job_id, *job, now);
+	Object *region = ObjectDB::get_instance(job->region);
+	NavigationRegion3D *region_3d = Object::cast_to<NavigationRegion3D>(region);
+	NavigationRegion2D *region_2d = Object::cast_to<NavigationRegion2D>(region);
+	
+	if (job->cancelled) {
+		// Put back what the region had before the bake
+		Ref<Resource> navigation = region_3d ? Ref<Resource>(region_3d->get_navigation_mesh()) : region_2d ? Ref<Resource>(region_2d->get_navigation_polygon()) : Ref<Resource>();
+		if (navigation.is_valid() && job->backup.is_valid()) {
+			navigation->copy_from(job->backup);
+			navigation->emit_changed();
+		}
+	} else if (region_3d && region_3d->get_navigation_mesh().is_valid()) {
+		info["polygon_count"] = region_3d->get_navigation_mesh()->get_polygon_count();
+		info["vertex_count"] = region_3d->get_navigation_mesh()->get_vertices().size();
+	} else if (region_2d && region_2d->get_navigation_polygon().is_valid()) {
+		info["polygon_count"] = region_2d->get_navigation_polygon()->get_polygon_count();
+		info["vertex_count"] = region_2d->get_navigation_polygon()->get_vertices().size();
+	}
+	info["success"] = !job->cancelled;
+	
+	nav_bake_jobs.erase(p_job_id);
+	broadcast_event("navmesh_bake_done", info);
+	BRIDGE_LOG_VERBOSE("GodotBridge: Navigation bake " + p_job_id + " finished in " + itos(info["elapsed_msec"]) + " ms");
+}
+
+void GodotBridge::_drop_nav_bake(const String &p_job_id, const String &p_error, uint64_t p_now_msec) {
+	Dictionary info = _nav_bake_info(p_job_id, nav_bake_jobs[p_job_id], p_now_msec);
+	info["success"] = false;
+	info["error"] = p_error;
+	Object *region = ObjectDB::get_instance(nav_bake_jobs[p_job_id].region);
+	Callable finished = callable_mp(this, &GodotBridge::_on_nav_bake_finished).bind(p_job_id);
+	if (region && region->is_connected("bake_finished", finished)) {
+		region->disconnect("bake_finished", finished);
+	}
+	nav_bake_jobs.erase(p_job_id);
+	broadcast_event("navmesh_bake_done", info);
+}
+
+// Progress heartbeat, and cleanup for regions freed while baking or bakes
+// that ended without bake_finished
+void GodotBridge::_pump_nav_bakes() {
+	if (nav_bake_jobs.is_empty()) {
+		return;
+	}
+	uint64_t now = OS::get_singleton()->get_ticks_msec();
+	if (now - last_nav_bake_progress_msec < NAV_BAKE_PROGRESS_INTERVAL_MSEC) {
+		return;
+	}
+	last_nav_bake_progress_msec = now;
+	
+	LocalVector<String> gone;
+	LocalVector<String> stalled;
+	for (KeyValue<String, NavBakeJob> &kv : nav_bake_jobs) {
+		Object *region = ObjectDB::get_instance(kv.value.region);
+		if (!region) {
+			gone.push_back(kv.key);
+			continue;
+		}
+		// bake_finished is emitted deferred, so allow a grace period once idle
+		if (_nav_region_is_baking(region)) {
+			kv.value.idle_since_msec = 0;
+		} else if (kv.value.idle_since_msec == 0) {
+			kv.value.idle_since_msec = now;
+		} else if (now - kv.value.idle_since_msec > NAV_BAKE_IDLE_TIMEOUT_MSEC) {
+			stalled.push_back(kv.key);
+			continue;
+		}
+		if (_has_event_subscribers("navmesh_bake_progress")) {
+			Dictionary info = _nav_bake_info(kv.key, kv.value, now);
+			info["status"] = "baking";
+			broadcast_event("navmesh_bake_progress", info);
+		}
+	}
+	for (const String &job_id : gone) {
+		_drop_nav_bake(job_id, "Region was freed during the bake", now);
+	}
+	for (const String &job_id : stalled) {
+		_drop_nav_bake(job_id, "Bake ended without bake_finished (see the editor log)", now);
+	}
+}
+
+Dictionary GodotBridge::navmesh_bake_cancel(const String &p_job_id) {
+	Dictionary result;
+	NavBakeJob *job = nav_bake_jobs.getptr(p_job_id);
+	if (!job) {
+		result["error"] = "No running bake: " + p_job_id;
+		result["success"] = false;
+		return result;
+	}
+	job->cancelled = true;
+	result["job_id"] = p_job_id;
+	result["message"] = "Bake will be discarded when the navigation server finishes it";
+	result["success"] = true;
+	return result;
+}
+
+Dictionary GodotBridge::navmesh_bake_status(const String &p_job_id) {
+	Dictionary result;
+	uint64_t now = OS::get_singleton()->get_ticks_msec();
+	if (!p_job_id.is_empty()) {
+		const NavBakeJob *job = nav_bake_jobs.getptr(p_job_id);
+		if (!job) {
+			result["error"] = "No running bake: " + p_job_id;
+			result["success"] = false;
+			return result;
+		}
+		result = _nav_bake_info(p_job_id, *job, now);
+		result["success"] = true;
+		return result;
+	}
+	
+	Array jobs;
+	for (const KeyValue<String, NavBakeJob> &kv : nav_bake_jobs) {
+		jobs.push_back(_nav_bake_info(kv.key, kv.value, now));
+	}
+	result["jobs"] = jobs;
+	result["count"] = jobs.size();
+	result["success"] = true;
+	return result;
+}
+
 
 // ============ Phase 14: Build Pipeline ============
 
@@ -646,17 +1111,28 @@ Dictionary GodotBridge::clear_diff_entries() {
 	return result;
 }
 
-Dictionary GodotBridge::capture_viewport(const String &p_save_path, const String &p_viewport) {
-	Dictionary result;
+// ============ Viewport Capture ============
+
+GodotBridge::CaptureSettings GodotBridge::_read_capture_settings(const Dictionary &p_options) const {
+	CaptureSettings settings;
+	settings.max_size = MAX(0, int(p_options.get("max_size", 0)));
+	settings.format = String(p_options.get("format", "png")).to_lower();
+	if (settings.format == "jpeg") {
+		settings.format = "jpg";
+	}
+	settings.quality = CLAMP(float(p_options.get("quality", 0.8)), 0.0f, 1.0f);
+	settings.binary = _current_client_accepts_binary();
+	return settings;
+}
+
+Viewport *GodotBridge::_get_capture_viewport(const String &p_viewport, String &r_error) {
 #ifdef TOOLS_ENABLED
 	EditorInterface *editor = EditorInterface::get_singleton();
 	if (!editor) {
-		result["error"] = "EditorInterface not available";
-		result["success"] = false;
-		return result;
+		r_error = "EditorInterface not available";
+		return nullptr;
 	}
 	
-	// Get the appropriate viewport
 	Viewport *viewport = nullptr;
 	if (p_viewport == "editor") {
 		viewport = editor->get_editor_viewport_2d();
@@ -664,14 +1140,118 @@ Dictionary GodotBridge::capture_viewport(const String &p_save_path, const String
 		// Get the game preview viewport if available
 		viewport = editor->get_edited_scene_root() ? editor->get_edited_scene_root()->get_viewport() : nullptr;
 	}
+	if (!viewport) {
+		r_error = "Could not get viewport: " + p_viewport;
+	}
+	return viewport;
+#else
+	r_error = "Editor tools not available";
+	return nullptr;
+#endif
+}
+
+// Runs on a worker thread for async captures and streams. Only touches the
+// task, which owns its copy of the image.
+void GodotBridge::_encode_capture(CaptureTask *p_task) {
+	Ref<Image> img = p_task->image;
+	p_task->source_width = img->get_width();
+	p_task->source_height = img->get_height();
+	
+	const CaptureSettings &settings = p_task->settings;
+	int longest = MAX(img->get_width(), img->get_height());
+	if (settings.max_size > 0 && longest > settings.max_size) {
+		float scale = float(settings.max_size) / float(longest);
+		img->resize(MAX(1, int(img->get_width() * scale)), MAX(1, int(img->get_height() * scale)), Image::INTERPOLATE_BILINEAR);
+	}
+	p_task->width = img->get_width();
+	p_task->height = img->get_height();
+	
+	// Hash after resizing, so noise below the output resolution counts as unchanged
+	const Vector<uint8_t> pixels = img->get_data();
+	p_task->hash = hash_murmur3_buffer(pixels.ptr(), pixels.size());
+	if (p_task->stream_id != 0 && p_task->hash == p_task->previous_hash) {
+		p_task->unchanged = true;
+		p_task->image.unref();
+		return;
+	}
 	
+	if (!p_task->save_path.is_empty()) {
+		Error err;
+		if (settings.format == "jpg") {
+			err = img->save_jpg(p_task->save_path, settings.quality);
+		} else if (settings.format == "webp") {
+			err = img->save_webp(p_task->save_path, true, settings.quality);
+		} else {
+			err = img->save_png(p_task->save_path);
+		}
+		if (err != OK) {
+			p_task->error = "Failed to save image: " + itos(err);
+		}
+	} else {
+		if (settings.format == "jpg") {
+			p_task->data = img->save_jpg_to_buffer(settings.quality);
+		} else if (settings.format == "webp") {
+			p_task->data = img->save_webp_to_buffer(true, settings.quality);
+		} else {
+			p_task->data = img->save_png_to_buffer();
+		}
+		if (p_task->data.is_empty()) {
+			p_task->error = "Failed to encode image to " + settings.format;
+		} else if (!settings.binary) {
+			p_task->base64 = CryptoCore::b64_encode_str(p_task->data.ptr(), p_task->data.size());
+			p_task->data.clear();
+		}
+	}
+	p_task->image.unref();
+}
+
+void GodotBridge::_encode_capture_task(void *p_task) {
+	_encode_capture(static_cast<CaptureTask *>(p_task));
+}
+
+void GodotBridge::_capture_result(const CaptureTask *p_task, Dictionary &r_result) {
+	if (!p_task->error.is_empty()) {
+		r_result["error"] = p_task->error;
+		r_result["success"] = false;
+		return;
+	}
+	const CaptureSettings &settings = p_task->settings;
+	r_result["viewport"] = p_task->viewport;
+	r_result["format"] = settings.format;
+	r_result["width"] = p_task->width;
+	r_result["height"] = p_task->height;
+	r_result["source_width"] = p_task->source_width;
+	r_result["source_height"] = p_task->source_height;
+	r_result["hash"] = int64_t(p_task->hash);
+	if (!p_task->save_path.is_empty()) {
+		r_result["save_path"] = p_task->save_path;
+	} else if (settings.binary) {
+		// Binary clients get the bytes as-is instead of base64 (image_png for PNG)
+		r_result["image_" + settings.format] = p_task->data;
+	} else {
+		r_result["image_base64"] = p_task->base64;
+	}
+	r_result["success"] = true;
+}
+
+Dictionary GodotBridge::capture_viewport(const String &p_save_path, const String &p_viewport, const Dictionary &p_options) {
+	Dictionary result;
+	String error;
+	Viewport *viewport = _get_capture_viewport(p_viewport, error);
 	if (!viewport) {
-		result["error"] = "Could not get viewport: " + p_viewport;
+		result["error"] = error;
 		result["success"] = false;
 		return result;
 	}
 	
-	// Capture the viewport texture
+	CaptureSettings settings = _read_capture_settings(p_options);
+	if (settings.format != "png" && settings.format != "jpg" && settings.format != "webp") {
+		result["error"] = "Unknown format: " + settings.format + " (png, jpg or webp)";
+		result["success"] = false;
+		return result;
+	}
+	
+	// The GPU readback has to happen here; scaling and encoding don't
 	Ref<Image> img = viewport->get_texture()->get_image();
 	if (!img.is_valid()) {
 		result["error"] = "Failed to capture viewport image";
@@ -679,40 +1259,171 @@ Dictionary GodotBridge::capture_viewport(const String &p_save_path, const String
 		return result;
 	}
 	
-	// Check if we should return base64 or save to file
-	if (p_save_path.is_empty() || p_save_path == "base64") {
-		// Return base64-encoded PNG data for AI vision
-		Vector<uint8_t> png_data = img->save_png_to_buffer();
-		if (png_data.size() > 0) {
-			result["image_base64"] = CryptoCore::b64_encode_str(png_data.ptr(), png_data.size());
-			result["viewport"] = p_viewport;
-			result["width"] = img->get_width();
-			result["height"] = img->get_height();
-			result["success"] = true;
-			print_line("[GodotBridge] Captured viewport as base64 (" + itos(png_data.size()) + " bytes)");
-		} else {
-			result["error"] = "Failed to encode image to PNG";
-			result["success"] = false;
+	CaptureTask *task = memnew(CaptureTask);
+	task->viewport = p_viewport;
+	task->save_path = p_save_path == "base64" ? String() : p_save_path;
+	task->settings = settings;
+	task->image = img;
+	
+	if (bool(p_options.get("async", false)) && current_client >= 0 && current_client < clients.size()) {
+		task->client_id = clients[current_client].id;
+		task->capture_id = next_capture_id++;
+		task->task_id = WorkerThreadPool::get_singleton()->add_native_task(&GodotBridge::_encode_capture_task, task, false, "GodotBridge capture");
+		capture_tasks.push_back(task);
+		result["capture_id"] = task->capture_id;
+		result["message"] = "Result arrives as a viewport_capture event";
+		result["success"] = true;
+		return result;
+	}
+	
+	_encode_capture(task);
+	_capture_result(task, result);
+	memdelete(task);
+	return result;
+}
+
+Dictionary GodotBridge::capture_stream_start(const String &p_viewport, float p_fps, const Dictionary &p_options) {
+	Dictionary result;
+	String error;
+	if (!_get_capture_viewport(p_viewport, error)) {
+		result["error"] = error;
+		result["success"] = false;
+		return result;
+	}
+	if (current_client < 0 || current_client >= clients.size()) {
+		result["error"] = "Capture streams need a connected client";
+		result["success"] = false;
+		return result;
+	}
+	
+	CaptureStream stream;
+	stream.client_id = clients[current_client].id;
+	stream.viewport = p_viewport;
+	stream.settings = _read_capture_settings(p_options);
+	if (stream.settings.format != "png" && stream.settings.format != "jpg" && stream.settings.format != "webp") {
+		result["error"] = "Unknown format: " + stream.settings.format + " (png, jpg or webp)";
+		result["success"] = false;
+		return result;
+	}
+	float fps = CLAMP(p_fps, 0.1f, 60.0f);
+	stream.interval_usec = uint64_t(1000000.0 / fps);
+	stream.next_capture_usec = OS::get_singleton()->get_ticks_usec();
+	
+	uint32_t stream_id = next_capture_id++;
+	capture_streams.insert(stream_id, stream);
+	
+	result["stream_id"] = stream_id;
+	result["fps"] = fps;
+	result["success"] = true;
+	return result;
+}
+
+Dictionary GodotBridge::capture_stream_stop(int p_stream_id) {
+	Dictionary result;
+	const CaptureStream *stream = capture_streams.getptr(uint32_t(p_stream_id));
+	if (!stream) {
+		result["error"] = "No capture stream: " + itos(p_stream_id);
+		result["success"] = false;
+		return result;
+	}
+	result["stream_id"] = p_stream_id;
+	result["frames_sent"] = stream->frames_sent;
+	result["frames_unchanged"] = stream->frames_unchanged;
+	result["frames_skipped"] = stream->frames_skipped;
+	// A frame still encoding finds no stream and is dropped
+	capture_streams.erase(uint32_t(p_stream_id));
+	result["success"] = true;
+	return result;
+}
+
+void GodotBridge::_pump_captures() {
+	// Deliver finished encodes
+	for (uint32_t i = 0; i < capture_tasks.size();) {
+		CaptureTask *task = capture_tasks[i];
+		if (!WorkerThreadPool::get_singleton()->is_task_completed(task->task_id)) {
+			i++;
+			continue;
 		}
-	} else {
-		// Save the image to file (original behavior)
-		Error err = img->save_png(p_save_path);
-		if (err == OK) {
-			result["save_path"] = p_save_path;
-			result["viewport"] = p_viewport;
-			result["width"] = img->get_width();
-			result["height"] = img->get_height();
-			result["success"] = true;
-		} else {
-			result["error"] = "Failed to save image: " + itos(err);
-			result["success"] = false;
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(task->task_id);
+		capture_tasks.remove_at_unordered(i);
+		
+		int client = _find_client(task->client_id);
+		if (task->stream_id == 0) {
+			Dictionary data;
+			_capture_result(task, data);
+			data["capture_id"] = task->capture_id;
+			send_event(client, "viewport_capture", data);
+		} else if (CaptureStream *stream = capture_streams.getptr(task->stream_id)) {
+			stream->encoding = false;
+			if (task->unchanged) {
+				stream->frames_unchanged++;
+			} else if (task->error.is_empty()) {
+				stream->last_hash = task->hash;
+				stream->frames_sent++;
+				Dictionary data;
+				_capture_result(task, data);
+				data["stream_id"] = task->stream_id;
+				data["seq"] = stream->seq++;
+				send_event(client, "viewport_frame", data);
+			}
 		}
+		memdelete(task);
+	}
+	
+	if (capture_streams.is_empty()) {
+		return;
+	}
+	
+	// Start due stream frames
+	uint64_t now = OS::get_singleton()->get_ticks_usec();
+	LocalVector<uint32_t> ended;
+	for (KeyValue<uint32_t, CaptureStream> &kv : capture_streams) {
+		CaptureStream &stream = kv.value;
+		if (_find_client(stream.client_id) < 0) {
+			ended.push_back(kv.key);
+			continue;
+		}
+		if (now < stream.next_capture_usec) {
+			continue;
+		}
+		// Drop frames rather than letting a slow encoder fall behind
+		stream.next_capture_usec = MAX(stream.next_capture_usec + stream.interval_usec, now);
+		if (stream.encoding) {
+			stream.frames_skipped++;
+			continue;
+		}
+		
+		String error;
+		Viewport *viewport = _get_capture_viewport(stream.viewport, error);
+		Ref<Image> img = viewport ? viewport->get_texture()->get_image() : Ref<Image>();
+		if (!img.is_valid()) {
+			stream.frames_skipped++;
+			continue;
+		}
+		
+		CaptureTask *task = memnew(CaptureTask);
+		task->client_id = stream.client_id;
+		task->stream_id = kv.key;
+		task->viewport = stream.viewport;
+		task->settings = stream.settings;
+		task->image = img;
+		task->previous_hash = stream.last_hash;
+		task->task_id = WorkerThreadPool::get_singleton()->add_native_task(&GodotBridge::_encode_capture_task, task, false, "GodotBridge capture");
+		capture_tasks.push_back(task);
+		stream.encoding = true;
+	}
+	for (uint32_t stream_id : ended) {
+		capture_streams.erase(stream_id);
 	}
-#else
-	result["error"] = "Editor tools not available";
-	result["success"] = false;
-#endif
-	return result;
+}
+
+void GodotBridge::_cancel_captures() {
+	for (CaptureTask *task : capture_tasks) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(task->task_id);
+		memdelete(task);
+	}
+	capture_tasks.clear();
+	capture_streams.clear();
 }
 
 Dictionary GodotBridge::get_runtime_state(const String &p_node_path, const Array &p_properties) {
@@ -808,7 +1519,72 @@ Dictionary GodotBridge::create_sprite_frames(const String &p_path, const String
 // ============ Phase 16: Individual Frame Animation & SpriteMancer UI Control ============
 
 // Create SpriteFrames from individual frame images (preserves transparency)
-Dictionary GodotBridge::create_sprite_frames_from_images(const String &p_path, const Array &p_animations) {
+// Frame atlas packing for create_sprite_frames_from_images. Frames are
+// trimmed to their opaque rect and shelf-packed (tallest first) into as few
+// atlases as fit p_max_size; AtlasTexture margins restore the trimmed border
+// so every frame keeps its original size and pivot.
+struct AtlasFrame {
+	String path;
+	Ref<Image> image;
+	Rect2i used;        // Opaque rect inside the original image
+	int atlas = -1;     // -1: too large to pack, the original texture is used
+	Point2i position;
+};
+
+static void _pack_atlas_frames(LocalVector<AtlasFrame> &r_frames, int p_padding, int p_max_size, LocalVector<Size2i> &r_atlas_sizes) {
+	LocalVector<int> order;
+	int64_t area = 0;
+	int widest = 1;
+	for (uint32_t i = 0; i < r_frames.size(); i++) {
+		const Size2i size = r_frames[i].used.size + Size2i(p_padding, p_padding);
+		if (size.x + p_padding > p_max_size || size.y + p_padding > p_max_size) {
+			continue;
+		}
+		order.push_back(i);
+		area += int64_t(size.x) * size.y;
+		widest = MAX(widest, size.x + p_padding);
+	}
+
+	struct TallerFirst {
+		const LocalVector<AtlasFrame> *frames;
+		bool operator()(int p_a, int p_b) const {
+			return (*frames)[p_a].used.size.y > (*frames)[p_b].used.size.y;
+		}
+	};
+	SortArray<int, TallerFirst> sorter;
+	sorter.compare.frames = &r_frames;
+	sorter.sort(order.ptr(), order.size());
+
+	// Roughly square atlases, power-of-two wide
+	int width = CLAMP(int(next_power_of_2(uint32_t(Math::ceil(Math::sqrt(double(area)))))), widest, p_max_size);
+	int atlas = -1;
+	Point2i cursor;
+	int shelf_height = 0;
+	for (int index : order) {
+		AtlasFrame &frame = r_frames[index];
+		Size2i size = frame.used.size;
+		if (atlas == -1 || cursor.x + size.x + p_padding > width) {
+			// Next shelf, or next atlas when this one is full
+			cursor = Point2i(p_padding, atlas == -1 ? p_padding : cursor.y + shelf_height + p_padding);
+			shelf_height = 0;
+			if (atlas == -1 || cursor.y + size.y + p_padding > p_max_size) {
+				atlas++;
+				r_atlas_sizes.push_back(Size2i(width, 0));
+				cursor = Point2i(p_padding, p_padding);
+			}
+		}
+		frame.atlas = atlas;
+		frame.position = cursor;
+		cursor.x += size.x + p_padding;
+		shelf_height = MAX(shelf_height, size.y);
+		r_atlas_sizes[atlas].y = MAX(r_atlas_sizes[atlas].y, frame.position.y + size.y + p_padding);
+	}
+}
+
+// With options.pack_atlas the frames are packed into shared atlas PNGs next to
+// p_path ({padding: 2, trim: true, max_atlas_size: 2048}); otherwise every frame
+// references its own texture as before. Frames load in parallel either way.
+Dictionary GodotBridge::create_sprite_frames_from_images(const String &p_path, const Array &p_animations, const Dictionary &p_options) {
 	Dictionary result;
 	
 	if (p_path.is_empty()) {
@@ -817,6 +1593,118 @@ Dictionary GodotBridge::create_sprite_frames_from_images(const String &p_path, c
 		return result;
 	}
 	
+	bool pack_atlas = p_options.get("pack_atlas", false);
+	int padding = CLAMP(int(p_options.get("padding", 2)), 0, 64);
+	bool trim = p_options.get("trim", true);
+	int max_atlas_size = CLAMP(int(p_options.get("max_atlas_size", 2048)), 64, 16384);
+	uint64_t load_start = OS::get_singleton()->get_ticks_msec();
+	
+	// Queue every distinct frame on the threaded loader first, then collect
+	HashMap<String, Ref<Texture2D>> textures;
+	LocalVector<String> frame_order;
+	HashSet<String> threaded;
+	for (int a = 0; a < p_animations.size(); a++) {
+		Dictionary anim = p_animations[a];
+		Array frame_paths = anim.get("frames", Array());  // Array of individual image paths
+		for (int f = 0; f < frame_paths.size(); f++) {
+			String frame_path = frame_paths[f];
+			if (textures.has(frame_path)) {
+				continue;
+			}
+			textures.insert(frame_path, Ref<Texture2D>());
+			frame_order.push_back(frame_path);
+			if (ResourceLoader::load_threaded_request(frame_path, "Texture2D") == OK) {
+				threaded.insert(frame_path);
+			}
+		}
+	}
+	for (const String &frame_path : frame_order) {
+		Ref<Texture2D> texture = threaded.has(frame_path) ? ResourceLoader::load_threaded_get(frame_path) : ResourceLoader::load(frame_path);
+		if (texture.is_valid()) {
+			textures[frame_path] = texture;
+		} else {
+			print_line("Warning: Could not load frame: " + frame_path);
+		}
+	}
+	result["load_msec"] = OS::get_singleton()->get_ticks_msec() - load_start;
+	
+	// Optional atlas packing: each distinct image is packed once
+	HashMap<String, Ref<Texture2D>> frame_textures = textures;
+	if (pack_atlas) {
+		LocalVector<AtlasFrame> frames;
+		for (const String &frame_path : frame_order) {
+			Ref<Texture2D> texture = textures[frame_path];
+			Ref<Image> image = texture.is_valid() ? texture->get_image() : Ref<Image>();
+			if (image.is_null() || image->is_empty()) {
+				continue;
+			}
+			if (image->is_compressed()) {
+				image->decompress();
+			}
+			image->convert(Image::FORMAT_RGBA8);
+			AtlasFrame frame;
+			frame.path = frame_path;
+			frame.image = image;
+			frame.used = trim ? image->get_used_rect() : Rect2i(Point2i(), image->get_size());
+			if (frame.used.size.x <= 0 || frame.used.size.y <= 0) {
+				frame.used = Rect2i(0, 0, 1, 1);  // Fully transparent frame
+			}
+			frames.push_back(frame);
+		}
+		
+		LocalVector<Size2i> atlas_sizes;
+		_pack_atlas_frames(frames, padding, max_atlas_size, atlas_sizes);
+		
+		Array atlas_paths;
+		LocalVector<Ref<Texture2D>> atlas_textures;
+		for (uint32_t i = 0; i < atlas_sizes.size(); i++) {
+			Ref<Image> atlas = Image::create_empty(atlas_sizes[i].x, atlas_sizes[i].y, false, Image::FORMAT_RGBA8);
+			for (const AtlasFrame &frame : frames) {
+				if (frame.atlas == int(i)) {
+					atlas->blit_rect(frame.image, frame.used, frame.position);
+				}
+			}
+			String atlas_path = p_path.get_basename() + (atlas_sizes.size() > 1 ? "_atlas_" + itos(i) : String("_atlas")) + ".png";
+			Ref<Texture2D> atlas_texture;
+			if (atlas->save_png(atlas_path) == OK) {
+#ifdef TOOLS_ENABLED
+				// Import now so the SpriteFrames can reference the imported texture
+				EditorFileSystem *efs = EditorFileSystem::get_singleton();
+				if (efs) {
+					efs->update_file(atlas_path);
+					Vector<String> files;
+					files.push_back(atlas_path);
+					efs->reimport_files(files);
+				}
+#endif
+				atlas_texture = ResourceLoader::load(atlas_path, "Texture2D", ResourceFormatLoader::CACHE_MODE_REPLACE);
+				atlas_paths.push_back(atlas_path);
+			}
+			if (atlas_texture.is_null()) {
+				atlas_texture = ImageTexture::create_from_image(atlas);  // Embedded in the .tres
+			}
+			atlas_textures.push_back(atlas_texture);
+		}
+		
+		int packed_frames = 0;
+		for (const AtlasFrame &frame : frames) {
+			if (frame.atlas == -1) {
+				continue;
+			}
+			Ref<AtlasTexture> region;
+			region.instantiate();
+			region->set_atlas(atlas_textures[frame.atlas]);
+			region->set_region(Rect2(frame.position, frame.used.size));
+			region->set_margin(Rect2(frame.used.position, frame.image->get_size() - frame.used.size));
+			region->set_filter_clip(true);
+			frame_textures[frame.path] = region;
+			packed_frames++;
+		}
+		result["atlas_count"] = atlas_sizes.size();
+		result["atlas_paths"] = atlas_paths;
+		result["packed_frames"] = packed_frames;
+	}
+	
 	Ref<SpriteFrames> sprite_frames;
 	sprite_frames.instantiate();
 	
@@ -828,7 +1716,7 @@ Dictionary GodotBridge::create_sprite_frames_from_images(const String &p_path, c
 		String anim_name = anim.get("name", "default");
 		int fps = anim.get("fps", 12);
 		bool loop = anim.get("loop", true);
-		Array frame_paths = anim.get("frames", Array());  // Array of individual image paths
+		Array frame_paths = anim.get("frames", Array());
 		
 		// Add animation
 		if (anim_name != "default") {
@@ -837,18 +1725,12 @@ Dictionary GodotBridge::create_sprite_frames_from_images(const String &p_path, c
 		sprite_frames->set_animation_speed(anim_name, fps);
 		sprite_frames->set_animation_loop(anim_name, loop);
 		
-		// Add each frame as individual texture
 		for (int f = 0; f < frame_paths.size(); f++) {
-			String frame_path = frame_paths[f];
 			total_frames++;
-			
-			Ref<Texture2D> texture = ResourceLoader::load(frame_path);
-			
-			if (texture.is_valid()) {
-				sprite_frames->add_frame(anim_name, texture);
+			const Ref<Texture2D> *texture = frame_textures.getptr(String(frame_paths[f]));
+			if (texture && texture->is_valid()) {
+				sprite_frames->add_frame(anim_name, *texture);
 				loaded_frames++;
-			} else {
-				print_line("Warning: Could not load frame: " + frame_path);
 			}
 		}
 	}
@@ -860,6 +1742,7 @@ Dictionary GodotBridge::create_sprite_frames_from_images(const String &p_path, c
 		result["animation_count"] = p_animations.size();
 		result["total_frames"] = total_frames;
 		result["loaded_frames"] = loaded_frames;
+		result["unique_images"] = frame_order.size();
 		result["success"] = true;
 		print_line("[GodotBridge] Created SpriteFrames with " + itos(loaded_frames) + " frames at: " + p_path);
 	} else {
@@ -949,45 +1832,175 @@ Dictionary GodotBridge::spritemancer_open_project(const String &p_project_id) {
 	return result;
 }
 
-// Execute JavaScript in embedded SpriteMancer editor
-Dictionary GodotBridge::spritemancer_execute_js(const String &p_code) {
-	Dictionary result;
-	
+// Find the embedded SpriteMancer editor's GDBrowserView
+Object *GodotBridge::_get_spritemancer_browser(String &r_error) {
 #ifdef TOOLS_ENABLED
 	EditorInterface *ei = EditorInterface::get_singleton();
 	if (!ei) {
-		result["error"] = "Editor interface not available";
-		result["success"] = false;
-		return result;
+		r_error = "Editor interface not available";
+		return nullptr;
 	}
 	
 	Node *editor_main = ei->get_base_control();
-	if (editor_main) {
-		Node *spritemancer = editor_main->find_child("SpriteMancerMainScreen", true, false);
-		if (spritemancer) {
-			// Get the CEF browser from SpriteMancer and execute JS
-			Object *cef_browser = spritemancer->get("cef_browser");
-			if (cef_browser) {
-				cef_browser->call("execute_javascript", p_code);
-				result["success"] = true;
-				return result;
-			}
-			result["error"] = "Embedded browser not available";
-			result["success"] = false;
-			return result;
-		}
+	Node *spritemancer = editor_main ? editor_main->find_child("SpriteMancerMainScreen", true, false) : nullptr;
+	if (!spritemancer) {
+		r_error = "SpriteMancer main screen not found";
+		return nullptr;
 	}
-	
-	result["error"] = "SpriteMancer main screen not found";
-	result["success"] = false;
+	Object *cef_browser = spritemancer->get("cef_browser");
+	if (!cef_browser) {
+		r_error = "Embedded browser not available";
+	}
+	return cef_browser;
 #else
-	result["error"] = "Editor tools not available";
-	result["success"] = false;
+	r_error = "Editor tools not available";
+	return nullptr;
 #endif
+}
+
+// Execute JavaScript in embedded SpriteMancer editor
+Dictionary GodotBridge::spritemancer_execute_js(const String &p_code) {
+	Dictionary result;
+	String error;
+	Object *cef_browser = _get_spritemancer_browser(error);
+	if (!cef_browser) {
+		result["error"] = error;
+		result["success"] = false;
+		return result;
+	}
+	cef_browser->call("execute_javascript", p_code);
+	result["success"] = true;
+	return result;
+}
+
+// Evaluate a JS expression in the embedded editor and send its value back as
+// a js_query_result event. Binary values (ArrayBuffer, typed arrays,
+// ImageData) arrive as bytes/Images without going through the backend.
+Dictionary GodotBridge::spritemancer_query_js(const String &p_code, int p_timeout_msec, const String &p_save_path) {
+	Dictionary result;
+	if (p_code.is_empty()) {
+		result["error"] = "code is required";
+		result["success"] = false;
+		return result;
+	}
+	if (!p_save_path.is_empty() && !p_save_path.begins_with("res://") && !p_save_path.begins_with("user://")) {
+		result["error"] = "save_path must be under res:// or user://";
+		result["success"] = false;
+		return result;
+	}
+	String error;
+	Object *cef_browser = _get_spritemancer_browser(error);
+	if (!cef_browser) {
+		result["error"] = error;
+		result["success"] = false;
+		return result;
+	}
+	if (current_client < 0 || current_client >= clients.size()) {
+		result["error"] = "JS queries need a connected client";
+		result["success"] = false;
+		return result;
+	}
 	
+	Callable callback = callable_mp(this, &GodotBridge::_on_js_query_result).bind(clients[current_client].id, p_save_path);
+	int query_id = cef_browser->call("query_javascript", p_code, callback, p_timeout_msec);
+	if (query_id < 0) {
+		result["error"] = "Browser is not ready for queries";
+		result["success"] = false;
+		return result;
+	}
+	result["query_id"] = query_id;
+	result["message"] = "Result arrives as a js_query_result event";
+	result["success"] = true;
 	return result;
 }
 
+// Shape a query value for the wire. Binary clients get bytes as-is, JSON
+// clients base64. Images are sent as raw RGBA8, or saved as PNG when a
+// save_path is given (several images get _1, _2, ... suffixes).
+Variant GodotBridge::_js_value_for_client(const Variant &p_value, bool p_binary, const String &p_save_path, Array &r_saved) {
+	switch (p_value.get_type()) {
+		case Variant::PACKED_BYTE_ARRAY: {
+			if (p_binary) {
+				return p_value;
+			}
+			PackedByteArray bytes = p_value;
+			Dictionary encoded;
+			encoded["base64"] = CryptoCore::b64_encode_str(bytes.ptr(), bytes.size());
+			encoded["size"] = bytes.size();
+			return encoded;
+		}
+		case Variant::OBJECT: {
+			Ref<Image> img = p_value;
+			if (img.is_null()) {
+				return Variant();
+			}
+			Dictionary encoded;
+			encoded["width"] = img->get_width();
+			encoded["height"] = img->get_height();
+			if (!p_save_path.is_empty()) {
+				String path = r_saved.is_empty() ? p_save_path : p_save_path.get_basename() + "_" + itos(r_saved.size()) + "." + p_save_path.get_extension();
+				Error err = img->save_png(path);
+				if (err == OK) {
+					r_saved.push_back(path);
+					encoded["path"] = path;
+				} else {
+					encoded["error"] = "Failed to save image: " + itos(err);
+				}
+				return encoded;
+			}
+			encoded["format"] = "rgba8";
+			encoded["data"] = _js_value_for_client(img->get_data(), p_binary, p_save_path, r_saved);
+			return encoded;
+		}
+		case Variant::ARRAY: {
+			Array in = p_value;
+			Array out;
+			out.resize(in.size());
+			for (int i = 0; i < in.size(); i++) {
+				out[i] = _js_value_for_client(in[i], p_binary, p_save_path, r_saved);
+			}
+			return out;
+		}
+		case Variant::DICTIONARY: {
+			Dictionary in = p_value;
+			Dictionary out;
+			for (const Variant *key = in.next(nullptr); key; key = in.next(key)) {
+				out[*key] = _js_value_for_client(in[*key], p_binary, p_save_path, r_saved);
+			}
+			return out;
+		}
+		default:
+			return p_value;
+	}
+}
+
+void GodotBridge::_on_js_query_result(int p_query_id, const Variant &p_result, const String &p_error, uint32_t p_client_id, const String &p_save_path) {
+	int client = _find_client(p_client_id);
+	if (client < 0) {
+		return;
+	}
+	
+	Dictionary data;
+	data["query_id"] = p_query_id;
+	if (!p_error.is_empty()) {
+		data["error"] = p_error;
+		data["success"] = false;
+	} else {
+		Array saved;
+		data["result"] = _js_value_for_client(p_result, clients[client].send_encoding != ENCODING_JSON, p_save_path, saved);
+		if (!saved.is_empty()) {
+			data["saved"] = saved;
+			for (int i = 0; i < saved.size(); i++) {
+				if (String(saved[i]).begins_with("res://")) {
+					queue_import(saved[i]);
+				}
+			}
+		}
+		data["success"] = true;
+	}
+	send_event(client, "js_query_result", data);
+}
+
 // Retry post-processing on an animation
 Dictionary GodotBridge::spritemancer_retry_postprocess(const String &p_project_id, const String &p_animation) {
 	// Execute JS to trigger retry in the React app
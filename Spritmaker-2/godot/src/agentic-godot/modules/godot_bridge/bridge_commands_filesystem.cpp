@@ -6,6 +6,10 @@
 #include "core/io/dir_access.h"
 #include "core/io/resource_saver.h"
 #include "core/io/resource_loader.h"
+#include "core/io/resource_importer.h"
+#include "core/crypto/crypto_core.h"
+#include "core/os/os.h"
+#include "core/os/time.h"
 #include "scene/resources/theme.h"
 #include "scene/resources/material.h"
 #include "scene/resources/sprite_frames.h"
@@ -16,21 +20,357 @@
 
 // ============ File System Commands ============
 
-Dictionary GodotBridge::list_files(const String &p_path, bool p_recursive) {
+// Name filters shared by listed and deleted entries
+static bool _list_name_matches(const ListFilesFilter &p_filter, const String &p_name) {
+	if (!p_filter.pattern.is_empty() && !p_name.matchn(p_filter.pattern)) {
+		return false;
+	}
+	if (!p_filter.extensions.is_empty() && !p_filter.extensions.has(p_name.get_extension().to_lower())) {
+		return false;
+	}
+	return true;
+}
+
+// Directory walk that reads one directory at a time, yielding
+// {path, is_dir} entries so huge trees are never listed in one go. With an
+// active filter only matching files are listed, as {path, is_dir, mtime[, size]}.
+class FileListStream : public BridgeResultStream {
+	Vector<String> dirs_to_visit;
+	Array pending;
+	int pending_offset = 0;
+	bool recursive;
+	ListFilesFilter filter;
+	ListFilesCursor cursor;
+	int files_seen = 0;
+	int folders_seen = 0;
+	int files_matched = 0;
+
+	void _read_dir(const String &p_dir) {
+		pending.clear();
+		pending_offset = 0;
+
+		Ref<DirAccess> dir = DirAccess::open(p_dir);
+		if (!dir.is_valid()) {
+			return;
+		}
+
+		bool filtering = filter.is_active();
+		Vector<String> subdirs;
+		dir->list_dir_begin();
+		String file_name = dir->get_next();
+		while (!file_name.is_empty()) {
+			if (file_name != "." && file_name != "..") {
+				String full_path = p_dir.path_join(file_name);
+				bool is_dir = dir->current_is_dir();
+				if (is_dir) {
+					folders_seen++;
+					if (recursive) {
+						subdirs.push_back(full_path);
+					}
+				} else {
+					files_seen++;
+				}
+				if (!filtering) {
+					Dictionary entry;
+					entry["path"] = full_path;
+					entry["is_dir"] = is_dir;
+					pending.push_back(entry);
+				} else if (!is_dir && _list_name_matches(filter, file_name)) {
+					// Name first, so only candidates cost a stat
+					uint64_t mtime = FileAccess::get_modified_time(full_path);
+					if (filter.is_changed(full_path, mtime)) {
+						files_matched++;
+						cursor.note(full_path, mtime);
+						Dictionary entry;
+						entry["path"] = full_path;
+						entry["is_dir"] = false;
+						entry["mtime"] = mtime;
+						if (filter.include_size) {
+							Ref<FileAccess> file = FileAccess::open(full_path, FileAccess::READ);
+							entry["size"] = file.is_valid() ? int64_t(file->get_length()) : int64_t(-1);
+						}
+						pending.push_back(entry);
+					}
+				}
+			}
+			file_name = dir->get_next();
+		}
+		dir->list_dir_end();
+
+		// Stack order: visit subdirectories in listing order
+		for (int i = subdirs.size() - 1; i >= 0; i--) {
+			dirs_to_visit.push_back(subdirs[i]);
+		}
+	}
+
+public:
+	virtual bool fill(int p_max, Array &r_items) override {
+		while (r_items.size() < p_max) {
+			if (pending_offset < pending.size()) {
+				r_items.push_back(pending[pending_offset++]);
+			} else if (!dirs_to_visit.is_empty()) {
+				String next_dir = dirs_to_visit[dirs_to_visit.size() - 1];
+				dirs_to_visit.resize(dirs_to_visit.size() - 1);
+				_read_dir(next_dir);
+			} else {
+				break;
+			}
+		}
+		return pending_offset < pending.size() || !dirs_to_visit.is_empty();
+	}
+
+	virtual void get_page_info(Dictionary &r_info) const override {
+		r_info["files_seen"] = files_seen;
+		r_info["folders_seen"] = folders_seen;
+		if (filter.is_active()) {
+			r_info["files_matched"] = files_matched;
+		}
+		if (filter.changed_since > 0) {
+			// Pass back as changed_since and seen; final once has_more is false
+			cursor.write(r_info);
+		}
+	}
+
+	FileListStream(const String &p_path, bool p_recursive, const ListFilesFilter &p_filter, const ListFilesCursor &p_cursor) :
+			recursive(p_recursive), filter(p_filter), cursor(p_cursor) {
+		dirs_to_visit.push_back(p_path);
+	}
+};
+
+#ifdef TOOLS_ENABLED
+// Walk of the editor's in-memory EditorFileSystemDirectory tree: no disk
+// access except for sizes when asked for. Directories are re-resolved by path
+// on every page because a rescan may replace the tree between pages.
+class EditorFileListStream : public BridgeResultStream {
+	LocalVector<String> dirs_to_visit;
+	bool recursive;
+	ListFilesFilter filter;
+	int files_seen = 0;
+	int folders_seen = 0;
+	int files_matched = 0;
+	ListFilesCursor cursor;
+
+public:
+	virtual bool fill(int p_max, Array &r_items) override {
+		EditorFileSystem *efs = EditorFileSystem::get_singleton();
+		while (r_items.size() < p_max && !dirs_to_visit.is_empty()) {
+			String dir_path = dirs_to_visit[dirs_to_visit.size() - 1];
+			dirs_to_visit.resize(dirs_to_visit.size() - 1);
+			EditorFileSystemDirectory *dir = efs ? efs->get_filesystem_path(dir_path) : nullptr;
+			if (!dir) {
+				continue;
+			}
+
+			// Stack order: visit subdirectories in listing order
+			for (int i = dir->get_subdir_count() - 1; i >= 0; i--) {
+				EditorFileSystemDirectory *subdir = dir->get_subdir(i);
+				folders_seen++;
+				if (recursive) {
+					dirs_to_visit.push_back(subdir->get_path());
+				}
+			}
+			// Folders are only listed in a full listing, not when filtering or polling
+			if (!filter.is_active()) {
+				for (int i = 0; i < dir->get_subdir_count(); i++) {
+					Dictionary entry;
+					entry["path"] = dir->get_subdir(i)->get_path().trim_suffix("/");
+					entry["is_dir"] = true;
+					r_items.push_back(entry);
+				}
+			}
+
+			for (int i = 0; i < dir->get_file_count(); i++) {
+				files_seen++;
+				uint64_t mtime = dir->get_file_modified_time(i);
+				String path = dir->get_file_path(i);
+				if (!_list_name_matches(filter, dir->get_file(i)) || !filter.is_changed(path, mtime)) {
+					continue;
+				}
+				files_matched++;
+				cursor.note(path, mtime);
+				Dictionary entry;
+				entry["path"] = path;
+				entry["is_dir"] = false;
+				entry["type"] = dir->get_file_type(i);
+				entry["mtime"] = mtime;
+				if (filter.include_size) {
+					Ref<FileAccess> file = FileAccess::open(path, FileAccess::READ);
+					entry["size"] = file.is_valid() ? int64_t(file->get_length()) : int64_t(-1);
+				}
+				r_items.push_back(entry);
+			}
+		}
+		return !dirs_to_visit.is_empty();
+	}
+
+	virtual void get_page_info(Dictionary &r_info) const override {
+		r_info["files_seen"] = files_seen;
+		r_info["folders_seen"] = folders_seen;
+		r_info["files_matched"] = files_matched;
+		if (filter.changed_since > 0) {
+			// Pass back as changed_since and seen; final once has_more is false
+			cursor.write(r_info);
+		}
+	}
+
+	// p_cursor already holds the deletions reported with the first page
+	EditorFileListStream(const String &p_path, bool p_recursive, const ListFilesFilter &p_filter, const ListFilesCursor &p_cursor) :
+			recursive(p_recursive), filter(p_filter), cursor(p_cursor) {
+		dirs_to_visit.push_back(p_path);
+	}
+};
+
+// Unpaged plain listing in the shape of _list_files_internal
+static void _list_editor_files(EditorFileSystemDirectory *p_dir, bool p_recursive, Array &r_files, Array &r_folders) {
+	for (int i = 0; i < p_dir->get_subdir_count(); i++) {
+		EditorFileSystemDirectory *subdir = p_dir->get_subdir(i);
+		r_folders.push_back(subdir->get_path().trim_suffix("/"));
+		if (p_recursive) {
+			_list_editor_files(subdir, true, r_files, r_folders);
+		}
+	}
+	for (int i = 0; i < p_dir->get_file_count(); i++) {
+		r_files.push_back(p_dir->get_file_path(i));
+	}
+}
+#endif
+
+// Listings under res:// are served from EditorFileSystem's in-memory tree when
+// it covers p_path and isn't mid-scan; a walk of the disk covers the rest and
+// p_from_disk. The editor's tree only holds files it tracks, so p_from_disk
+// also finds the others. Filtered listings are paginated
+// {path, is_dir, type, mtime[, size]} entries (no type from the disk).
+Dictionary GodotBridge::list_files(const String &p_path, bool p_recursive, int p_page_size, const ListFilesFilter &p_filter, bool p_from_disk) {
 	Dictionary result;
+	result["path"] = p_path;
+	result["recursive"] = p_recursive;
+	
+#ifdef TOOLS_ENABLED
+	EditorFileSystem *efs = EditorFileSystem::get_singleton();
+	EditorFileSystemDirectory *root = nullptr;
+	if (!p_from_disk && efs && !efs->is_scanning() && p_path.begins_with("res://")) {
+		root = efs->get_filesystem_path(p_path);
+	}
+	if (root) {
+		result["source"] = "editor_filesystem";
+		if (!p_filter.is_active() && p_page_size <= 0) {
+			Array files;
+			Array folders;
+			_list_editor_files(root, p_recursive, files, folders);
+			result["files"] = files;
+			result["folders"] = folders;
+			result["success"] = true;
+			return result;
+		}
+		ListFilesCursor cursor(p_filter);
+		if (p_filter.changed_since > 0) {
+			_list_deleted_files(root->get_path(), p_recursive, p_filter, cursor, result);
+		}
+		_page_result(result, "entries", memnew(EditorFileListStream(root->get_path(), p_recursive, p_filter, cursor)), p_page_size);
+		result["success"] = true;
+		return result;
+	}
+#endif
+	
+	result["source"] = "disk";
+	if (p_filter.is_active()) {
+		ListFilesCursor cursor(p_filter);
+		if (p_filter.changed_since > 0) {
+			if (p_path.begins_with("res://")) {
+				_list_deleted_files(p_path, p_recursive, p_filter, cursor, result);
+			} else {
+				result["deleted"] = Array();
+				result["deleted_incomplete"] = true;  // Deletions are only logged under res://
+			}
+		}
+		_page_result(result, "entries", memnew(FileListStream(p_path, p_recursive, p_filter, cursor)), p_page_size);
+		result["success"] = true;
+		return result;
+	}
+	if (p_page_size > 0) {
+		_page_result(result, "entries", memnew(FileListStream(p_path, p_recursive, p_filter, ListFilesCursor())), p_page_size);
+		result["success"] = true;
+		return result;
+	}
+	
 	Array files;
 	Array folders;
 	
 	_list_files_internal(p_path, p_recursive, files, folders);
 	
-	result["path"] = p_path;
 	result["files"] = files;
 	result["folders"] = folders;
-	result["recursive"] = p_recursive;
 	result["success"] = true;
 	return result;
 }
 
+// Diff the editor's file set against the previous one
+void GodotBridge::_track_deleted_files(const HashSet<String> &p_files) {
+	uint64_t now = uint64_t(Time::get_singleton()->get_unix_time_from_system());
+	if (!known_files_ready) {
+		known_files_ready = true;
+		known_files = p_files;
+		deleted_log_since = now;
+		return;
+	}
+
+	for (const String &path : known_files) {
+		if (!p_files.has(path)) {
+			deleted_files.push_back({ path, now });
+		}
+	}
+	// A path that came back is no longer deleted
+	bool restored = false;
+	for (const DeletedFile &entry : deleted_files) {
+		if (p_files.has(entry.path)) {
+			restored = true;
+			break;
+		}
+	}
+	if (restored) {
+		uint32_t kept = 0;
+		for (uint32_t i = 0; i < deleted_files.size(); i++) {
+			if (!p_files.has(deleted_files[i].path)) {
+				deleted_files[kept++] = deleted_files[i];
+			}
+		}
+		deleted_files.resize(kept);
+	}
+	if (deleted_files.size() > MAX_DELETED_FILES) {
+		uint32_t drop = deleted_files.size() - MAX_DELETED_FILES;
+		deleted_log_since = deleted_files[drop - 1].deleted_at + 1;
+		for (uint32_t i = 0; i < MAX_DELETED_FILES; i++) {
+			deleted_files[i] = deleted_files[i + drop];
+		}
+		deleted_files.resize(MAX_DELETED_FILES);
+	}
+	known_files = p_files;
+}
+
+// Adds "deleted" (paths under p_dir removed since the poll position) to
+// r_result and moves r_cursor past them
+void GodotBridge::_list_deleted_files(const String &p_dir, bool p_recursive, const ListFilesFilter &p_filter, ListFilesCursor &r_cursor, Dictionary &r_result) const {
+	String prefix = p_dir.ends_with("/") ? p_dir : p_dir + "/";
+	Array deleted;
+	for (const DeletedFile &entry : deleted_files) {
+		if (!entry.path.begins_with(prefix) || !p_filter.is_changed(entry.path, entry.deleted_at)) {
+			continue;
+		}
+		if (!p_recursive && entry.path.substr(prefix.length()).contains("/")) {
+			continue;
+		}
+		if (!_list_name_matches(p_filter, entry.path.get_file())) {
+			continue;
+		}
+		deleted.push_back(entry.path);
+		r_cursor.note(entry.path, entry.deleted_at);
+	}
+	r_result["deleted"] = deleted;
+	if (p_filter.changed_since < deleted_log_since) {
+		r_result["deleted_incomplete"] = true;  // The log doesn't reach back that far
+	}
+}
+
 void GodotBridge::_list_files_internal(const String &p_path, bool p_recursive, Array &r_files, Array &r_folders) {
 	Ref<DirAccess> dir = DirAccess::open(p_path);
 	if (!dir.is_valid()) {
@@ -57,7 +397,46 @@ void GodotBridge::_list_files_internal(const String &p_path, bool p_recursive, A
 	dir->list_dir_end();
 }
 
-Dictionary GodotBridge::read_file(const String &p_path) {
+// Content hash for read_file, cached by path so repeated conditional reads
+// don't hash the whole file again
+String GodotBridge::_file_content_hash(const String &p_path, uint64_t p_mtime, uint64_t p_size) {
+	{
+		MutexLock lock(file_hash_mutex);
+		const FileHashEntry *entry = file_hash_cache.getptr(p_path);
+		// A write later in the second the hash was taken keeps mtime and maybe size
+		if (entry && entry->mtime == p_mtime && entry->size == p_size && p_mtime < entry->hashed_at) {
+			return entry->hash;
+		}
+	}
+
+	String hash = FileAccess::get_md5(p_path);  // Reads in chunks
+	_store_file_hash(p_path, p_mtime, p_size, hash);
+	return hash;
+}
+
+// p_mtime must have been read before the content that p_hash was taken from
+void GodotBridge::_store_file_hash(const String &p_path, uint64_t p_mtime, uint64_t p_size, const String &p_hash) {
+	uint64_t now = uint64_t(Time::get_singleton()->get_unix_time_from_system());
+	MutexLock lock(file_hash_mutex);
+	if (file_hash_cache.size() >= MAX_FILE_HASH_CACHE) {
+		file_hash_cache.clear();
+	}
+	file_hash_cache[p_path] = { p_mtime, p_size, now, p_hash };
+}
+
+// Called by every command that writes, moves or deletes a file
+void GodotBridge::_invalidate_file_hash(const String &p_path) {
+	MutexLock lock(file_hash_mutex);
+	file_hash_cache.erase(p_path);
+}
+
+// Reads a byte range (offset/length) or a line range (start_line/line_count,
+// 1-based) without loading the rest of the file. Every response carries the
+// file's mtime. The hash is included when the read covers the whole file
+// (hashed from the bytes already read), when asked for with p_with_hash, or
+// when if_none_match is given; a matching if_none_match returns just
+// {unchanged: true}. Only the last two cases hash a file beyond the range.
+Dictionary GodotBridge::read_file(const String &p_path, int64_t p_offset, int64_t p_length, int p_start_line, int p_line_count, const String &p_encoding, const String &p_if_none_match, bool p_with_hash) {
 	Dictionary result;
 	
 	// Check if file exists
@@ -66,6 +445,11 @@ Dictionary GodotBridge::read_file(const String &p_path) {
 		result["success"] = false;
 		return result;
 	}
+	if (p_encoding != "text" && p_encoding != "base64") {
+		result["error"] = "Unknown encoding: " + p_encoding + " (expected text or base64)";
+		result["success"] = false;
+		return result;
+	}
 	
 	// Open and read file
 	Ref<FileAccess> file = FileAccess::open(p_path, FileAccess::READ);
@@ -75,23 +459,97 @@ Dictionary GodotBridge::read_file(const String &p_path) {
 		return result;
 	}
 	
-	// Read content (limit to 100KB for safety)
 	int64_t file_size = file->get_length();
+	uint64_t mtime = FileAccess::get_modified_time(p_path);
+	String hash;
+	if (p_with_hash || !p_if_none_match.is_empty()) {
+		hash = _file_content_hash(p_path, mtime, file_size);
+		result["hash"] = hash;
+	}
+	
+	result["path"] = p_path;
+	result["size"] = file_size;
+	result["mtime"] = mtime;
+	
+	if (!p_if_none_match.is_empty() && p_if_none_match == hash) {
+		result["unchanged"] = true;
+		result["success"] = true;
+		return result;
+	}
+	
+	// Read content (limit to 100KB per call for safety)
 	const int64_t MAX_SIZE = 100 * 1024; // 100KB
+	PackedByteArray bytes;
+	bool has_more = false;
 	
-	if (file_size > MAX_SIZE) {
-		result["warning"] = "File truncated to 100KB";
-		file_size = MAX_SIZE;
+	if (p_start_line > 0) {
+		// Lines have to be found by scanning, but reading stops at the range end
+		int line = 1;
+		while (line < p_start_line && !file->eof_reached()) {
+			file->get_line();
+			line++;
+		}
+		int64_t start = file->get_position();
+		int lines_read = 0;
+		while (!file->eof_reached() && (p_line_count <= 0 || lines_read < p_line_count) && file->get_position() - start < MAX_SIZE) {
+			file->get_line();
+			lines_read++;
+		}
+		int64_t end = MIN(file->get_position(), start + MAX_SIZE);
+		file->seek(start);
+		bytes = file->get_buffer(end - start);
+		has_more = end < file_size;
+		result["start_line"] = p_start_line;
+		result["line_count"] = lines_read;
+		result["offset"] = start;
+	} else {
+		int64_t offset = CLAMP(p_offset, int64_t(0), file_size);
+		int64_t length = p_length < 0 ? MAX_SIZE : MIN(p_length, MAX_SIZE);
+		length = MIN(length, file_size - offset);
+		file->seek(offset);
+		bytes = file->get_buffer(length);
+		has_more = offset + length < file_size;
+		result["offset"] = offset;
+		if (p_offset == 0 && p_length < 0 && has_more) {
+			result["warning"] = "File truncated to 100KB";
+		}
 	}
 	
-	String content = file->get_as_text();
-	if (content.length() > MAX_SIZE) {
-		content = content.substr(0, MAX_SIZE);
+	// Whole file in hand: its hash costs nothing extra
+	if (hash.is_empty() && int64_t(result["offset"]) == 0 && bytes.size() == file_size) {
+		unsigned char digest[16];
+		CryptoCore::md5(bytes.ptr(), bytes.size(), digest);
+		hash = String::hex_encode_buffer(digest, 16);
+		_store_file_hash(p_path, mtime, file_size, hash);
+		result["hash"] = hash;
 	}
 	
-	result["path"] = p_path;
-	result["content"] = content;
-	result["size"] = file_size;
+	if (p_encoding == "base64") {
+		result["content"] = CryptoCore::b64_encode_str(bytes.ptr(), bytes.size());
+	} else {
+		// Don't split a UTF-8 sequence at the end of the range
+		int64_t end = bytes.size();
+		if (has_more && end > 0) {
+			int64_t lead = end - 1;
+			while (lead > 0 && lead > end - 4 && (bytes[lead] & 0xC0) == 0x80) {
+				lead--;
+			}
+			uint8_t b = bytes[lead];
+			int needed = (b & 0x80) == 0 ? 1 : (b & 0xE0) == 0xC0 ? 2 : (b & 0xF0) == 0xE0 ? 3 : 4;
+			if (end - lead < needed) {
+				end = lead;
+			}
+		}
+		String content;
+		content.parse_utf8((const char *)bytes.ptr(), end);
+		result["content"] = content;
+		bytes.resize(end);
+	}
+	
+	result["encoding"] = p_encoding;
+	result["length"] = bytes.size();
+	result["next_offset"] = int64_t(result["offset"]) + bytes.size();
+	result["has_more"] = has_more;
 	result["success"] = true;
 	return result;
 }
@@ -129,6 +587,8 @@ Dictionary GodotBridge::delete_file(const String &p_path) {
 	
 	Error err = dir->remove(p_path);
 	if (err == OK) {
+		script_index.mark_dirty(p_path);
+		_invalidate_file_hash(p_path);
 		result["path"] = p_path;
 		result["success"] = true;
 	} else {
@@ -224,7 +684,43 @@ Dictionary GodotBridge::assets_scan() {
 	return result;
 }
 
-Dictionary GodotBridge::assets_update_file(const String &p_path) {
+void GodotBridge::queue_import(const String &p_path) {
+	_invalidate_file_hash(p_path);  // Queued paths were just written
+	if (pending_import_set.has(p_path)) {
+		import_last_msec = OS::get_singleton()->get_ticks_msec();
+		return;
+	}
+	uint64_t now = OS::get_singleton()->get_ticks_msec();
+	if (pending_imports.is_empty()) {
+		import_first_msec = now;
+	}
+	import_last_msec = now;
+	pending_imports.push_back(p_path);
+	pending_import_set.insert(p_path);
+	if (!running) {
+		set_process(true);  // _notification pumps the queue without a server
+	}
+}
+
+void GodotBridge::_pump_imports() {
+	if (pending_imports.is_empty()) {
+		return;
+	}
+	uint64_t now = OS::get_singleton()->get_ticks_msec();
+	if (now - import_last_msec < IMPORT_DEBOUNCE_MSEC && now - import_first_msec < IMPORT_MAX_DELAY_MSEC) {
+		return;
+	}
+#ifdef TOOLS_ENABLED
+	// reimport_files can't nest inside a running scan/import; retry next frame
+	EditorFileSystem *efs = EditorFileSystem::get_singleton();
+	if (efs && (efs->is_scanning() || efs->is_importing())) {
+		return;
+	}
+#endif
+	assets_flush_imports();
+}
+
+Dictionary GodotBridge::assets_flush_imports() {
 	Dictionary result;
 #ifdef TOOLS_ENABLED
 	EditorFileSystem *efs = EditorFileSystem::get_singleton();
@@ -233,71 +729,110 @@ Dictionary GodotBridge::assets_update_file(const String &p_path) {
 		result["success"] = false;
 		return result;
 	}
+	if (efs->is_importing()) {
+		result["error"] = "Import already in progress; queued paths will be flushed automatically";
+		result["pending"] = pending_imports.size();
+		result["success"] = false;
+		return result;
+	}
 	
-	// Use scan() like the SpriteMancer dock does - most reliable way to detect new files
-	efs->scan();
+	Array paths;
+	Vector<String> importable;
+	bool needs_scan = false;
+	for (const String &path : pending_imports) {
+		paths.push_back(path);
+		// update_file only knows directories the filesystem has seen
+		if (!efs->get_filesystem_path(path.get_base_dir())) {
+			needs_scan = true;
+			continue;
+		}
+		efs->update_file(path);
+		if (FileAccess::exists(path) && ResourceFormatImporter::get_singleton()->get_importer_by_extension(path.get_extension().to_lower()).is_valid()) {
+			importable.push_back(path);
+		}
+	}
+	pending_imports.clear();
+	pending_import_set.clear();
 	
-	result["path"] = p_path;
-	result["message"] = "Filesystem scan triggered";
+	if (!importable.is_empty()) {
+		efs->reimport_files(importable);
+	}
+	if (needs_scan) {
+		efs->scan();
+	}
+	
+	result["paths"] = paths;
+	result["reimported"] = importable.size();
+	result["scan"] = needs_scan;
 	result["success"] = true;
 #else
+	pending_imports.clear();
+	pending_import_set.clear();
 	result["error"] = "Editor tools not available";
 	result["success"] = false;
 #endif
 	return result;
 }
 
-Dictionary GodotBridge::assets_update_files(const Array &p_paths) {
+Dictionary GodotBridge::assets_update_file(const String &p_path, bool p_wait) {
 	Dictionary result;
-#ifdef TOOLS_ENABLED
-	EditorFileSystem *efs = EditorFileSystem::get_singleton();
-	if (!efs) {
-		result["error"] = "EditorFileSystem not available";
+	if (!p_path.begins_with("res://")) {
+		result["error"] = "Path must start with res://";
 		result["success"] = false;
 		return result;
 	}
 	
-	// Use scan() like the SpriteMancer dock does - most reliable way to detect new files
-	efs->scan();
+	queue_import(p_path);
+	if (p_wait) {
+		// Imported (with the rest of the queue) before the response
+		result = assets_flush_imports();
+		result["path"] = p_path;
+		return result;
+	}
 	
-	result["paths"] = p_paths;
-	result["count"] = p_paths.size();
-	result["message"] = "Filesystem scan triggered";
+	result["path"] = p_path;
+	result["queued"] = true;
+	result["pending"] = pending_imports.size();
 	result["success"] = true;
-#else
-	result["error"] = "Editor tools not available";
-	result["success"] = false;
-#endif
 	return result;
 }
 
-Dictionary GodotBridge::assets_reimport(const String &p_path) {
+Dictionary GodotBridge::assets_update_files(const Array &p_paths, bool p_wait) {
 	Dictionary result;
-#ifdef TOOLS_ENABLED
-	EditorFileSystem *efs = EditorFileSystem::get_singleton();
-	if (!efs) {
-		result["error"] = "EditorFileSystem not available";
-		result["success"] = false;
-		return result;
+	Array skipped;
+	for (int i = 0; i < p_paths.size(); i++) {
+		String path = p_paths[i];
+		if (path.begins_with("res://")) {
+			queue_import(path);
+		} else {
+			skipped.push_back(p_paths[i]);
+		}
 	}
 	
-	// First ensure the file is in the filesystem
-	efs->update_file(p_path);
-	
-	PackedStringArray paths;
-	paths.push_back(p_path);
-	efs->reimport_files(paths);
+	if (p_wait) {
+		result = assets_flush_imports();
+		if (!skipped.is_empty()) {
+			result["skipped"] = skipped;
+		}
+		return result;
+	}
 	
-	result["path"] = p_path;
-	result["message"] = "Reimport triggered";
+	result["paths"] = p_paths;
+	result["count"] = p_paths.size() - skipped.size();
+	if (!skipped.is_empty()) {
+		result["skipped"] = skipped;
+	}
+	result["queued"] = true;
+	result["pending"] = pending_imports.size();
 	result["success"] = true;
-#else
-	result["error"] = "Editor tools not available";
-	result["success"] = false;
-#endif
 	return result;
 }
 
+Dictionary GodotBridge::assets_reimport(const String &p_path, bool p_wait) {
+	// Same queue: every flush reimports its importable paths
+	return assets_update_file(p_path, p_wait);
+}
+
 Dictionary GodotBridge::assets_move_and_rename(const String &p_from, const String &p_to) {
 	Dictionary result;
 #ifdef TOOLS_ENABLED
@@ -318,6 +853,10 @@ Dictionary GodotBridge::assets_move_and_rename(const String &p_from, const Strin
 	
 	Error err = dir->rename(p_from, p_to);
 	if (err == OK) {
+		script_index.mark_dirty(p_from);
+		script_index.mark_dirty(p_to);
+		_invalidate_file_hash(p_from);
+		_invalidate_file_hash(p_to);
 		// Trigger rescan to update dependency tracking
 		efs->scan();
 		result["from"] = p_from;
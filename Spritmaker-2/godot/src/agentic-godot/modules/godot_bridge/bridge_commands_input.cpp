@@ -104,7 +104,7 @@ Dictionary GodotBridge::remove_input_action(const String &p_action) {
 	return result;
 }
 
-Dictionary GodotBridge::list_input_actions() {
+Dictionary GodotBridge::list_input_actions(int p_page_size) {
 	Dictionary result;
 	Array actions;
 	
@@ -127,8 +127,12 @@ Dictionary GodotBridge::list_input_actions() {
 		}
 	}
 	
-	result["actions"] = actions;
-	result["count"] = actions.size();
+	if (p_page_size > 0) {
+		_page_result(result, "actions", memnew(BridgeArrayStream(actions)), p_page_size);
+	} else {
+		result["actions"] = actions;
+		result["count"] = actions.size();
+	}
 	result["success"] = true;
 	return result;
 }
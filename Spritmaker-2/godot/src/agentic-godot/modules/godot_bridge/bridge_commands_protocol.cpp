@@ -0,0 +1,660 @@
+// bridge_commands_protocol.cpp
+// Protocol-level commands for GodotBridge (batching, negotiation and result paging)
+
+#include "godot_bridge.h"
+#include "core/config/project_settings.h"
+#include "core/crypto/crypto_core.h"
+#include "core/os/os.h"
+#include "core/os/time.h"
+
+// ============ Batch Execution ============
+
+// Resolve a single "N.key.subkey" reference against earlier step results.
+// Negative indices are relative to the current step (-1 = previous step).
+static bool _lookup_batch_ref(const String &p_ref, const Array &p_results, Variant &r_value) {
+	PackedStringArray parts = p_ref.split(".");
+	if (parts.is_empty() || !parts[0].is_valid_int()) {
+		return false;
+	}
+
+	int index = parts[0].to_int();
+	if (index < 0) {
+		index += p_results.size();
+	}
+	if (index < 0 || index >= p_results.size()) {
+		return false;
+	}
+
+	Variant current = p_results[index];
+	for (int i = 1; i < parts.size(); i++) {
+		if (current.get_type() == Variant::DICTIONARY) {
+			Dictionary dict = current;
+			if (!dict.has(parts[i])) {
+				return false;
+			}
+			current = dict[parts[i]];
+		} else if (current.get_type() == Variant::ARRAY && parts[i].is_valid_int()) {
+			Array arr = current;
+			int arr_index = parts[i].to_int();
+			if (arr_index < 0 || arr_index >= arr.size()) {
+				return false;
+			}
+			current = arr[arr_index];
+		} else {
+			return false;
+		}
+	}
+
+	r_value = current;
+	return true;
+}
+
+String GodotBridge::_resolve_batch_string(const String &p_value, const Array &p_results) {
+	String resolved;
+	int from = 0;
+	int start;
+	while ((start = p_value.find("${", from)) != -1) {
+		int end = p_value.find("}", start + 2);
+		if (end == -1) {
+			break;
+		}
+		resolved += p_value.substr(from, start - from);
+
+		Variant value;
+		String ref = p_value.substr(start + 2, end - start - 2);
+		if (_lookup_batch_ref(ref, p_results, value)) {
+			resolved += String(value);
+		} else {
+			// Leave unresolved references untouched so the step fails visibly
+			resolved += p_value.substr(start, end - start + 1);
+		}
+		from = end + 1;
+	}
+	resolved += p_value.substr(from);
+	return resolved;
+}
+
+Variant GodotBridge::_resolve_batch_refs(const Variant &p_value, const Array &p_results) {
+	switch (p_value.get_type()) {
+		case Variant::STRING: {
+			String str = p_value;
+			if (str.find("${") == -1) {
+				return p_value;
+			}
+			// A value that is exactly one reference keeps the referenced type
+			if (str.begins_with("${") && str.ends_with("}") && str.find("${", 2) == -1) {
+				Variant value;
+				if (_lookup_batch_ref(str.substr(2, str.length() - 3), p_results, value)) {
+					return value;
+				}
+			}
+			return _resolve_batch_string(str, p_results);
+		}
+		case Variant::DICTIONARY: {
+			Dictionary src = p_value;
+			Dictionary dst;
+			for (const KeyValue<Variant, Variant> &kv : src) {
+				dst[kv.key] = _resolve_batch_refs(kv.value, p_results);
+			}
+			return dst;
+		}
+		case Variant::ARRAY: {
+			Array src = p_value;
+			Array dst;
+			dst.resize(src.size());
+			for (int i = 0; i < src.size(); i++) {
+				dst[i] = _resolve_batch_refs(src[i], p_results);
+			}
+			return dst;
+		}
+		default:
+			return p_value;
+	}
+}
+
+// Run an ordered list of {method, params} steps in a single frame.
+// Params may reference earlier results with "${N.key}" (e.g. "${0.path}/Sprite").
+Dictionary GodotBridge::batch(const Array &p_commands, bool p_stop_on_error) {
+	Dictionary result;
+	Array results;
+	int failed = 0;
+	int stopped_at = -1;
+
+	for (int i = 0; i < p_commands.size(); i++) {
+		Dictionary step_result;
+
+		if (p_commands[i].get_type() != Variant::DICTIONARY) {
+			step_result["error"] = "Batch step " + itos(i) + " is not an object";
+			step_result["success"] = false;
+		} else {
+			Dictionary step = p_commands[i];
+			String method = step.get("method", "");
+			Dictionary params = _resolve_batch_refs(step.get("params", Dictionary()), results);
+
+			const BridgeCommand *command = command_registry.getptr(method);
+			if (method == "batch") {
+				step_result["error"] = "Nested batch is not supported";
+				step_result["success"] = false;
+			} else if (command && command->threading == COMMAND_CONNECTION) {
+				// Those need the connection idle, and would switch format mid-batch
+				step_result["error"] = "'" + method + "' changes the connection and cannot run inside a batch";
+				step_result["success"] = false;
+			} else {
+				step_result = _dispatch_command(method, params);
+			}
+			step_result["method"] = method;
+		}
+
+		bool step_failed = step_result.has("error") || !bool(step_result.get("success", true));
+		results.push_back(step_result);
+
+		if (step_failed) {
+			failed++;
+			if (p_stop_on_error) {
+				stopped_at = i;
+				break;
+			}
+		}
+	}
+
+	result["results"] = results;
+	result["total"] = p_commands.size();
+	result["completed"] = results.size();
+	result["failed"] = failed;
+	if (stopped_at != -1) {
+		result["stopped_at"] = stopped_at;
+	}
+	result["success"] = failed == 0;
+	return result;
+}
+
+// ============ Connection Negotiation ============
+// These run as COMMAND_CONNECTION jobs: the client has nothing in flight, and
+// the reply is written in the previous format before the new one takes effect.
+// Clients must wait for the reply before sending in the new format.
+
+// Switch the calling client's wire framing.
+Dictionary GodotBridge::set_framing(const String &p_mode) {
+	Dictionary result;
+
+	if (current_client < 0 || current_client >= clients.size()) {
+		result["error"] = "set_framing must be sent by a connected client";
+		result["success"] = false;
+		return result;
+	}
+
+	FramingMode mode;
+	if (p_mode == "newline") {
+		mode = FRAMING_NEWLINE;
+	} else if (p_mode == "length_prefixed") {
+		mode = FRAMING_LENGTH_PREFIXED;
+	} else {
+		result["error"] = "Unknown framing mode: " + p_mode;
+		result["hint"] = "Use 'newline' or 'length_prefixed'";
+		result["success"] = false;
+		return result;
+	}
+
+	ClientConnection &conn = clients.write[current_client];
+	if (mode == FRAMING_NEWLINE && conn.recv_encoding != ENCODING_JSON) {
+		result["error"] = "Binary encodings require length_prefixed framing";
+		result["success"] = false;
+		return result;
+	}
+
+	conn.recv_framing = mode;
+	conn.send_framing = mode;
+
+	result["mode"] = p_mode;
+	result["max_frame_size"] = MAX_FRAME_SIZE;
+	result["success"] = true;
+	return result;
+}
+
+// Switch the calling client's message encoding. Binary encodings imply
+// length-prefixed framing, and let commands return raw PackedByteArray data
+// (sent as msgpack bin / Variant bytes) instead of base64 strings.
+Dictionary GodotBridge::set_encoding(const String &p_encoding) {
+	Dictionary result;
+
+	if (current_client < 0 || current_client >= clients.size()) {
+		result["error"] = "set_encoding must be sent by a connected client";
+		result["success"] = false;
+		return result;
+	}
+
+	WireEncoding encoding;
+	if (p_encoding == "json") {
+		encoding = ENCODING_JSON;
+	} else if (p_encoding == "variant") {
+		encoding = ENCODING_VARIANT;
+	} else if (p_encoding == "msgpack") {
+		encoding = ENCODING_MSGPACK;
+	} else {
+		result["error"] = "Unknown encoding: " + p_encoding;
+		result["hint"] = "Use 'json', 'variant' or 'msgpack'";
+		result["success"] = false;
+		return result;
+	}
+
+	ClientConnection &conn = clients.write[current_client];
+	conn.recv_encoding = encoding;
+	conn.send_encoding = encoding;
+	if (encoding != ENCODING_JSON) {
+		conn.recv_framing = FRAMING_LENGTH_PREFIXED;
+		conn.send_framing = FRAMING_LENGTH_PREFIXED;
+	}
+
+	result["encoding"] = p_encoding;
+	result["framing"] = conn.send_framing == FRAMING_LENGTH_PREFIXED ? "length_prefixed" : "newline";
+	result["success"] = true;
+	return result;
+}
+
+// ============ Result Paging ============
+// Large results come back one page at a time. The first page is part of the
+// normal response; when more remains the response carries a "cursor" that the
+// client passes to next_page. Sending "stream": true with the original request
+// makes the bridge push the remaining pages itself as "chunk" messages tagged
+// with the request id and a sequence number (the response is seq 0).
+
+// Fill the first page of p_stream into r_result and keep the stream behind a
+// cursor if more remains. Takes ownership of p_stream. Safe on worker threads.
+void GodotBridge::_page_result(Dictionary &r_result, const String &p_items_key, BridgeResultStream *p_stream, int p_page_size) {
+	int page_size = CLAMP(p_page_size > 0 ? p_page_size : DEFAULT_PAGE_SIZE, 1, MAX_PAGE_SIZE);
+
+	Array items;
+	bool has_more = p_stream->fill(page_size, items);
+	p_stream->get_page_info(r_result);
+	r_result[p_items_key] = items;
+	r_result["count"] = items.size();
+	r_result["has_more"] = has_more;
+
+	if (!has_more) {
+		memdelete(p_stream);
+		return;
+	}
+
+	ResultCursor cursor;
+	cursor.stream = p_stream;
+	cursor.items_key = p_items_key;
+	cursor.page_size = page_size;
+	cursor.client_id = dispatch_client_id;
+	cursor.last_used_msec = OS::get_singleton()->get_ticks_msec();
+	String cursor_id = "c" + itos(next_cursor_id.increment());
+	{
+		MutexLock lock(cursor_mutex);
+		result_cursors.insert(cursor_id, cursor);
+	}
+	r_result["cursor"] = cursor_id;
+}
+
+// Attach the request id of the top-level response that returned the cursor
+void GodotBridge::_claim_cursor(const String &p_cursor, uint32_t p_client_id, const String &p_request_id, bool p_push) {
+	MutexLock lock(cursor_mutex);
+	ResultCursor *cursor = result_cursors.getptr(p_cursor);
+	if (cursor && !cursor->claimed && cursor->client_id == p_client_id) {
+		cursor->claimed = true;
+		cursor->request_id = p_request_id;
+		cursor->push = p_push && !p_request_id.is_empty();
+	}
+}
+
+// Drop cursors whose client went away or that were abandoned
+void GodotBridge::_expire_cursors() {
+	uint64_t now = OS::get_singleton()->get_ticks_msec();
+	LocalVector<String> expired;
+
+	MutexLock lock(cursor_mutex);
+	for (const KeyValue<String, ResultCursor> &kv : result_cursors) {
+		bool orphaned = kv.value.client_id != 0 && _find_client(kv.value.client_id) == -1;
+		if (orphaned || now - kv.value.last_used_msec > CURSOR_TIMEOUT_MSEC) {
+			expired.push_back(kv.key);
+		}
+	}
+	for (const String &key : expired) {
+		memdelete(result_cursors[key].stream);
+		result_cursors.erase(key);
+	}
+}
+
+void GodotBridge::_clear_cursors() {
+	MutexLock lock(cursor_mutex);
+	for (KeyValue<String, ResultCursor> &kv : result_cursors) {
+		memdelete(kv.value.stream);
+	}
+	result_cursors.clear();
+}
+
+// Push one chunk per streaming cursor while the frame budget allows
+void GodotBridge::_pump_streams(uint64_t p_frame_start) {
+	_expire_cursors();
+
+	LocalVector<String> streaming;
+	{
+		MutexLock lock(cursor_mutex);
+		for (const KeyValue<String, ResultCursor> &kv : result_cursors) {
+			if (kv.value.push) {
+				streaming.push_back(kv.key);
+			}
+		}
+	}
+
+	for (const String &cursor_id : streaming) {
+		if (OS::get_singleton()->get_ticks_usec() - p_frame_start >= (uint64_t)frame_budget_usec) {
+			break;
+		}
+
+		// Only the main thread removes cursors, so the copy stays valid while
+		// the stream is filled outside the lock
+		ResultCursor cursor;
+		{
+			MutexLock lock(cursor_mutex);
+			cursor = result_cursors[cursor_id];
+		}
+		int client_index = _find_client(cursor.client_id);
+		if (client_index == -1) {
+			continue;
+		}
+
+		Array items;
+		bool has_more = cursor.stream->fill(cursor.page_size, items);
+
+		Dictionary chunk;
+		chunk["type"] = "chunk";
+		chunk["id"] = cursor.request_id;
+		chunk["seq"] = cursor.seq + 1;
+		chunk["cursor"] = cursor_id;
+		cursor.stream->get_page_info(chunk);
+		chunk[cursor.items_key] = items;
+		chunk["count"] = items.size();
+		chunk["done"] = !has_more;
+
+		const ClientConnection &conn = clients[client_index];
+		Vector<uint8_t> encoded = _encode_message(chunk, conn.send_encoding);
+		_send_frame(client_index, conn.send_framing, encoded.ptr(), encoded.size());
+
+		MutexLock lock(cursor_mutex);
+		if (has_more) {
+			ResultCursor &entry = result_cursors[cursor_id];
+			entry.seq++;
+			entry.last_used_msec = OS::get_singleton()->get_ticks_msec();
+		} else {
+			memdelete(cursor.stream);
+			result_cursors.erase(cursor_id);
+		}
+	}
+}
+
+// Fetch the next page of a cursor opened by an earlier paginated command
+Dictionary GodotBridge::next_page(const String &p_cursor, int p_page_size) {
+	Dictionary result;
+
+	ResultCursor cursor;
+	{
+		MutexLock lock(cursor_mutex);
+		const ResultCursor *entry = result_cursors.getptr(p_cursor);
+		if (entry) {
+			cursor = *entry;
+		}
+	}
+
+	if (!cursor.stream) {
+		result["error"] = "Unknown or expired cursor: " + p_cursor;
+		result["success"] = false;
+		return result;
+	}
+	if (cursor.push) {
+		result["error"] = "Cursor is streaming; its pages arrive as chunk messages";
+		result["success"] = false;
+		return result;
+	}
+	if (cursor.client_id != dispatch_client_id) {
+		result["error"] = "Cursor belongs to another client";
+		result["success"] = false;
+		return result;
+	}
+
+	int page_size = p_page_size > 0 ? CLAMP(p_page_size, 1, MAX_PAGE_SIZE) : cursor.page_size;
+	Array items;
+	bool has_more = cursor.stream->fill(page_size, items);
+	cursor.stream->get_page_info(result);
+	result[cursor.items_key] = items;
+	result["count"] = items.size();
+	result["has_more"] = has_more;
+
+	MutexLock lock(cursor_mutex);
+	if (has_more) {
+		result["cursor"] = p_cursor;
+		ResultCursor &entry = result_cursors[p_cursor];
+		entry.seq++;
+		entry.last_used_msec = OS::get_singleton()->get_ticks_msec();
+	} else {
+		memdelete(cursor.stream);
+		result_cursors.erase(p_cursor);
+	}
+	result["success"] = true;
+	return result;
+}
+
+// Release a cursor before it is exhausted
+Dictionary GodotBridge::close_cursor(const String &p_cursor) {
+	Dictionary result;
+
+	MutexLock lock(cursor_mutex);
+	ResultCursor *cursor = result_cursors.getptr(p_cursor);
+	if (!cursor) {
+		result["error"] = "Unknown or expired cursor: " + p_cursor;
+		result["success"] = false;
+		return result;
+	}
+	if (cursor->client_id != dispatch_client_id) {
+		result["error"] = "Cursor belongs to another client";
+		result["success"] = false;
+		return result;
+	}
+
+	memdelete(cursor->stream);
+	result_cursors.erase(p_cursor);
+	result["closed"] = p_cursor;
+	result["success"] = true;
+	return result;
+}
+
+// ============ Event Subscriptions ============
+// Clients receive every broadcast event until they first call subscribe; from
+// then on only the listed topics ("*" restores everything). Protocol events
+// such as bridge_busy are always delivered.
+
+static Array _client_topic_list(bool p_all_topics, const HashSet<String> &p_topics) {
+	Array topics;
+	if (p_all_topics) {
+		topics.push_back("*");
+		return topics;
+	}
+	for (const String &topic : p_topics) {
+		topics.push_back(topic);
+	}
+	return topics;
+}
+
+Dictionary GodotBridge::subscribe(const Array &p_topics) {
+	Dictionary result;
+
+	if (current_client < 0 || current_client >= clients.size()) {
+		result["error"] = "subscribe must be sent by a connected client";
+		result["success"] = false;
+		return result;
+	}
+
+	ClientConnection &conn = clients.write[current_client];
+	bool narrow = conn.all_topics;
+	conn.all_topics = false;
+	if (narrow) {
+		conn.topics.clear();
+	}
+
+	for (int i = 0; i < p_topics.size(); i++) {
+		String topic = p_topics[i];
+		if (topic == "*") {
+			conn.all_topics = true;
+			conn.topics.clear();
+			break;
+		}
+		conn.topics.insert(topic);
+	}
+
+	result["topics"] = _client_topic_list(conn.all_topics, conn.topics);
+	result["success"] = true;
+	return result;
+}
+
+Dictionary GodotBridge::unsubscribe(const Array &p_topics) {
+	Dictionary result;
+
+	if (current_client < 0 || current_client >= clients.size()) {
+		result["error"] = "unsubscribe must be sent by a connected client";
+		result["success"] = false;
+		return result;
+	}
+
+	ClientConnection &conn = clients.write[current_client];
+	for (int i = 0; i < p_topics.size(); i++) {
+		String topic = p_topics[i];
+		if (topic == "*") {
+			conn.all_topics = false;
+			conn.topics.clear();
+			break;
+		}
+		conn.topics.erase(topic);
+	}
+
+	result["topics"] = _client_topic_list(conn.all_topics, conn.topics);
+	result["success"] = true;
+	return result;
+}
+
+// ============ Telemetry ============
+
+// Per-command call counts, latency percentiles, bytes and error rates, plus
+// queue depth and per-client throughput. Latency is measured from arrival to
+// the response being written, so it includes parse, queue and encode time.
+Dictionary GodotBridge::bridge_stats(bool p_reset) {
+	uint64_t now = OS::get_singleton()->get_ticks_msec();
+	Dictionary result = stats.to_dictionary(now);
+
+	Array client_stats;
+	for (int i = 0; i < clients.size(); i++) {
+		const ClientConnection &conn = clients[i];
+		double seconds = MAX(0.001, (now - conn.connected_msec) / 1000.0);
+		Dictionary entry;
+		entry["client"] = i;
+		entry["connected_sec"] = seconds;
+		entry["requests"] = conn.requests;
+		entry["requests_per_sec"] = conn.requests / seconds;
+		entry["bytes_in"] = conn.bytes_in;
+		entry["bytes_out"] = conn.bytes_out;
+		entry["queue_depth"] = conn.queue.size();
+		entry["jobs_in_flight"] = conn.jobs_in_flight;
+		entry["paused"] = conn.paused;
+		client_stats.push_back(entry);
+	}
+	result["clients"] = client_stats;
+	result["queue_depth"] = _total_queue_depth();
+	result["jobs_in_flight"] = in_flight_jobs.size();
+	{
+		MutexLock lock(cursor_mutex);
+		result["open_cursors"] = result_cursors.size();
+	}
+
+	if (p_reset) {
+		stats.reset(now);
+	}
+	result["success"] = true;
+	return result;
+}
+
+// ============ Protocol Tracing ============
+// A trace is a JSON-lines file: one header line, then one line per request in
+// completion order with its arrival offset, raw message, response size and
+// latency. tools/bridge_replay.py replays it against a running editor.
+
+static const char *_encoding_name(int p_encoding) {
+	switch (p_encoding) {
+		case GodotBridge::ENCODING_VARIANT:
+			return "variant";
+		case GodotBridge::ENCODING_MSGPACK:
+			return "msgpack";
+		default:
+			return "json";
+	}
+}
+
+Dictionary GodotBridge::trace_start(const String &p_path) {
+	Dictionary result;
+
+	// Traces are only written inside user:// or the project
+	String path = p_path.simplify_path();
+	String project_dir = ProjectSettings::get_singleton()->globalize_path("res://");
+	bool allowed = path.begins_with("user://") || path.begins_with("res://") || (path.is_absolute_path() && path.begins_with(project_dir));
+	if (!allowed || path.contains("..")) {
+		result["error"] = "Trace path must be under user:// or res://: " + p_path;
+		result["success"] = false;
+		return result;
+	}
+
+	trace_stop();
+	Error err;
+	trace_file = FileAccess::open(path, FileAccess::WRITE, &err);
+	if (trace_file.is_null()) {
+		result["error"] = "Cannot open trace file: " + p_path + " (error " + itos(err) + ")";
+		result["success"] = false;
+		return result;
+	}
+
+	trace_start_usec = OS::get_singleton()->get_ticks_usec();
+	Dictionary header;
+	header["trace"] = "godot_bridge";
+	header["version"] = 1;
+	header["started"] = Time::get_singleton()->get_datetime_string_from_system(true);
+	trace_file->store_line(JSON::stringify(header));
+
+	BRIDGE_LOG("GodotBridge: Tracing to " + path);
+	result["path"] = path;
+	result["success"] = true;
+	return result;
+}
+
+Dictionary GodotBridge::trace_stop() {
+	Dictionary result;
+	if (trace_file.is_null()) {
+		result["error"] = "No trace is being recorded";
+		result["success"] = false;
+		return result;
+	}
+
+	result["path"] = trace_file->get_path();
+	trace_file->flush();
+	trace_file.unref();
+	result["success"] = true;
+	return result;
+}
+
+void GodotBridge::_trace_job(const BridgeJob *p_job, uint64_t p_bytes_out, uint64_t p_latency_usec) {
+	Dictionary entry;
+	// Jobs received before a trace restart count from the new start
+	entry["t_usec"] = p_job->received_usec > trace_start_usec ? p_job->received_usec - trace_start_usec : 0;
+	entry["client"] = p_job->client_id;
+	entry["method"] = p_job->method;
+	entry["encoding"] = _encoding_name(p_job->raw_encoding);
+	if (p_job->raw_encoding == ENCODING_JSON) {
+		entry["message"] = String::utf8((const char *)p_job->raw.ptr(), p_job->raw.size()).strip_edges();
+	} else {
+		entry["message_base64"] = CryptoCore::b64_encode_str(p_job->raw.ptr(), p_job->raw.size());
+	}
+	entry["response_bytes"] = p_bytes_out;
+	entry["latency_usec"] = p_latency_usec;
+	entry["exec_usec"] = p_job->exec_usec;
+	entry["failed"] = p_job->failed;
+	trace_file->store_line(JSON::stringify(entry));
+}
@@ -31,19 +31,15 @@
 
 // ============ Scene Tree and Node Operations ============
 
-// Helper function to recursively serialize a node and its children
-// Returns a Dictionary containing node info with nested children array
-Dictionary GodotBridge::_serialize_node_recursive(Node *p_node, int p_current_depth, int p_max_depth) {
+// Basic properties shared by the nested and the paginated tree formats.
+// Paths are built from the parent's path instead of get_path(), which
+// would walk back to the root for every node.
+static Dictionary _node_summary(Node *p_node, const String &p_path, uint32_t p_handle) {
 	Dictionary node_info;
-	
-	if (!p_node) {
-		return node_info;
-	}
-	
-	// Basic node properties
 	node_info["name"] = p_node->get_name();
 	node_info["type"] = p_node->get_class();
-	node_info["path"] = String(p_node->get_path());
+	node_info["path"] = p_path;
+	node_info["handle"] = p_handle;
 	node_info["child_count"] = p_node->get_child_count();
 	
 	// Add script info if attached
@@ -57,13 +53,82 @@ Dictionary GodotBridge::_serialize_node_recursive(Node *p_node, int p_current_de
 	if (canvas_item) {
 		node_info["visible"] = canvas_item->is_visible();
 	}
+	return node_info;
+}
+
+// Depth-first walk of the edited scene that yields one flat node entry at a
+// time. Nodes are tracked by ObjectID, so nodes freed between pages are skipped.
+class SceneTreeStream : public BridgeResultStream {
+	struct Pending {
+		ObjectID id;
+		int depth;
+		String path;
+		uint32_t parent_handle;
+	};
+	GodotBridge *bridge;
+	LocalVector<Pending> stack;
+	int max_depth;
+	int visited = 0;
+
+public:
+	virtual bool fill(int p_max, Array &r_items) override {
+		while (r_items.size() < p_max && !stack.is_empty()) {
+			Pending pending = stack[stack.size() - 1];
+			stack.resize(stack.size() - 1);
+
+			Node *node = Object::cast_to<Node>(ObjectDB::get_instance(pending.id));
+			if (!node) {
+				continue;
+			}
+
+			uint32_t handle = bridge->get_node_handle(node);
+			Dictionary node_info = _node_summary(node, pending.path, handle);
+			node_info["depth"] = pending.depth;
+			if (pending.depth > 0) {
+				node_info["parent"] = pending.parent_handle;
+			}
+			int child_count = node->get_child_count();
+			if (pending.depth < max_depth) {
+				// Push in reverse so children come out in scene order
+				for (int i = child_count - 1; i >= 0; i--) {
+					Node *child = node->get_child(i);
+					stack.push_back({ child->get_instance_id(), pending.depth + 1, pending.path + "/" + String(child->get_name()), handle });
+				}
+			} else if (child_count > 0) {
+				node_info["has_more_children"] = true;
+			}
+
+			r_items.push_back(node_info);
+			visited++;
+		}
+		return !stack.is_empty();
+	}
+
+	virtual void get_page_info(Dictionary &r_info) const override {
+		r_info["nodes_sent"] = visited;
+	}
+
+	SceneTreeStream(GodotBridge *p_bridge, Node *p_root, int p_max_depth) :
+			bridge(p_bridge), max_depth(p_max_depth) {
+		stack.push_back({ p_root->get_instance_id(), 0, String(p_root->get_path()), 0 });
+	}
+};
+
+// Helper function to recursively serialize a node and its children
+// Returns a Dictionary containing node info with nested children array
+Dictionary GodotBridge::_serialize_node_recursive(Node *p_node, const String &p_path, int p_current_depth, int p_max_depth) {
+	if (!p_node) {
+		return Dictionary();
+	}
+	
+	Dictionary node_info = _node_summary(p_node, p_path, get_node_handle(p_node));
 	
 	// Recursively serialize children if within depth limit
 	if (p_current_depth < p_max_depth && p_node->get_child_count() > 0) {
 		Array children;
 		for (int i = 0; i < p_node->get_child_count(); i++) {
 			Node *child = p_node->get_child(i);
-			Dictionary child_info = _serialize_node_recursive(child, p_current_depth + 1, p_max_depth);
+			Dictionary child_info = _serialize_node_recursive(child, p_path + "/" + String(child->get_name()), p_current_depth + 1, p_max_depth);
 			children.push_back(child_info);
 		}
 		node_info["children"] = children;
@@ -75,11 +140,13 @@ Dictionary GodotBridge::_serialize_node_recursive(Node *p_node, int p_current_de
 	return node_info;
 }
 
-Dictionary GodotBridge::get_scene_tree(int p_max_depth) {
+// With p_page_size > 0 the tree is returned as a flat, depth-first list of
+// nodes (each with its depth and parent path), one page at a time.
+Dictionary GodotBridge::get_scene_tree(int p_max_depth, int p_page_size) {
 	Dictionary result;
 	
-	// Clamp max_depth to reasonable bounds (1-10)
-	int max_depth = CLAMP(p_max_depth, 1, 10);
+	// Clamp max_depth to reasonable bounds (1-10); paging lifts the size concern
+	int max_depth = CLAMP(p_max_depth, 1, p_page_size > 0 ? 128 : 10);
 	
 #ifdef TOOLS_ENABLED
 	EditorInterface *editor = EditorInterface::get_singleton();
@@ -91,9 +158,17 @@ Dictionary GodotBridge::get_scene_tree(int p_max_depth) {
 	
 	Node *root = editor->get_edited_scene_root();
 	
-	if (root) {
+	if (root && p_page_size > 0) {
+		result["root"] = root->get_class();
+		result["name"] = root->get_name();
+		result["path"] = String(root->get_path());
+		result["max_depth"] = max_depth;
+		result["version"] = scene_version;
+		_page_result(result, "nodes", memnew(SceneTreeStream(this, root, max_depth)), p_page_size);
+		result["success"] = true;
+	} else if (root) {
 		// Serialize the entire tree recursively
-		Dictionary tree = _serialize_node_recursive(root, 0, max_depth);
+		Dictionary tree = _serialize_node_recursive(root, String(root->get_path()), 0, max_depth);
 		
 		// Flatten top-level info for backwards compatibility
 		result["root"] = tree["type"];
@@ -104,9 +179,10 @@ Dictionary GodotBridge::get_scene_tree(int p_max_depth) {
 		// Also include the full tree structure for agents that need it
 		result["tree"] = tree;
 		result["max_depth"] = max_depth;
+		result["version"] = scene_version;
 		result["success"] = true;
 		
-		print_line("GodotBridge: Scene tree serialized with depth " + itos(max_depth));
+		BRIDGE_LOG_VERBOSE("GodotBridge: Scene tree serialized with depth " + itos(max_depth));
 	} else {
 		result["error"] = "No scene currently open";
 		result["success"] = false;
@@ -120,6 +196,506 @@ Dictionary GodotBridge::get_scene_tree(int p_max_depth) {
 	return result;
 }
 
+// ============ Scene Sync ============
+// The edited scene carries a version that advances with every node added,
+// removed or renamed (a reparent is a removal plus an addition). Changes are
+// kept in a bounded log so clients can catch up from the version they last saw
+// with get_scene_changes instead of re-reading the whole tree, and a
+// scene_delta event goes out once per frame. Nodes are referred to by small
+// integer handles that stay valid while the node is in the edited scene (a
+// reparent keeps its handle); any command taking a node path also accepts
+// "#<handle>".
+
+uint32_t GodotBridge::get_node_handle(Node *p_node) {
+	uint64_t id = uint64_t(p_node->get_instance_id());
+	const uint32_t *handle = node_handles.getptr(id);
+	if (handle) {
+		return *handle;
+	}
+	uint32_t new_handle = next_node_handle++;
+	node_handles.insert(id, new_handle);
+	handle_nodes.insert(new_handle, id);
+	return new_handle;
+}
+
+Node *GodotBridge::get_node_by_handle(uint32_t p_handle) {
+	const uint64_t *id = handle_nodes.getptr(p_handle);
+	if (!id) {
+		return nullptr;
+	}
+	Node *node = Object::cast_to<Node>(ObjectDB::get_instance(ObjectID(*id)));
+	if (!node) {
+		// Freed: forget the handle
+		node_handles.erase(*id);
+		handle_nodes.erase(p_handle);
+	}
+	return node;
+}
+
+// True when p_node belongs to the edited scene. Opening or switching scenes
+// starts a new change log, so older versions require a full resync.
+bool GodotBridge::_track_scene_node(Node *p_node) {
+#ifdef TOOLS_ENABLED
+	EditorNode *editor_node = EditorNode::get_singleton();
+	Node *root = editor_node ? editor_node->get_edited_scene() : nullptr;
+	if (!root) {
+		return false;
+	}
+	if (root->get_instance_id() != tracked_scene_root) {
+		tracked_scene_root = root->get_instance_id();
+		scene_version++;
+		scene_log_base = scene_version;
+		scene_changes.clear();
+
+		// Forget handles of nodes freed with the previous scene
+		LocalVector<uint32_t> stale;
+		for (const KeyValue<uint32_t, uint64_t> &kv : handle_nodes) {
+			if (!ObjectDB::get_instance(ObjectID(kv.value))) {
+				stale.push_back(kv.key);
+			}
+		}
+		for (uint32_t handle : stale) {
+			node_handles.erase(handle_nodes[handle]);
+			handle_nodes.erase(handle);
+		}
+	}
+	return p_node == root || root->is_ancestor_of(p_node);
+#else
+	return false;
+#endif
+}
+
+void GodotBridge::_record_scene_change(SceneChangeOp p_op, Node *p_node) {
+	if (!_track_scene_node(p_node)) {
+		return;
+	}
+
+	// Drop the older half once the log is full; clients behind it resync
+	if (scene_changes.size() >= MAX_SCENE_CHANGES) {
+		uint32_t keep = MAX_SCENE_CHANGES / 2;
+		uint32_t drop = scene_changes.size() - keep;
+		for (uint32_t i = 0; i < keep; i++) {
+			scene_changes[i] = scene_changes[i + drop];
+		}
+		scene_changes.resize(keep);
+		scene_log_base = scene_changes[0].version - 1;
+	}
+
+	SceneChange change;
+	change.version = ++scene_version;
+	change.op = p_op;
+	change.handle = get_node_handle(p_node);
+	Node *parent = p_node->get_parent();
+	change.parent_handle = parent && p_node->get_instance_id() != tracked_scene_root ? get_node_handle(parent) : 0;
+	change.name = p_node->get_name();
+	change.type = p_node->get_class();
+	change.path = String(p_node->get_path());
+	scene_changes.push_back(change);
+
+	if (p_op == SCENE_NODE_REMOVED) {
+		removed_handles.push_back(change.handle);
+	}
+}
+
+// Forget handles of nodes that left the edited scene and did not come back
+// within the frame (a reparent keeps its handle). Runs with the scene delta.
+void GodotBridge::_release_removed_handles() {
+	if (removed_handles.is_empty()) {
+		return;
+	}
+#ifdef TOOLS_ENABLED
+	EditorNode *editor_node = EditorNode::get_singleton();
+	Node *root = editor_node ? editor_node->get_edited_scene() : nullptr;
+	for (uint32_t handle : removed_handles) {
+		const uint64_t *id = handle_nodes.getptr(handle);
+		if (!id) {
+			continue;
+		}
+		Node *node = Object::cast_to<Node>(ObjectDB::get_instance(ObjectID(*id)));
+		bool in_scene = node && root && node->is_inside_tree() && (node == root || root->is_ancestor_of(node));
+		if (!in_scene) {
+			node_handles.erase(*id);
+			handle_nodes.erase(handle);
+		}
+	}
+#endif
+	removed_handles.clear();
+}
+
+// Cheap filter for the tree signals, which fire for every editor UI node too.
+// Owner is checked first; nodes just added often get their owner afterwards.
+static bool _is_edited_scene_node(Node *p_node) {
+#ifdef TOOLS_ENABLED
+	EditorNode *editor_node = EditorNode::get_singleton();
+	Node *root = editor_node ? editor_node->get_edited_scene() : nullptr;
+	if (!root) {
+		return false;
+	}
+	return p_node == root || p_node->get_owner() == root || root->is_ancestor_of(p_node);
+#else
+	return false;
+#endif
+}
+
+void GodotBridge::_on_tree_node_added(Node *p_node) {
+	if (!_is_edited_scene_node(p_node)) {
+		return;
+	}
+	_record_scene_change(SCENE_NODE_ADDED, p_node);
+}
+
+void GodotBridge::_on_tree_node_removed(Node *p_node) {
+	if (!_is_edited_scene_node(p_node)) {
+		return;
+	}
+	_record_scene_change(SCENE_NODE_REMOVED, p_node);
+}
+
+void GodotBridge::_on_tree_node_renamed(Node *p_node) {
+	if (!_is_edited_scene_node(p_node)) {
+		return;
+	}
+	_record_scene_change(SCENE_NODE_RENAMED, p_node);
+}
+
+// Changes after p_since_version, or false when the log no longer reaches back
+bool GodotBridge::_scene_changes_since(uint64_t p_since_version, Array &r_changes, int p_limit) const {
+	if (p_since_version < scene_log_base || p_since_version > scene_version) {
+		return false;
+	}
+
+	static const char *op_names[] = { "added", "removed", "renamed" };
+	// Versions are consecutive within the log, so the start is a direct index
+	uint32_t start = scene_changes.is_empty() ? 0 : uint32_t(MAX(int64_t(0), int64_t(p_since_version) - int64_t(scene_changes[0].version) + 1));
+	if (p_limit > 0 && scene_changes.size() - MIN(start, scene_changes.size()) > (uint32_t)p_limit) {
+		return false;
+	}
+	for (uint32_t i = start; i < scene_changes.size(); i++) {
+		const SceneChange &change = scene_changes[i];
+		Dictionary entry;
+		entry["version"] = change.version;
+		entry["op"] = op_names[change.op];
+		entry["handle"] = change.handle;
+		entry["name"] = change.name;
+		entry["type"] = change.type;
+		entry["path"] = change.path;
+		if (change.parent_handle != 0) {
+			entry["parent"] = change.parent_handle;
+		}
+		r_changes.push_back(entry);
+	}
+	return true;
+}
+
+// One scene_delta per frame covering everything since the last one
+void GodotBridge::_broadcast_scene_delta() {
+	_release_removed_handles();
+	if (broadcast_scene_version == scene_version) {
+		return;
+	}
+	uint64_t from = broadcast_scene_version;
+	broadcast_scene_version = scene_version;
+	if (!_has_event_subscribers("scene_delta")) {
+		return;
+	}
+
+	Dictionary data;
+	Array changes;
+	data["from_version"] = from;
+	data["version"] = scene_version;
+	if (_scene_changes_since(from, changes, MAX_DELTA_EVENT_CHANGES)) {
+		data["changes"] = changes;
+	} else {
+		data["full_resync"] = true;  // Too many changes or a new scene: re-read the tree
+	}
+	broadcast_event("scene_delta", data);
+}
+
+Dictionary GodotBridge::get_scene_changes(int64_t p_since_version) {
+	Dictionary result;
+	Array changes;
+
+	result["version"] = scene_version;
+	if (_scene_changes_since(p_since_version, changes, 0)) {
+		result["from_version"] = p_since_version;
+		result["changes"] = changes;
+		result["count"] = changes.size();
+	} else {
+		result["full_resync"] = true;
+		result["hint"] = "Version is too old or from another scene; call get_scene_tree";
+	}
+	result["success"] = true;
+	return result;
+}
+
+// ============ Scene Query ============
+// query_nodes filters the edited scene on the engine side and returns only the
+// requested fields, replacing a get_scene_tree + get_node_info round trip per
+// candidate. Filters are compiled once and checked cheapest first.
+
+struct NodeQueryPredicate {
+	enum Op {
+		OP_EQ,
+		OP_NE,
+		OP_LT,
+		OP_LE,
+		OP_GT,
+		OP_GE,
+		OP_CONTAINS,
+		OP_EXISTS,
+		OP_MISSING,
+	};
+	Vector<StringName> property;  // Subnames, so "position:x" reads a component
+	Op op = OP_EQ;
+	Variant value;
+};
+
+struct NodeQuery {
+	StringName class_name;  // Matches subclasses too
+	bool exact_class = false;
+	StringName group;
+	String name_pattern;    // Glob, as in String::match
+	String script_path;     // Exact path, "none" for nodes without a script, "any" for any script
+	StringName has_child_class;
+	StringName missing_child_class;
+	LocalVector<NodeQueryPredicate> predicates;
+	LocalVector<String> fields;
+	LocalVector<Vector<StringName>> field_paths;  // Property path per field, compiled once
+
+	static bool _has_child_of_class(Node *p_node, const StringName &p_class) {
+		for (int i = 0; i < p_node->get_child_count(); i++) {
+			if (p_node->get_child(i)->is_class(p_class)) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+	bool matches(Node *p_node) const {
+		if (class_name != StringName()) {
+			if (exact_class ? p_node->get_class_name() != class_name : !p_node->is_class(class_name)) {
+				return false;
+			}
+		}
+		if (group != StringName() && !p_node->is_in_group(group)) {
+			return false;
+		}
+		if (!name_pattern.is_empty() && !String(p_node->get_name()).match(name_pattern)) {
+			return false;
+		}
+		if (!script_path.is_empty()) {
+			Ref<Script> script = p_node->get_script();
+			if (script_path == "none" ? script.is_valid() : (script.is_null() || (script_path != "any" && script->get_path() != script_path))) {
+				return false;
+			}
+		}
+		if (has_child_class != StringName() && !_has_child_of_class(p_node, has_child_class)) {
+			return false;
+		}
+		if (missing_child_class != StringName() && _has_child_of_class(p_node, missing_child_class)) {
+			return false;
+		}
+
+		for (const NodeQueryPredicate &predicate : predicates) {
+			bool valid = false;
+			Variant value = p_node->get_indexed(predicate.property, &valid);
+			if (predicate.op == NodeQueryPredicate::OP_EXISTS || predicate.op == NodeQueryPredicate::OP_MISSING) {
+				if (valid != (predicate.op == NodeQueryPredicate::OP_EXISTS)) {
+					return false;
+				}
+				continue;
+			}
+			if (!valid) {
+				return false;
+			}
+
+			static const Variant::Operator variant_ops[] = {
+				Variant::OP_EQUAL, Variant::OP_NOT_EQUAL, Variant::OP_LESS,
+				Variant::OP_LESS_EQUAL, Variant::OP_GREATER, Variant::OP_GREATER_EQUAL,
+			};
+			bool ok = false;
+			Variant ret;
+			if (predicate.op == NodeQueryPredicate::OP_CONTAINS) {
+				Variant::evaluate(Variant::OP_IN, predicate.value, value, ret, ok);
+			} else {
+				Variant::evaluate(variant_ops[predicate.op], value, predicate.value, ret, ok);
+			}
+			if (!ok || !ret.booleanize()) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	Dictionary project(Node *p_node, const String &p_path, uint32_t p_handle) const {
+		Dictionary entry;
+		for (uint32_t i = 0; i < fields.size(); i++) {
+			const String &field = fields[i];
+			if (field == "name") {
+				entry["name"] = p_node->get_name();
+			} else if (field == "type") {
+				entry["type"] = p_node->get_class();
+			} else if (field == "path") {
+				entry["path"] = p_path;
+			} else if (field == "handle") {
+				entry["handle"] = p_handle;
+			} else if (field == "child_count") {
+				entry["child_count"] = p_node->get_child_count();
+			} else if (field == "script") {
+				Ref<Script> script = p_node->get_script();
+				entry["script"] = script.is_valid() ? Variant(script->get_path()) : Variant();
+			} else if (field == "groups") {
+				Array groups;
+				List<Node::GroupInfo> group_list;
+				p_node->get_groups(&group_list);
+				for (const Node::GroupInfo &info : group_list) {
+					if (info.persistent) {
+						groups.push_back(info.name);
+					}
+				}
+				entry["groups"] = groups;
+			} else {
+				bool valid = false;
+				Variant value = p_node->get_indexed(field_paths[i], &valid);
+				if (valid) {
+					entry[field] = value;
+				}
+			}
+		}
+		return entry;
+	}
+};
+
+// Depth-first walk over a subtree yielding projected matches. Matches are
+// produced lazily, so a page of 50 out of a 10k node scene stops walking early.
+class NodeQueryStream : public BridgeResultStream {
+	struct Pending {
+		ObjectID id;
+		String path;
+	};
+	GodotBridge *bridge;
+	NodeQuery query;
+	LocalVector<Pending> stack;
+	int visited = 0;
+	int matched = 0;
+
+public:
+	virtual bool fill(int p_max, Array &r_items) override {
+		int added = 0;
+		while (added < p_max && !stack.is_empty()) {
+			Pending pending = stack[stack.size() - 1];
+			stack.resize(stack.size() - 1);
+			Node *node = Object::cast_to<Node>(ObjectDB::get_instance(pending.id));
+			if (!node) {
+				continue;
+			}
+			visited++;
+
+			for (int i = node->get_child_count() - 1; i >= 0; i--) {
+				Node *child = node->get_child(i);
+				stack.push_back({ child->get_instance_id(), pending.path + "/" + String(child->get_name()) });
+			}
+			if (query.matches(node)) {
+				r_items.push_back(query.project(node, pending.path, bridge->get_node_handle(node)));
+				added++;
+				matched++;
+			}
+		}
+		return !stack.is_empty();
+	}
+
+	virtual void get_page_info(Dictionary &r_info) const override {
+		r_info["nodes_visited"] = visited;
+		r_info["matched"] = matched;
+	}
+
+	NodeQueryStream(GodotBridge *p_bridge, Node *p_root, const NodeQuery &p_query) :
+			bridge(p_bridge), query(p_query) {
+		stack.push_back({ p_root->get_instance_id(), String(p_root->get_path()) });
+	}
+};
+
+Dictionary GodotBridge::query_nodes(const Dictionary &p_query) {
+	Dictionary result;
+#ifdef TOOLS_ENABLED
+	String root_path = p_query.get("root", "");
+	Node *root = _get_node_by_path(root_path);
+	if (!root) {
+		result["error"] = root_path.is_empty() ? String("No scene currently open") : "Node not found: " + root_path;
+		result["success"] = false;
+		return result;
+	}
+
+	NodeQuery query;
+	String class_name = p_query.get("class", "");
+	if (!class_name.is_empty()) {
+		if (!ClassDB::class_exists(class_name)) {
+			result["error"] = "Unknown class: " + class_name;
+			result["success"] = false;
+			return result;
+		}
+		query.class_name = class_name;
+	}
+	query.exact_class = p_query.get("exact_class", false);
+	query.group = String(p_query.get("group", ""));
+	query.name_pattern = p_query.get("name", "");
+	query.script_path = p_query.get("script", "");
+	query.has_child_class = String(p_query.get("has_child", ""));
+	query.missing_child_class = String(p_query.get("missing_child", ""));
+
+	// where: [{property, op, value}], op one of == != < <= > >= contains exists missing
+	static const char *op_names[] = { "==", "!=", "<", "<=", ">", ">=", "contains", "exists", "missing" };
+	Array where = p_query.get("where", Array());
+	for (int i = 0; i < where.size(); i++) {
+		Dictionary clause = where[i];
+		NodeQueryPredicate predicate;
+		String property = clause.get("property", "");
+		predicate.property = NodePath(property).get_as_property_path().get_subnames();
+		if (predicate.property.is_empty()) {
+			result["error"] = "where[" + itos(i) + "] needs a property";
+			result["success"] = false;
+			return result;
+		}
+		String op = clause.get("op", "==");
+		int op_index = -1;
+		for (int j = 0; j < int(sizeof(op_names) / sizeof(op_names[0])); j++) {
+			if (op == op_names[j]) {
+				op_index = j;
+				break;
+			}
+		}
+		if (op_index == -1) {
+			result["error"] = "Unknown operator in where[" + itos(i) + "]: " + op;
+			result["success"] = false;
+			return result;
+		}
+		predicate.op = NodeQueryPredicate::Op(op_index);
+		predicate.value = clause.get("value", Variant());
+		query.predicates.push_back(predicate);
+	}
+
+	Array fields = p_query.get("fields", Array());
+	for (int i = 0; i < fields.size(); i++) {
+		query.fields.push_back(fields[i]);
+	}
+	if (query.fields.is_empty()) {
+		query.fields = { "name", "type", "path", "handle" };
+	}
+	for (const String &field : query.fields) {
+		query.field_paths.push_back(NodePath(field).get_as_property_path().get_subnames());
+	}
+
+	int page_size = p_query.get("page_size", 0);
+	_page_result(result, "nodes", memnew(NodeQueryStream(this, root, query)), page_size);
+	result["version"] = scene_version;
+	result["success"] = true;
+#else
+	result["error"] = "Editor tools not available";
+	result["success"] = false;
+#endif
+	return result;
+}
+
 Dictionary GodotBridge::create_scene(const String &p_path, const String &p_root_type) {
 	Dictionary result;
 	print_line("GodotBridge: Creating scene: " + p_path + " with root: " + p_root_type);
@@ -4,10 +4,14 @@
 #include "godot_bridge.h"
 #include "core/io/file_access.h"
 #include "core/io/dir_access.h"
+#include "core/crypto/crypto_core.h"
+#include "core/io/resource.h"
 #include "modules/regex/regex.h"
 
 #ifdef TOOLS_ENABLED
 #include "editor/editor_file_system.h"
+#include "editor/plugins/script_editor_plugin.h"
+#include "scene/gui/code_edit.h"
 #include "scene/main/scene_tree.h"
 #endif
 
@@ -34,6 +38,9 @@ Dictionary GodotBridge::create_script(const String &p_path, const String &p_cont
 	file->store_string(p_content);
 	file->close();
 	
+	script_index.mark_dirty(p_path);
+	_invalidate_file_hash(p_path);
+	
 	result["path"] = p_path;
 	result["success"] = true;
 	print_line("GodotBridge: Script created: " + p_path);
@@ -79,6 +86,8 @@ Dictionary GodotBridge::edit_script(const String &p_path, const String &p_conten
 	
 	file->store_string(p_content);
 	file->close();
+	script_index.mark_dirty(p_path);
+	_invalidate_file_hash(p_path);
 	
 #ifdef TOOLS_ENABLED
 	// Reload the resource in editor
@@ -93,6 +102,328 @@ Dictionary GodotBridge::edit_script(const String &p_path, const String &p_conten
 	return result;
 }
 
+// ============ Script Patching ============
+// patch_script applies range edits or a unified diff to a script instead of
+// replacing it wholesale. The edits are checked against base_hash (the hash
+// read_file returns) and applied to the open script editor buffer as one
+// undoable operation. Then only that script is reloaded; edit_script
+// instead triggers a full filesystem scan.
+
+struct ScriptTextEdit {
+	int from = 0;  // Character offsets into the original text
+	int to = 0;
+	String text;
+	uint32_t order = 0;  // Position in the request, to keep inserts at one offset in order
+};
+
+static String _bytes_md5(const uint8_t *p_data, int p_size) {
+	unsigned char digest[16];
+	CryptoCore::md5(p_data, p_size, digest);
+	return String::hex_encode_buffer(digest, 16);
+}
+
+// Offset of the start of every line, plus one past the end
+static LocalVector<int> _line_starts(const String &p_text) {
+	LocalVector<int> starts;
+	starts.push_back(0);
+	const char32_t *chars = p_text.ptr();
+	for (int i = 0; i < p_text.length(); i++) {
+		if (chars[i] == '\n') {
+			starts.push_back(i + 1);
+		}
+	}
+	starts.push_back(p_text.length() + 1);
+	return starts;
+}
+
+// {start_line, start_column, end_line, end_column, text}: lines 1-based,
+// columns 0-based, end exclusive. Columns default to 0, so
+// {start_line: 5, end_line: 7, text} replaces lines 5 and 6.
+static bool _parse_range_edits(const Array &p_edits, const LocalVector<int> &p_starts, int p_length, LocalVector<ScriptTextEdit> &r_edits, String &r_error) {
+	int line_count = p_starts.size() - 1;
+	auto offset_of = [&](int p_line, int p_column, int &r_offset) -> bool {
+		if (p_line == line_count + 1 && p_column == 0) {
+			r_offset = p_length;  // End of file
+			return true;
+		}
+		if (p_line < 1 || p_line > line_count || p_column < 0) {
+			return false;
+		}
+		int line_length = p_starts[p_line] - 1 - p_starts[p_line - 1];
+		if (p_column > line_length) {
+			return false;
+		}
+		r_offset = p_starts[p_line - 1] + p_column;
+		return true;
+	};
+
+	for (int i = 0; i < p_edits.size(); i++) {
+		Dictionary edit = p_edits[i];
+		ScriptTextEdit parsed;
+		int start_line = edit.get("start_line", 0);
+		int end_line = edit.get("end_line", start_line);
+		if (!offset_of(start_line, edit.get("start_column", 0), parsed.from) ||
+				!offset_of(end_line, edit.get("end_column", 0), parsed.to) || parsed.to < parsed.from) {
+			r_error = "Edit " + itos(i) + " is out of range";
+			return false;
+		}
+		parsed.text = edit.get("text", "");
+		r_edits.push_back(parsed);
+	}
+	return true;
+}
+
+// Unified diff hunks ("@@ -a,b +c,d @@"); context and removed lines must match.
+// Hunk bodies are read by their header counts, so a removed line that starts
+// with "--" can't be mistaken for a file header. "\ No newline at end of file"
+// marks the line before it as unterminated on its side(s), which is how a diff
+// adds or removes the final newline. One file per diff.
+static bool _parse_unified_diff(const String &p_diff, const String &p_text, const LocalVector<int> &p_starts, LocalVector<ScriptTextEdit> &r_edits, String &r_error) {
+	Vector<String> diff_lines = p_diff.split("\n");
+	Vector<String> lines = p_text.split("\n");
+	int file_headers = 0;
+	int i = 0;
+	while (i < diff_lines.size()) {
+		const String &header = diff_lines[i++];
+		if (header.begins_with("--- ") && i < diff_lines.size() && diff_lines[i].begins_with("+++ ")) {
+			i++;
+			if (++file_headers > 1) {
+				r_error = "Diff covers more than one file; send one patch_script per file";
+				return false;
+			}
+			continue;
+		}
+		if (!header.begins_with("@@")) {
+			if (!r_edits.is_empty() && !header.is_empty() && (header[0] == ' ' || header[0] == '+' || header[0] == '-')) {
+				r_error = "Diff line outside any hunk (hunk longer than its header says?): " + header;
+				return false;
+			}
+			continue;  // "diff --git", "index" and anything before the first hunk
+		}
+		// "@@ -12,3 +12,4 @@": start and count per side (count defaults to 1)
+		String old_range = header.get_slicec(' ', 1).trim_prefix("-");
+		String new_range = header.get_slicec(' ', 2).trim_prefix("+");
+		int old_start = old_range.get_slicec(',', 0).to_int();
+		int old_remaining = old_range.contains(",") ? old_range.get_slicec(',', 1).to_int() : 1;
+		int new_remaining = new_range.contains(",") ? new_range.get_slicec(',', 1).to_int() : 1;
+		int first_line = old_remaining == 0 ? old_start + 1 : old_start;  // Pure insertions name the line before
+
+		String replacement;
+		int line = first_line;
+		char32_t last_kind = 0;
+		bool saw_marker = false;
+		bool old_unterminated = false;
+		bool new_unterminated = false;
+		while (i < diff_lines.size()) {
+			const String &diff_line = diff_lines[i];
+			char32_t kind = diff_line.is_empty() ? ' ' : diff_line[0];
+			if (kind == '\\') {
+				// Applies to the line before it, on the side(s) that line belongs to
+				i++;
+				saw_marker = true;
+				old_unterminated = old_unterminated || last_kind == ' ' || last_kind == '-';
+				new_unterminated = new_unterminated || last_kind == ' ' || last_kind == '+';
+				continue;
+			}
+			if (old_remaining <= 0 && new_remaining <= 0) {
+				break;
+			}
+			if (diff_line.begins_with("@@") || (diff_line.is_empty() && i == diff_lines.size() - 1)) {
+				r_error = "Hunk at line " + itos(first_line) + " is shorter than its header says";
+				return false;
+			}
+			i++;
+			String content = diff_line.substr(1);
+			if (kind != ' ' && kind != '-' && kind != '+') {
+				r_error = "Unexpected line in hunk at line " + itos(first_line) + ": " + diff_line;
+				return false;
+			}
+			if (kind == ' ' || kind == '-') {
+				if (line < 1 || line > lines.size() || lines[line - 1] != content || old_remaining <= 0) {
+					r_error = "Hunk at line " + itos(first_line) + " does not match line " + itos(line);
+					return false;
+				}
+				old_remaining--;
+				line++;
+			}
+			if (kind == ' ' || kind == '+') {
+				if (new_remaining <= 0) {
+					r_error = "Hunk at line " + itos(first_line) + " has more lines than its header says";
+					return false;
+				}
+				new_remaining--;
+				replacement += content + "\n";
+			}
+			last_kind = kind;
+		}
+
+		if (old_remaining > 0 || new_remaining > 0) {
+			r_error = "Hunk at line " + itos(first_line) + " is shorter than its header says";
+			return false;
+		}
+
+		bool at_eof = line > lines.size();
+		if (old_unterminated && (!at_eof || p_text.ends_with("\n"))) {
+			r_error = "Hunk at line " + itos(first_line) + " says the file has no final newline, but it does";
+			return false;
+		}
+
+		ScriptTextEdit edit;
+		edit.from = first_line <= lines.size() ? p_starts[first_line - 1] : p_text.length();
+		edit.to = at_eof ? p_text.length() : p_starts[line - 1];
+		bool drop_final_newline = saw_marker ? new_unterminated : (at_eof && !p_text.ends_with("\n"));  // Unmarked: keep what the file had
+		if (drop_final_newline && !replacement.is_empty()) {
+			replacement = replacement.substr(0, replacement.length() - 1);
+		}
+		edit.text = replacement;
+		r_edits.push_back(edit);
+	}
+	if (r_edits.is_empty()) {
+		r_error = "Diff has no hunks";
+		return false;
+	}
+	return true;
+}
+
+#ifdef TOOLS_ENABLED
+static CodeEdit *_find_open_script_buffer(const String &p_path) {
+	ScriptEditor *script_editor = ScriptEditor::get_singleton();
+	if (!script_editor) {
+		return nullptr;
+	}
+	Vector<ScriptEditorBase *> editors = script_editor->get_open_script_editors();
+	for (ScriptEditorBase *editor : editors) {
+		Ref<Resource> resource = editor->get_edited_resource();
+		if (resource.is_valid() && resource->get_path() == p_path) {
+			return Object::cast_to<CodeEdit>(editor->get_base_editor());
+		}
+	}
+	return nullptr;
+}
+#endif
+
+Dictionary GodotBridge::patch_script(const String &p_path, const Array &p_edits, const String &p_diff, const String &p_base_hash) {
+	Dictionary result;
+	
+	Ref<FileAccess> file = FileAccess::open(p_path, FileAccess::READ);
+	if (!file.is_valid()) {
+		result["error"] = "Cannot open file: " + p_path;
+		result["success"] = false;
+		return result;
+	}
+	// Hash the bytes as stored, so base_hash can come straight from read_file
+	Vector<uint8_t> bytes = file->get_buffer(file->get_length());
+	file.unref();
+	String hash = _bytes_md5(bytes.ptr(), bytes.size());
+	String text;
+	text.parse_utf8((const char *)bytes.ptr(), bytes.size());
+	if (!p_base_hash.is_empty() && p_base_hash != hash) {
+		result["error"] = "Script changed since it was read (base_hash mismatch)";
+		result["hash"] = hash;
+		result["conflict"] = true;
+		result["success"] = false;
+		return result;
+	}
+	
+	LocalVector<int> starts = _line_starts(text);
+	LocalVector<ScriptTextEdit> edits;
+	String error;
+	bool parsed = p_diff.is_empty() ? _parse_range_edits(p_edits, starts, text.length(), edits, error) : _parse_unified_diff(p_diff, text, starts, edits, error);
+	if (!parsed) {
+		result["error"] = error;
+		result["success"] = false;
+		return result;
+	}
+	
+	// Apply back to front so earlier offsets stay valid. The sort isn't stable,
+	// so ties go by request order: of two inserts at one offset, the later one
+	// is applied first and ends up after the earlier one.
+	for (uint32_t i = 0; i < edits.size(); i++) {
+		edits[i].order = i;
+	}
+	struct EditComparator {
+		bool operator()(const ScriptTextEdit &p_a, const ScriptTextEdit &p_b) const {
+			return p_a.from != p_b.from ? p_a.from > p_b.from : p_a.order > p_b.order;
+		}
+	};
+	edits.sort_custom<EditComparator>();
+	for (uint32_t i = 1; i < edits.size(); i++) {
+		if (edits[i].to > edits[i - 1].from) {
+			result["error"] = "Edits overlap";
+			result["success"] = false;
+			return result;
+		}
+	}
+	
+#ifdef TOOLS_ENABLED
+	CodeEdit *buffer = _find_open_script_buffer(p_path);
+	if (buffer && buffer->get_version() != buffer->get_saved_version()) {
+		result["error"] = "Script has unsaved changes in the script editor";
+		result["success"] = false;
+		return result;
+	}
+#endif
+	
+	String new_text = text;
+	for (const ScriptTextEdit &edit : edits) {
+		new_text = new_text.substr(0, edit.from) + edit.text + new_text.substr(edit.to);
+	}
+	
+	file = FileAccess::open(p_path, FileAccess::WRITE);
+	if (!file.is_valid()) {
+		result["error"] = "Cannot write file: " + p_path;
+		result["success"] = false;
+		return result;
+	}
+	file->store_string(new_text);
+	file.unref();
+	script_index.mark_dirty(p_path);
+	_invalidate_file_hash(p_path);
+	
+#ifdef TOOLS_ENABLED
+	if (buffer) {
+		if (buffer->get_text() == text) {
+			// Same edits on the buffer, as one undo step
+			buffer->begin_complex_operation();
+			for (const ScriptTextEdit &edit : edits) {
+				int from_line = 0, to_line = 0;
+				while (from_line + 1 < (int)starts.size() - 1 && starts[from_line + 1] <= edit.from) {
+					from_line++;
+				}
+				to_line = from_line;
+				while (to_line + 1 < (int)starts.size() - 1 && starts[to_line + 1] <= edit.to) {
+					to_line++;
+				}
+				buffer->remove_text(from_line, edit.from - starts[from_line], to_line, edit.to - starts[to_line]);
+				buffer->insert_text(edit.text, from_line, edit.from - starts[from_line]);
+			}
+			buffer->end_complex_operation();
+		} else {
+			buffer->set_text(new_text);  // Buffer normalized the text (line endings): replace it
+		}
+		buffer->tag_saved_version();
+	}
+	
+	// Reload just this script instead of rescanning the project
+	Ref<Script> script = ResourceCache::get_ref(p_path);
+	if (script.is_valid()) {
+		script->set_source_code(new_text);
+		script->reload(true);
+	}
+	EditorFileSystem *efs = EditorFileSystem::get_singleton();
+	if (efs) {
+		efs->update_file(p_path);
+	}
+#endif
+	
+	result["path"] = p_path;
+	CharString utf8 = new_text.utf8();
+	result["hash"] = _bytes_md5((const uint8_t *)utf8.get_data(), utf8.length());
+	result["edits_applied"] = edits.size();
+	result["success"] = true;
+	return result;
+}
+
 Dictionary GodotBridge::get_errors() {
 	Dictionary result;
 	Array errors;
@@ -143,94 +474,107 @@ void GodotBridge::_collect_node_warnings(Node *p_node, Array &r_warnings) {
 	}
 }
 
-Dictionary GodotBridge::search_in_scripts(const String &p_pattern, bool p_is_regex) {
+// Scans the index's candidate files line by line, resuming mid-file between
+// pages. Texts come from the in-memory index, but each fill still stops
+// after FILES_PER_FILL files so a rare regex yields short pages instead of
+// one long stall.
+class ScriptSearchStream : public BridgeResultStream {
+	static const int FILES_PER_FILL = 256;
+
+	String pattern;
+	Ref<RegEx> regex;
+	LocalVector<BridgeScriptIndex::Candidate> candidates;
+	uint32_t candidate_index = 0;
+	String current_path;
+	PackedStringArray current_lines;
+	int line_index = 0;
+	int files_searched = 0;
+	int indexed_files = 0;
+
+	bool _line_matches(const String &p_line) const {
+		if (regex.is_valid()) {
+			return regex->search(p_line).is_valid();
+		}
+		return p_line.find(pattern) != -1;
+	}
+
+public:
+	virtual bool fill(int p_max, Array &r_items) override {
+		int files_opened = 0;
+		while (r_items.size() < p_max) {
+			if (line_index >= current_lines.size()) {
+				if (files_opened >= FILES_PER_FILL || candidate_index >= candidates.size()) {
+					break;
+				}
+				BridgeScriptIndex::Candidate &candidate = candidates[candidate_index++];
+				files_opened++;
+				files_searched++;
+				line_index = 0;
+				current_path = candidate.path;
+				current_lines = candidate.text.split("\n");
+				candidate.text = String();  // Release our reference early
+				continue;
+			}
+
+			const String &line = current_lines[line_index++];
+			if (_line_matches(line)) {
+				Dictionary match;
+				match["file"] = current_path;
+				match["line_number"] = line_index;
+				match["line_content"] = line.strip_edges();
+				r_items.push_back(match);
+			}
+		}
+		return line_index < current_lines.size() || candidate_index < candidates.size();
+	}
+
+	virtual void get_page_info(Dictionary &r_info) const override {
+		r_info["files_searched"] = files_searched;
+		r_info["candidate_files"] = candidates.size();
+		r_info["indexed_files"] = indexed_files;
+	}
+
+	ScriptSearchStream(const String &p_pattern, const Ref<RegEx> &p_regex, const BridgeScriptIndex &p_index) :
+			pattern(p_pattern), regex(p_regex) {
+		// Regexes can't be narrowed by trigrams, so they scan every indexed file
+		p_index.find_candidates(p_regex.is_valid() ? String() : p_pattern, candidates);
+		indexed_files = p_index.get_file_count();
+	}
+};
+
+// Matches are paginated: the first p_page_size come back with the response,
+// and "cursor" fetches the rest via next_page (or "stream": true pushes them).
+Dictionary GodotBridge::search_in_scripts(const String &p_pattern, bool p_is_regex, int p_page_size) {
 	Dictionary result;
-	Array matches;
 	
-	// Recursively search all .gd files in res://
-	Ref<DirAccess> dir = DirAccess::open("res://");
-	if (!dir.is_valid()) {
+	if (!DirAccess::dir_exists_absolute("res://")) {
 		result["error"] = "Cannot access project directory";
 		result["success"] = false;
 		return result;
 	}
 	
-	// Simple recursive search
-	Vector<String> script_paths;
-	Vector<String> dirs_to_search;
-	dirs_to_search.push_back("res://");
-	
-	while (dirs_to_search.size() > 0) {
-		String current_dir = dirs_to_search[0];
-		dirs_to_search.remove_at(0);
-		
-		Ref<DirAccess> d = DirAccess::open(current_dir);
-		if (!d.is_valid()) continue;
-		
-		d->list_dir_begin();
-		String item = d->get_next();
-		while (!item.is_empty()) {
-			if (item != "." && item != "..") {
-				String full_path = current_dir.path_join(item);
-				if (d->current_is_dir()) {
-					dirs_to_search.push_back(full_path);
-				} else if (item.ends_with(".gd")) {
-					script_paths.push_back(full_path);
-				}
-			}
-			item = d->get_next();
-		}
-		d->list_dir_end();
-	}
-	
-	// Search each script
-	for (int i = 0; i < script_paths.size(); i++) {
-		String path = script_paths[i];
-		Ref<FileAccess> file = FileAccess::open(path, FileAccess::READ);
-		if (!file.is_valid()) continue;
-		
-		String content = file->get_as_text();
-		PackedStringArray lines = content.split("\n");
-		
-		for (int line_num = 0; line_num < lines.size(); line_num++) {
-			String line = lines[line_num];
-			bool found = false;
-			
-			if (p_is_regex) {
-				RegEx regex;
-				regex.compile(p_pattern);
-				if (regex.search(line).is_valid()) {
-					found = true;
-				}
-			} else {
-				if (line.find(p_pattern) != -1) {
-					found = true;
-				}
-			}
-			
-			if (found) {
-				Dictionary match;
-				match["file"] = path;
-				match["line_number"] = line_num + 1;
-				match["line_content"] = line.strip_edges();
-				matches.push_back(match);
-				
-				// Limit matches to prevent overwhelming results
-				if (matches.size() >= 50) {
-					result["truncated"] = true;
-					break;
-				}
-			}
+	// Compile once for the whole search rather than per line
+	Ref<RegEx> regex;
+	if (p_is_regex) {
+		regex.instantiate();
+		if (regex->compile(p_pattern) != OK) {
+			result["error"] = "Invalid regex: " + p_pattern;
+			result["success"] = false;
+			return result;
 		}
-		
-		if (matches.size() >= 50) break;
 	}
 	
+	// Re-reads only scripts changed since the last search. If another search
+	// is already syncing, this one uses the index as it stands.
+	bool index_current = script_index.sync();
+	
 	result["pattern"] = p_pattern;
 	result["is_regex"] = p_is_regex;
-	result["matches"] = matches;
-	result["count"] = matches.size();
-	result["files_searched"] = script_paths.size();
+	if (!index_current) {
+		result["index_stale"] = true;
+	}
+	_page_result(result, "matches", memnew(ScriptSearchStream(p_pattern, regex, script_index)), p_page_size);
+	result["truncated"] = result["has_more"];
 	result["success"] = true;
 	
 	return result;
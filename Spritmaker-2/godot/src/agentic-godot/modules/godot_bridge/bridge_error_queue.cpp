@@ -0,0 +1,69 @@
+// bridge_error_queue.cpp
+// Lock-free queue that carries runtime errors from any thread to GodotBridge
+
+#include "bridge_error_queue.h"
+
+// Bounded copy that always terminates the destination
+static void _copy_text(char *r_dst, int p_size, const char *p_src) {
+	int i = 0;
+	if (p_src) {
+		for (; i < p_size - 1 && p_src[i]; i++) {
+			r_dst[i] = p_src[i];
+		}
+	}
+	r_dst[i] = '\0';
+}
+
+bool BridgeErrorQueue::push(const char *p_function, const char *p_file, int p_line, const char *p_error, const char *p_errorexp, bool p_warning, bool p_main_thread, uint64_t p_timestamp_msec) {
+	// Reserve room before taking a ticket, so a ticket is never abandoned and
+	// the consumer never waits on a hole
+	if (reserved.postincrement() >= CAPACITY) {
+		reserved.decrement();
+		dropped.increment();
+		return false;
+	}
+	uint32_t pos = enqueue_pos.postincrement();
+	Slot *slot = &slots[pos & (CAPACITY - 1)];
+
+	Entry &entry = slot->entry;
+	_copy_text(entry.function, FUNCTION_SIZE, p_function);
+	_copy_text(entry.file, FILE_SIZE, p_file);
+	_copy_text(entry.error, TEXT_SIZE, p_error);
+	_copy_text(entry.errorexp, TEXT_SIZE, p_errorexp);
+	entry.line = p_line;
+	entry.warning = p_warning;
+	entry.main_thread = p_main_thread;
+	entry.timestamp_msec = p_timestamp_msec;
+
+	// Publish to the consumer
+	slot->sequence.set(pos + 1);
+	return true;
+}
+
+bool BridgeErrorQueue::pop(Entry &r_entry) {
+	uint32_t pos = dequeue_pos.get();
+	Slot &slot = slots[pos & (CAPACITY - 1)];
+	if (slot.sequence.get() != pos + 1) {
+		return false;  // Empty, or the producer is still copying
+	}
+
+	r_entry = slot.entry;
+	dequeue_pos.set(pos + 1);
+	// Hand the slot back to producers
+	reserved.decrement();
+	return true;
+}
+
+uint32_t BridgeErrorQueue::take_dropped() {
+	// Drops counted meanwhile stay for the next call
+	uint32_t count = dropped.get();
+	dropped.sub(count);
+	return count;
+}
+
+BridgeErrorQueue::BridgeErrorQueue() {
+	// Slot i's first ticket is i; nothing is published until sequence is i + 1
+	for (uint32_t i = 0; i < CAPACITY; i++) {
+		slots[i].sequence.set(i);
+	}
+}
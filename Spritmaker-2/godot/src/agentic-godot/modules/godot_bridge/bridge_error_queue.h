@@ -0,0 +1,53 @@
+#ifndef BRIDGE_ERROR_QUEUE_H
+#define BRIDGE_ERROR_QUEUE_H
+
+#include "core/templates/safe_refcount.h"
+#include "core/typedefs.h"
+
+// Bounded lock-free multi-producer queue for errors reported by any thread,
+// drained by the main thread only. A producer first reserves room (at most
+// CAPACITY entries are pushed but not popped), then takes the next ticket;
+// the reservation guarantees that ticket's slot was already popped. Producers
+// copy the error text into preallocated slots, so the error path never
+// allocates or locks. When the queue is full the error is counted as dropped.
+class BridgeErrorQueue {
+public:
+	static const uint32_t CAPACITY = 256;  // Must be a power of two
+	static const int FUNCTION_SIZE = 128;
+	static const int FILE_SIZE = 256;
+	static const int TEXT_SIZE = 512;
+
+	struct Entry {
+		char function[FUNCTION_SIZE];
+		char file[FILE_SIZE];
+		char error[TEXT_SIZE];
+		char errorexp[TEXT_SIZE];
+		int line = 0;
+		bool warning = false;
+		bool main_thread = false;
+		uint64_t timestamp_msec = 0;
+	};
+
+private:
+	struct Slot {
+		SafeNumeric<uint32_t> sequence;  // Ticket + 1 once the entry is published
+		Entry entry;
+	};
+
+	Slot slots[CAPACITY];
+	SafeNumeric<uint32_t> reserved;  // Pushed or being pushed, not yet popped
+	SafeNumeric<uint32_t> enqueue_pos;
+	SafeNumeric<uint32_t> dequeue_pos;
+	SafeNumeric<uint32_t> dropped;
+
+public:
+	// Safe from any thread, including inside the error handler
+	bool push(const char *p_function, const char *p_file, int p_line, const char *p_error, const char *p_errorexp, bool p_warning, bool p_main_thread, uint64_t p_timestamp_msec);
+	// Main thread only
+	bool pop(Entry &r_entry);
+	uint32_t take_dropped();
+
+	BridgeErrorQueue();
+};
+
+#endif // BRIDGE_ERROR_QUEUE_H
@@ -0,0 +1,215 @@
+// bridge_line_diff.cpp
+// Myers line diff for the AI panel's Diff tab
+
+#include "bridge_line_diff.h"
+#include "core/templates/hash_map.h"
+
+enum DiffOp : uint8_t {
+	OP_EQUAL,
+	OP_DELETE,
+	OP_INSERT,
+};
+
+// Furthest-reaching x values start out unset
+static const int UNREACHED = -1;
+
+void BridgeLineDiff::_intern(const PackedStringArray &p_before, const PackedStringArray &p_after, LocalVector<int> &r_before, LocalVector<int> &r_after) {
+	HashMap<String, int> ids;
+	r_before.resize(p_before.size());
+	r_after.resize(p_after.size());
+	for (int i = 0; i < p_before.size(); i++) {
+		const int *id = ids.getptr(p_before[i]);
+		r_before[i] = id ? *id : ids.insert(p_before[i], ids.size())->value;
+	}
+	for (int i = 0; i < p_after.size(); i++) {
+		const int *id = ids.getptr(p_after[i]);
+		r_after[i] = id ? *id : ids.insert(p_after[i], ids.size())->value;
+	}
+}
+
+// Greedy forward Myers keeping every round's V for the backtrack. Moves that
+// would leave the edit grid are never taken, so every V entry is a real
+// point and the path ends exactly at (n, m).
+bool BridgeLineDiff::_myers(const int *p_a, int p_n, const int *p_b, int p_m, int p_max_edit, LocalVector<uint8_t> &r_ops) {
+	int max_d = MIN(p_n + p_m, p_max_edit);
+	int offset = max_d + 1;
+	LocalVector<int> v;
+	v.resize(2 * max_d + 3);
+	for (uint32_t i = 0; i < v.size(); i++) {
+		v[i] = UNREACHED;
+	}
+	v[offset + 1] = 0;  // Virtual start just above (0, 0)
+
+	// trace holds v[-d-1 .. d+1] as it was at the start of round d
+	LocalVector<int> trace;
+	LocalVector<uint32_t> trace_start;
+	int found_d = -1;
+
+	for (int d = 0; d <= max_d && found_d < 0; d++) {
+		trace_start.push_back(trace.size());
+		for (int k = -d - 1; k <= d + 1; k++) {
+			trace.push_back(v[offset + k]);
+		}
+
+		for (int k = -d; k <= d; k += 2) {
+			int down_x = v[offset + k + 1];
+			bool down_ok = down_x != UNREACHED && down_x - k <= p_m;
+			int right_x = v[offset + k - 1] != UNREACHED ? v[offset + k - 1] + 1 : UNREACHED;
+			bool right_ok = right_x != UNREACHED && right_x <= p_n;
+			if (!down_ok && !right_ok) {
+				v[offset + k] = UNREACHED;
+				continue;
+			}
+
+			int x = (down_ok && (!right_ok || right_x <= down_x)) ? down_x : right_x;
+			int y = x - k;
+			while (x < p_n && y < p_m && p_a[x] == p_b[y]) {
+				x++;
+				y++;
+			}
+			v[offset + k] = x;
+			if (x == p_n && y == p_m) {
+				found_d = d;
+				break;
+			}
+		}
+	}
+
+	if (found_d < 0) {
+		return false;
+	}
+
+	// Walk back from (n, m), repeating each round's choice. Ops come out reversed.
+	LocalVector<uint8_t> reversed;
+	int x = p_n;
+	int y = p_m;
+	for (int d = found_d; d > 0; d--) {
+		const int *tv = trace.ptr() + trace_start[d] + d + 1;  // tv[k] == v[k] before round d
+		int k = x - y;
+		int down_x = tv[k + 1];
+		bool down_ok = down_x != UNREACHED && down_x - k <= p_m;
+		int right_x = tv[k - 1] != UNREACHED ? tv[k - 1] + 1 : UNREACHED;
+		bool right_ok = right_x != UNREACHED && right_x <= p_n;
+		bool down = down_ok && (!right_ok || right_x <= down_x);
+
+		int prev_k = down ? k + 1 : k - 1;
+		int prev_x = tv[prev_k];
+		int prev_y = prev_x - prev_k;
+		int mid_x = down ? prev_x : prev_x + 1;
+		for (; x > mid_x; x--) {
+			reversed.push_back(OP_EQUAL);
+		}
+		reversed.push_back(down ? OP_INSERT : OP_DELETE);
+		x = prev_x;
+		y = prev_y;
+	}
+	for (; x > 0; x--) {
+		reversed.push_back(OP_EQUAL);
+	}
+
+	for (int i = int(reversed.size()) - 1; i >= 0; i--) {
+		r_ops.push_back(reversed[i]);
+	}
+	return true;
+}
+
+void BridgeLineDiff::diff(const String &p_before, const String &p_after, Result &r_result, int p_max_edit) {
+	r_result = Result();
+	r_result.before_lines = p_before.split("\n");
+	r_result.after_lines = p_after.split("\n");
+
+	LocalVector<int> a;
+	LocalVector<int> b;
+	_intern(r_result.before_lines, r_result.after_lines, a, b);
+	int n = a.size();
+	int m = b.size();
+
+	// Most agent edits touch a small region; strip what is identical around it
+	int prefix = 0;
+	while (prefix < n && prefix < m && a[prefix] == b[prefix]) {
+		prefix++;
+	}
+	int suffix = 0;
+	while (suffix < n - prefix && suffix < m - prefix && a[n - 1 - suffix] == b[m - 1 - suffix]) {
+		suffix++;
+	}
+
+	LocalVector<uint8_t> ops;
+	for (int i = 0; i < prefix; i++) {
+		ops.push_back(OP_EQUAL);
+	}
+	int mid_n = n - prefix - suffix;
+	int mid_m = m - prefix - suffix;
+	if (!_myers(a.ptr() + prefix, mid_n, b.ptr() + prefix, mid_m, p_max_edit, ops)) {
+		r_result.capped = true;
+		for (int i = 0; i < mid_n; i++) {
+			ops.push_back(OP_DELETE);
+		}
+		for (int i = 0; i < mid_m; i++) {
+			ops.push_back(OP_INSERT);
+		}
+	}
+	for (int i = 0; i < suffix; i++) {
+		ops.push_back(OP_EQUAL);
+	}
+
+	// Group runs of changes into hunks
+	int i = 0;
+	int j = 0;
+	Hunk *hunk = nullptr;
+	for (uint32_t o = 0; o < ops.size(); o++) {
+		if (ops[o] == OP_EQUAL) {
+			hunk = nullptr;
+			i++;
+			j++;
+			continue;
+		}
+		if (!hunk) {
+			r_result.hunks.push_back(Hunk());
+			hunk = &r_result.hunks[r_result.hunks.size() - 1];
+			hunk->before_start = i;
+			hunk->after_start = j;
+		}
+		if (ops[o] == OP_DELETE) {
+			hunk->before_count++;
+			r_result.removed++;
+			i++;
+		} else {
+			hunk->after_count++;
+			r_result.added++;
+			j++;
+		}
+	}
+}
+
+String BridgeLineDiff::format_preview(const Result &p_result, int p_max_change_lines) {
+	if (p_result.hunks.is_empty()) {
+		return "No line-level differences detected.";
+	}
+
+	String preview;
+	if (p_result.capped) {
+		preview += "(large change: shown as one replaced block)\n";
+	}
+
+	int emitted_lines = 0;
+	for (const Hunk &hunk : p_result.hunks) {
+		if (emitted_lines >= p_max_change_lines) {
+			break;
+		}
+		preview += "@@ -" + itos(hunk.before_start + 1) + "," + itos(hunk.before_count) + " +" + itos(hunk.after_start + 1) + "," + itos(hunk.after_count) + " @@\n";
+		for (int i = 0; i < hunk.before_count && emitted_lines < p_max_change_lines; i++, emitted_lines++) {
+			int line = hunk.before_start + i;
+			preview += "- " + itos(line + 1) + ": " + p_result.before_lines[line] + "\n";
+		}
+		for (int i = 0; i < hunk.after_count && emitted_lines < p_max_change_lines; i++, emitted_lines++) {
+			int line = hunk.after_start + i;
+			preview += "+ " + itos(line + 1) + ": " + p_result.after_lines[line] + "\n";
+		}
+	}
+	if (emitted_lines < p_result.added + p_result.removed) {
+		preview += "... (diff truncated)\n";
+	}
+
+	return preview;
+}
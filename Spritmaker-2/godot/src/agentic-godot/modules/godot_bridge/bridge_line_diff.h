@@ -0,0 +1,44 @@
+#ifndef BRIDGE_LINE_DIFF_H
+#define BRIDGE_LINE_DIFF_H
+
+#include "core/string/ustring.h"
+#include "core/templates/local_vector.h"
+
+// Line diff behind the AI panel's Diff tab previews. Lines are interned to
+// integer ids through a hash map so comparisons are O(1), the common prefix
+// and suffix are stripped, and the rest goes through Myers' O(ND) algorithm.
+// The edit distance is capped: past the cap the remaining middle is reported
+// as one replaced block instead of burning time and memory on a huge script.
+// Pure computation with no shared state, so it is safe on any thread.
+class BridgeLineDiff {
+public:
+	struct Hunk {
+		int before_start = 0;  // 0-based
+		int before_count = 0;
+		int after_start = 0;
+		int after_count = 0;
+	};
+
+	struct Result {
+		PackedStringArray before_lines;
+		PackedStringArray after_lines;
+		LocalVector<Hunk> hunks;
+		int added = 0;
+		int removed = 0;
+		bool capped = false;  // Edit distance exceeded the cap
+	};
+
+	static const int DEFAULT_MAX_EDIT = 1024;
+
+	static void diff(const String &p_before, const String &p_after, Result &r_result, int p_max_edit = DEFAULT_MAX_EDIT);
+
+	// "@@ -a,b +c,d @@" headers followed by "- N: line" / "+ N: line" rows,
+	// stopping after p_max_change_lines changed lines.
+	static String format_preview(const Result &p_result, int p_max_change_lines);
+
+private:
+	static void _intern(const PackedStringArray &p_before, const PackedStringArray &p_after, LocalVector<int> &r_before, LocalVector<int> &r_after);
+	static bool _myers(const int *p_a, int p_n, const int *p_b, int p_m, int p_max_edit, LocalVector<uint8_t> &r_ops);
+};
+
+#endif // BRIDGE_LINE_DIFF_H
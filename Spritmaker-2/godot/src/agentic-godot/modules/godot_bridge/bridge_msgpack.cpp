@@ -0,0 +1,375 @@
+// bridge_msgpack.cpp
+// MessagePack encoding/decoding for the bridge wire protocol
+
+#include "bridge_msgpack.h"
+#include "core/io/marshalls.h"
+
+static const int MSGPACK_MAX_DEPTH = 128;
+
+// ============ Big-endian helpers ============
+
+static void _put_u8(Vector<uint8_t> &r_buffer, uint8_t p_value) {
+	r_buffer.push_back(p_value);
+}
+
+static void _put_be(Vector<uint8_t> &r_buffer, uint64_t p_value, int p_bytes) {
+	int pos = r_buffer.size();
+	r_buffer.resize(pos + p_bytes);
+	uint8_t *w = r_buffer.ptrw() + pos;
+	for (int i = p_bytes - 1; i >= 0; i--) {
+		w[i] = p_value & 0xFF;
+		p_value >>= 8;
+	}
+}
+
+static uint64_t _get_be(const uint8_t *p_data, int p_bytes) {
+	uint64_t value = 0;
+	for (int i = 0; i < p_bytes; i++) {
+		value = (value << 8) | p_data[i];
+	}
+	return value;
+}
+
+static void _put_bytes(Vector<uint8_t> &r_buffer, const uint8_t *p_data, int p_size) {
+	int pos = r_buffer.size();
+	r_buffer.resize(pos + p_size);
+	memcpy(r_buffer.ptrw() + pos, p_data, p_size);
+}
+
+// Header for str/bin/array/map families: fix form (if any), then 8/16/32-bit lengths
+static void _put_length_header(Vector<uint8_t> &r_buffer, uint32_t p_length, int p_fix_base, uint32_t p_fix_max, int p_op8, int p_op16, int p_op32) {
+	if (p_fix_base >= 0 && p_length <= p_fix_max) {
+		_put_u8(r_buffer, uint8_t(p_fix_base | p_length));
+	} else if (p_op8 >= 0 && p_length <= 0xFF) {
+		_put_u8(r_buffer, p_op8);
+		_put_be(r_buffer, p_length, 1);
+	} else if (p_length <= 0xFFFF) {
+		_put_u8(r_buffer, p_op16);
+		_put_be(r_buffer, p_length, 2);
+	} else {
+		_put_u8(r_buffer, p_op32);
+		_put_be(r_buffer, p_length, 4);
+	}
+}
+
+static void _put_int(Vector<uint8_t> &r_buffer, int64_t p_value) {
+	if (p_value >= 0) {
+		if (p_value < 128) {
+			_put_u8(r_buffer, uint8_t(p_value));
+		} else if (p_value <= 0xFF) {
+			_put_u8(r_buffer, 0xcc);
+			_put_be(r_buffer, p_value, 1);
+		} else if (p_value <= 0xFFFF) {
+			_put_u8(r_buffer, 0xcd);
+			_put_be(r_buffer, p_value, 2);
+		} else if (p_value <= 0xFFFFFFFFLL) {
+			_put_u8(r_buffer, 0xce);
+			_put_be(r_buffer, p_value, 4);
+		} else {
+			_put_u8(r_buffer, 0xcf);
+			_put_be(r_buffer, p_value, 8);
+		}
+	} else if (p_value >= -32) {
+		_put_u8(r_buffer, uint8_t(0xe0 | (p_value + 32)));
+	} else if (p_value >= -128) {
+		_put_u8(r_buffer, 0xd0);
+		_put_be(r_buffer, uint64_t(p_value), 1);
+	} else if (p_value >= -32768) {
+		_put_u8(r_buffer, 0xd1);
+		_put_be(r_buffer, uint64_t(p_value), 2);
+	} else if (p_value >= INT32_MIN) {
+		_put_u8(r_buffer, 0xd2);
+		_put_be(r_buffer, uint64_t(p_value), 4);
+	} else {
+		_put_u8(r_buffer, 0xd3);
+		_put_be(r_buffer, uint64_t(p_value), 8);
+	}
+}
+
+static void _put_float(Vector<uint8_t> &r_buffer, double p_value) {
+	uint64_t bits;
+	memcpy(&bits, &p_value, sizeof(bits));
+	_put_u8(r_buffer, 0xcb);
+	_put_be(r_buffer, bits, 8);
+}
+
+static void _put_string(Vector<uint8_t> &r_buffer, const String &p_value) {
+	CharString utf8 = p_value.utf8();
+	_put_length_header(r_buffer, utf8.length(), 0xa0, 31, 0xd9, 0xda, 0xdb);
+	_put_bytes(r_buffer, (const uint8_t *)utf8.get_data(), utf8.length());
+}
+
+// ============ Encoding ============
+
+void BridgeMsgPack::encode(const Variant &p_value, Vector<uint8_t> &r_buffer) {
+	_encode_value(p_value, r_buffer, 0);
+}
+
+void BridgeMsgPack::_encode_value(const Variant &p_value, Vector<uint8_t> &r_buffer, int p_depth) {
+	if (p_depth > MSGPACK_MAX_DEPTH) {
+		_put_u8(r_buffer, 0xc0);
+		return;
+	}
+
+	switch (p_value.get_type()) {
+		case Variant::NIL: {
+			_put_u8(r_buffer, 0xc0);
+		} break;
+		case Variant::BOOL: {
+			_put_u8(r_buffer, bool(p_value) ? 0xc3 : 0xc2);
+		} break;
+		case Variant::INT: {
+			_put_int(r_buffer, int64_t(p_value));
+		} break;
+		case Variant::FLOAT: {
+			_put_float(r_buffer, double(p_value));
+		} break;
+		case Variant::STRING:
+		case Variant::STRING_NAME: {
+			_put_string(r_buffer, p_value);
+		} break;
+		case Variant::PACKED_BYTE_ARRAY: {
+			PackedByteArray bytes = p_value;
+			_put_length_header(r_buffer, bytes.size(), -1, 0, 0xc4, 0xc5, 0xc6);
+			_put_bytes(r_buffer, bytes.ptr(), bytes.size());
+		} break;
+		case Variant::ARRAY:
+		case Variant::PACKED_INT32_ARRAY:
+		case Variant::PACKED_INT64_ARRAY:
+		case Variant::PACKED_FLOAT32_ARRAY:
+		case Variant::PACKED_FLOAT64_ARRAY:
+		case Variant::PACKED_STRING_ARRAY: {
+			Array arr = p_value;
+			_put_length_header(r_buffer, arr.size(), 0x90, 15, -1, 0xdc, 0xdd);
+			for (int i = 0; i < arr.size(); i++) {
+				_encode_value(arr[i], r_buffer, p_depth + 1);
+			}
+		} break;
+		case Variant::DICTIONARY: {
+			Dictionary dict = p_value;
+			_put_length_header(r_buffer, dict.size(), 0x80, 15, -1, 0xde, 0xdf);
+			for (const KeyValue<Variant, Variant> &kv : dict) {
+				_encode_value(kv.key, r_buffer, p_depth + 1);
+				_encode_value(kv.value, r_buffer, p_depth + 1);
+			}
+		} break;
+		default: {
+			// Godot-specific type: ext(Variant::Type, encode_variant bytes)
+			int len = 0;
+			if (encode_variant(p_value, nullptr, len, false) != OK) {
+				_put_u8(r_buffer, 0xc0);
+				break;
+			}
+			_put_length_header(r_buffer, len, -1, 0, 0xc7, 0xc8, 0xc9);
+			_put_u8(r_buffer, uint8_t(p_value.get_type()));
+			int pos = r_buffer.size();
+			r_buffer.resize(pos + len);
+			encode_variant(p_value, r_buffer.ptrw() + pos, len, false);
+		} break;
+	}
+}
+
+// ============ Decoding ============
+
+Error BridgeMsgPack::decode(const uint8_t *p_data, int p_size, Variant &r_value) {
+	int pos = 0;
+	Error err = _decode_value(p_data, p_size, pos, r_value, 0);
+	if (err == OK && pos != p_size) {
+		return ERR_INVALID_DATA;
+	}
+	return err;
+}
+
+#define MSGPACK_NEED(n)                   \
+	if (p_size - r_pos < (n)) {           \
+		return ERR_FILE_EOF;              \
+	}
+
+Error BridgeMsgPack::_decode_value(const uint8_t *p_data, int p_size, int &r_pos, Variant &r_value, int p_depth) {
+	ERR_FAIL_COND_V(p_depth > MSGPACK_MAX_DEPTH, ERR_OUT_OF_MEMORY);
+	MSGPACK_NEED(1);
+	uint8_t op = p_data[r_pos++];
+
+	// Fixed-size forms
+	if (op <= 0x7f) {
+		r_value = int64_t(op);
+		return OK;
+	}
+	if (op >= 0xe0) {
+		r_value = int64_t(int8_t(op));
+		return OK;
+	}
+
+	uint32_t length = 0;
+	enum { KIND_NONE, KIND_STR, KIND_BIN, KIND_ARRAY, KIND_MAP, KIND_EXT } kind = KIND_NONE;
+
+	if (op >= 0x80 && op <= 0x8f) {
+		kind = KIND_MAP;
+		length = op & 0x0f;
+	} else if (op >= 0x90 && op <= 0x9f) {
+		kind = KIND_ARRAY;
+		length = op & 0x0f;
+	} else if (op >= 0xa0 && op <= 0xbf) {
+		kind = KIND_STR;
+		length = op & 0x1f;
+	} else {
+		switch (op) {
+			case 0xc0:
+				r_value = Variant();
+				return OK;
+			case 0xc2:
+				r_value = false;
+				return OK;
+			case 0xc3:
+				r_value = true;
+				return OK;
+			case 0xca: {
+				MSGPACK_NEED(4);
+				uint32_t bits = _get_be(p_data + r_pos, 4);
+				float f;
+				memcpy(&f, &bits, sizeof(f));
+				r_pos += 4;
+				r_value = f;
+				return OK;
+			}
+			case 0xcb: {
+				MSGPACK_NEED(8);
+				uint64_t bits = _get_be(p_data + r_pos, 8);
+				double d;
+				memcpy(&d, &bits, sizeof(d));
+				r_pos += 8;
+				r_value = d;
+				return OK;
+			}
+			case 0xcc:
+			case 0xcd:
+			case 0xce:
+			case 0xcf: {
+				int bytes = 1 << (op - 0xcc);
+				MSGPACK_NEED(bytes);
+				r_value = int64_t(_get_be(p_data + r_pos, bytes));
+				r_pos += bytes;
+				return OK;
+			}
+			case 0xd0:
+			case 0xd1:
+			case 0xd2:
+			case 0xd3: {
+				int bytes = 1 << (op - 0xd0);
+				MSGPACK_NEED(bytes);
+				uint64_t raw = _get_be(p_data + r_pos, bytes);
+				r_pos += bytes;
+				// Sign-extend from the encoded width
+				int shift = 64 - bytes * 8;
+				r_value = int64_t(raw << shift) >> shift;
+				return OK;
+			}
+			case 0xd4:
+			case 0xd5:
+			case 0xd6:
+			case 0xd7:
+			case 0xd8:
+				kind = KIND_EXT;
+				length = 1 << (op - 0xd4);
+				break;
+			case 0xc4:
+			case 0xc5:
+			case 0xc6:
+			case 0xc7:
+			case 0xc8:
+			case 0xc9:
+			case 0xd9:
+			case 0xda:
+			case 0xdb:
+			case 0xdc:
+			case 0xdd:
+			case 0xde:
+			case 0xdf: {
+				static const int widths[] = { 1, 2, 4, 1, 2, 4 };
+				int width;
+				if (op <= 0xc6) {
+					kind = KIND_BIN;
+					width = widths[op - 0xc4];
+				} else if (op <= 0xc9) {
+					kind = KIND_EXT;
+					width = widths[op - 0xc4];
+				} else if (op <= 0xdb) {
+					kind = KIND_STR;
+					width = widths[op - 0xd9];
+				} else if (op <= 0xdd) {
+					kind = KIND_ARRAY;
+					width = (op == 0xdc) ? 2 : 4;
+				} else {
+					kind = KIND_MAP;
+					width = (op == 0xde) ? 2 : 4;
+				}
+				MSGPACK_NEED(width);
+				length = _get_be(p_data + r_pos, width);
+				r_pos += width;
+			} break;
+			default:
+				return ERR_INVALID_DATA;
+		}
+	}
+
+	switch (kind) {
+		case KIND_STR: {
+			MSGPACK_NEED((int64_t)length);
+			r_value = String::utf8((const char *)p_data + r_pos, length);
+			r_pos += length;
+		} break;
+		case KIND_BIN: {
+			MSGPACK_NEED((int64_t)length);
+			PackedByteArray bytes;
+			bytes.resize(length);
+			memcpy(bytes.ptrw(), p_data + r_pos, length);
+			r_pos += length;
+			r_value = bytes;
+		} break;
+		case KIND_ARRAY: {
+			Array arr;
+			for (uint32_t i = 0; i < length; i++) {
+				Variant item;
+				Error err = _decode_value(p_data, p_size, r_pos, item, p_depth + 1);
+				if (err != OK) {
+					return err;
+				}
+				arr.push_back(item);
+			}
+			r_value = arr;
+		} break;
+		case KIND_MAP: {
+			Dictionary dict;
+			for (uint32_t i = 0; i < length; i++) {
+				Variant key;
+				Variant value;
+				Error err = _decode_value(p_data, p_size, r_pos, key, p_depth + 1);
+				if (err == OK) {
+					err = _decode_value(p_data, p_size, r_pos, value, p_depth + 1);
+				}
+				if (err != OK) {
+					return err;
+				}
+				dict[key] = value;
+			}
+			r_value = dict;
+		} break;
+		case KIND_EXT: {
+			MSGPACK_NEED((int64_t)length + 1);
+			int8_t ext_type = int8_t(p_data[r_pos++]);
+			if (ext_type < 0 || ext_type >= Variant::VARIANT_MAX) {
+				return ERR_INVALID_DATA;
+			}
+			Error err = decode_variant(r_value, p_data + r_pos, length, nullptr, false);
+			if (err != OK) {
+				return err;
+			}
+			r_pos += length;
+		} break;
+		default:
+			return ERR_INVALID_DATA;
+	}
+	return OK;
+}
+
+#undef MSGPACK_NEED
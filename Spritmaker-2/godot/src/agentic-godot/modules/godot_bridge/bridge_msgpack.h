@@ -0,0 +1,23 @@
+#ifndef BRIDGE_MSGPACK_H
+#define BRIDGE_MSGPACK_H
+
+#include "core/variant/variant.h"
+#include "core/templates/vector.h"
+
+// Minimal MessagePack codec for the bridge wire protocol.
+// Nil, bool, int, float, String, Array, Dictionary and PackedByteArray map to
+// native MessagePack types (byte arrays as bin, so no base64). Every other
+// Variant type is sent as an ext value whose type code is the Variant::Type and
+// whose payload is Godot's encode_variant() bytes, so Vector2i, Color and
+// friends survive the round trip.
+class BridgeMsgPack {
+public:
+	static void encode(const Variant &p_value, Vector<uint8_t> &r_buffer);
+	static Error decode(const uint8_t *p_data, int p_size, Variant &r_value);
+
+private:
+	static void _encode_value(const Variant &p_value, Vector<uint8_t> &r_buffer, int p_depth);
+	static Error _decode_value(const uint8_t *p_data, int p_size, int &r_pos, Variant &r_value, int p_depth);
+};
+
+#endif // BRIDGE_MSGPACK_H
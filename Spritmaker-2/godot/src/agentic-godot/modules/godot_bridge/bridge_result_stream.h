@@ -0,0 +1,45 @@
+#ifndef BRIDGE_RESULT_STREAM_H
+#define BRIDGE_RESULT_STREAM_H
+
+#include "core/variant/array.h"
+#include "core/variant/dictionary.h"
+
+// Resumable producer behind a paginated bridge result. Commands that can
+// return large lists wrap their walk in a stream; the bridge keeps it behind a
+// cursor and pulls one page at a time, so results never have to be built in
+// full. A stream is only ever filled by one thread at a time.
+class BridgeResultStream {
+public:
+	virtual ~BridgeResultStream() {}
+
+	// Append up to p_max items to r_items. Returns true while more items may follow.
+	virtual bool fill(int p_max, Array &r_items) = 0;
+
+	// Extra fields merged into every page (e.g. progress counters)
+	virtual void get_page_info(Dictionary &r_info) const {}
+};
+
+// Stream over an already built array (for results that are cheap to compute
+// but still too large to send in one message)
+class BridgeArrayStream : public BridgeResultStream {
+	Array items;
+	int offset = 0;
+
+public:
+	virtual bool fill(int p_max, Array &r_items) override {
+		int end = MIN(offset + p_max, items.size());
+		for (; offset < end; offset++) {
+			r_items.push_back(items[offset]);
+		}
+		return offset < items.size();
+	}
+
+	virtual void get_page_info(Dictionary &r_info) const override {
+		r_info["total"] = items.size();
+	}
+
+	BridgeArrayStream(const Array &p_items) :
+			items(p_items) {}
+};
+
+#endif // BRIDGE_RESULT_STREAM_H
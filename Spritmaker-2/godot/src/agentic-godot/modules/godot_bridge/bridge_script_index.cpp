@@ -0,0 +1,234 @@
+// bridge_script_index.cpp
+// Trigram index over project scripts for search_in_scripts
+
+#include "bridge_script_index.h"
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+#include "core/object/worker_thread_pool.h"
+#include "core/templates/sort_array.h"
+
+// Below this many changed files, threading costs more than it saves
+static const int PARALLEL_LOAD_THRESHOLD = 8;
+
+// 10 bits per character. Non-ASCII characters may collide, which only adds
+// false candidates; matches are always confirmed on the text itself.
+uint32_t BridgeScriptIndex::_trigram(char32_t p_a, char32_t p_b, char32_t p_c) {
+	return ((uint32_t(p_a) & 0x3FF) << 20) | ((uint32_t(p_b) & 0x3FF) << 10) | (uint32_t(p_c) & 0x3FF);
+}
+
+void BridgeScriptIndex::_collect_trigrams(const String &p_text, LocalVector<uint32_t> &r_trigrams) {
+	r_trigrams.clear();
+	int length = p_text.length();
+	if (length < 3) {
+		return;
+	}
+
+	const char32_t *chars = p_text.ptr();
+	r_trigrams.reserve(length - 2);
+	for (int i = 0; i + 2 < length; i++) {
+		r_trigrams.push_back(_trigram(chars[i], chars[i + 1], chars[i + 2]));
+	}
+	r_trigrams.sort();
+
+	// Deduplicate in place
+	uint32_t unique = 1;
+	for (uint32_t i = 1; i < r_trigrams.size(); i++) {
+		if (r_trigrams[i] != r_trigrams[unique - 1]) {
+			r_trigrams[unique++] = r_trigrams[i];
+		}
+	}
+	r_trigrams.resize(unique);
+}
+
+bool BridgeScriptIndex::_has_trigram(const LocalVector<uint32_t> &p_sorted, uint32_t p_trigram) {
+	uint32_t low = 0;
+	uint32_t high = p_sorted.size();
+	while (low < high) {
+		uint32_t mid = (low + high) / 2;
+		if (p_sorted[mid] < p_trigram) {
+			low = mid + 1;
+		} else {
+			high = mid;
+		}
+	}
+	return low < p_sorted.size() && p_sorted[low] == p_trigram;
+}
+
+void BridgeScriptIndex::_load_file(uint32_t p_index, LoadJob *p_jobs) {
+	LoadJob &job = p_jobs[p_index];
+	Ref<FileAccess> file = FileAccess::open(job.path, FileAccess::READ);
+	if (file.is_null()) {
+		return;
+	}
+	job.entry.text = file->get_as_text();
+	job.entry.modified_time = job.modified_time;
+	_collect_trigrams(job.entry.text, job.entry.trigrams);
+	job.loaded = true;
+}
+
+void BridgeScriptIndex::mark_dirty(const String &p_path) {
+	if (!p_path.ends_with(".gd")) {
+		return;
+	}
+	{
+		MutexLock pending_lock(pending_mutex);
+		forced_paths.insert(p_path.simplify_path());
+	}
+	dirty.set();
+}
+
+void BridgeScriptIndex::set_file_list(const HashMap<String, uint64_t> &p_files) {
+	{
+		MutexLock pending_lock(pending_mutex);
+		listed_files = p_files;
+		has_listing = true;
+	}
+	dirty.set();
+}
+
+// Fallback listing before the editor has reported one. Only modification
+// times are read. Dot-prefixed entries are skipped like EditorFileSystem does,
+// which also keeps .godot/ out.
+void BridgeScriptIndex::_walk_project(HashMap<String, uint64_t> &r_files) {
+	LocalVector<String> dirs_to_search;
+	dirs_to_search.push_back("res://");
+	for (uint32_t dir_index = 0; dir_index < dirs_to_search.size(); dir_index++) {
+		String current_dir = dirs_to_search[dir_index];
+		Ref<DirAccess> d = DirAccess::open(current_dir);
+		if (d.is_null()) {
+			continue;
+		}
+		d->list_dir_begin();
+		String item = d->get_next();
+		while (!item.is_empty()) {
+			if (!item.begins_with(".")) {
+				String full_path = current_dir.path_join(item);
+				if (d->current_is_dir()) {
+					dirs_to_search.push_back(full_path);
+				} else if (item.ends_with(".gd")) {
+					r_files.insert(full_path, FileAccess::get_modified_time(full_path));
+				}
+			}
+			item = d->get_next();
+		}
+		d->list_dir_end();
+	}
+}
+
+bool BridgeScriptIndex::sync() {
+	if (!dirty.is_set()) {
+		return true;
+	}
+	if (!sync_mutex.try_lock()) {
+		return false;
+	}
+	// Cleared first, so changes reported during the sync trigger another one
+	dirty.clear();
+
+	HashMap<String, uint64_t> on_disk;
+	HashSet<String> forced;
+	bool listed;
+	{
+		MutexLock pending_lock(pending_mutex);
+		listed = has_listing;
+		if (listed) {
+			on_disk = listed_files;
+		}
+		forced = forced_paths;
+		forced_paths.clear();
+	}
+	if (!listed) {
+		_walk_project(on_disk);
+	}
+	// Scripts the bridge just created may not be in the editor's listing yet
+	for (const String &path : forced) {
+		if (!on_disk.has(path) && FileAccess::exists(path)) {
+			on_disk.insert(path, FileAccess::get_modified_time(path));
+		}
+	}
+
+	LocalVector<LoadJob> jobs;
+	LocalVector<String> removed;
+	{
+		RWLockRead read_lock(lock);
+		for (const KeyValue<String, uint64_t> &kv : on_disk) {
+			const FileEntry *entry = files.getptr(kv.key);
+			if (!entry || entry->modified_time != kv.value || forced.has(kv.key)) {
+				LoadJob job;
+				job.path = kv.key;
+				job.modified_time = kv.value;
+				jobs.push_back(job);
+			}
+		}
+		for (const KeyValue<String, FileEntry> &kv : files) {
+			if (!on_disk.has(kv.key)) {
+				removed.push_back(kv.key);
+			}
+		}
+	}
+
+	if (jobs.size() >= (uint32_t)PARALLEL_LOAD_THRESHOLD) {
+		WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_template_group_task(this, &BridgeScriptIndex::_load_file, jobs.ptr(), jobs.size(), -1, true, "GodotBridge script index");
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+	} else {
+		for (uint32_t i = 0; i < jobs.size(); i++) {
+			_load_file(i, jobs.ptr());
+		}
+	}
+
+	{
+		RWLockWrite write_lock(lock);
+		for (const String &path : removed) {
+			files.erase(path);
+		}
+		for (LoadJob &job : jobs) {
+			if (job.loaded) {
+				files[job.path] = job.entry;
+			} else {
+				files.erase(job.path);
+			}
+		}
+	}
+
+	sync_mutex.unlock();
+	return true;
+}
+
+void BridgeScriptIndex::find_candidates(const String &p_literal, LocalVector<Candidate> &r_candidates) const {
+	LocalVector<uint32_t> query;
+	_collect_trigrams(p_literal, query);
+
+	{
+		RWLockRead read_lock(lock);
+		for (const KeyValue<String, FileEntry> &kv : files) {
+			bool match = true;
+			for (uint32_t trigram : query) {
+				if (!_has_trigram(kv.value.trigrams, trigram)) {
+					match = false;
+					break;
+				}
+			}
+			if (match) {
+				// Strings are shared, not copied
+				r_candidates.push_back({ kv.key, kv.value.text });
+			}
+		}
+	}
+
+	struct CandidateComparator {
+		bool operator()(const Candidate &p_a, const Candidate &p_b) const {
+			return p_a.path < p_b.path;
+		}
+	};
+	SortArray<Candidate, CandidateComparator> sorter;
+	sorter.sort(r_candidates.ptr(), r_candidates.size());
+}
+
+int BridgeScriptIndex::get_file_count() const {
+	RWLockRead read_lock(lock);
+	return files.size();
+}
+
+BridgeScriptIndex::BridgeScriptIndex() {
+	dirty.set();  // Built by the first search
+}
@@ -0,0 +1,80 @@
+#ifndef BRIDGE_SCRIPT_INDEX_H
+#define BRIDGE_SCRIPT_INDEX_H
+
+#include "core/os/mutex.h"
+#include "core/os/rw_lock.h"
+#include "core/string/ustring.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/hash_set.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
+
+// In-memory trigram index over the project's .gd files for search_in_scripts.
+// Every file keeps its text and the sorted set of trigrams it contains, so a
+// literal query only scans files holding all of the query's trigrams and no
+// query touches the disk. The index is marked dirty by EditorFileSystem
+// changes and brought up to date lazily by the next search: only files whose
+// modification time changed are re-read, in parallel on WorkerThreadPool.
+// The file list comes from the editor's in-memory EditorFileSystem tree; until
+// the editor has reported one, res:// is walked instead, skipping dot-prefixed
+// entries (.godot/, hidden folders) as EditorFileSystem does. Modification
+// times only have one-second resolution, so commands that write a script mark
+// that path, and it is re-read whatever its time says.
+// Safe to query from any thread.
+class BridgeScriptIndex {
+public:
+	struct Candidate {
+		String path;
+		String text;
+	};
+
+private:
+	struct FileEntry {
+		String text;
+		uint64_t modified_time = 0;
+		LocalVector<uint32_t> trigrams;  // Sorted, unique
+	};
+
+	struct LoadJob {
+		String path;
+		uint64_t modified_time = 0;
+		FileEntry entry;
+		bool loaded = false;
+	};
+
+	HashMap<String, FileEntry> files;  // Guarded by lock
+	mutable RWLock lock;
+	Mutex sync_mutex;  // One sync at a time
+	SafeFlag dirty;
+
+	Mutex pending_mutex;  // Guards the three below
+	HashMap<String, uint64_t> listed_files;  // Latest EditorFileSystem listing: path -> mtime
+	bool has_listing = false;
+	HashSet<String> forced_paths;  // Written by the bridge since the last sync
+
+	static uint32_t _trigram(char32_t p_a, char32_t p_b, char32_t p_c);
+	static void _collect_trigrams(const String &p_text, LocalVector<uint32_t> &r_trigrams);
+	static bool _has_trigram(const LocalVector<uint32_t> &p_sorted, uint32_t p_trigram);
+	void _load_file(uint32_t p_index, LoadJob *p_jobs);
+	static void _walk_project(HashMap<String, uint64_t> &r_files);
+
+public:
+	void mark_dirty() { dirty.set(); }
+	// p_path was written or removed; re-read it on the next sync
+	void mark_dirty(const String &p_path);
+	// Main thread, from EditorFileSystem: every .gd file with its modification time
+	void set_file_list(const HashMap<String, uint64_t> &p_files);
+
+	// Bring the index up to date if it is dirty. Returns false when another
+	// thread is already syncing; the caller then searches the current contents.
+	bool sync();
+
+	// Files that may contain p_literal, sorted by path. An empty literal (regex
+	// queries) or one shorter than a trigram returns every file.
+	void find_candidates(const String &p_literal, LocalVector<Candidate> &r_candidates) const;
+	int get_file_count() const;
+
+	BridgeScriptIndex();
+};
+
+#endif // BRIDGE_SCRIPT_INDEX_H
@@ -0,0 +1,141 @@
+// bridge_stats.cpp
+// Per-command latency histograms and throughput counters for GodotBridge
+
+#include "bridge_stats.h"
+#include "core/variant/array.h"
+
+// ============ Latency Histogram ============
+
+int BridgeLatencyHistogram::_bucket_for(uint64_t p_usec) {
+	if (p_usec == 0) {
+		return 0;
+	}
+
+	int octave = 0;
+	while ((p_usec >> (octave + 1)) != 0) {
+		octave++;
+	}
+
+	// The two bits below the leading one pick the sub-bucket
+	int sub = octave >= 2 ? int((p_usec >> (octave - 2)) & 3) : int((p_usec << (2 - octave)) & 3);
+	return MIN(octave * SUB_BUCKETS + sub, BUCKET_COUNT - 1);
+}
+
+uint64_t BridgeLatencyHistogram::_bucket_upper_bound(int p_bucket) {
+	int octave = p_bucket / SUB_BUCKETS;
+	int sub = p_bucket % SUB_BUCKETS;
+	return uint64_t((uint64_t(1) << octave) * (1.0 + (sub + 1) / double(SUB_BUCKETS)));
+}
+
+void BridgeLatencyHistogram::record(uint64_t p_usec) {
+	buckets[_bucket_for(p_usec)]++;
+	count++;
+	total_usec += p_usec;
+	max_usec = MAX(max_usec, p_usec);
+}
+
+uint64_t BridgeLatencyHistogram::percentile(float p_fraction) const {
+	if (count == 0) {
+		return 0;
+	}
+
+	uint64_t target = MAX(uint64_t(1), uint64_t(p_fraction * count + 0.5));
+	uint64_t seen = 0;
+	for (int i = 0; i < BUCKET_COUNT; i++) {
+		seen += buckets[i];
+		if (seen >= target) {
+			return MIN(_bucket_upper_bound(i), max_usec);
+		}
+	}
+	return max_usec;
+}
+
+// ============ Bridge Stats ============
+
+void BridgeStats::record_command(const String &p_method, uint64_t p_latency_usec, uint64_t p_exec_usec, uint64_t p_bytes_in, uint64_t p_bytes_out, bool p_failed) {
+	CommandStats &stats = commands[p_method];
+	stats.calls++;
+	stats.exec_usec += p_exec_usec;
+	stats.bytes_in += p_bytes_in;
+	stats.bytes_out += p_bytes_out;
+	stats.latency.record(p_latency_usec);
+	overall_latency.record(p_latency_usec);
+	total_calls++;
+	window_calls++;
+	if (p_failed) {
+		stats.errors++;
+		total_errors++;
+	}
+}
+
+void BridgeStats::record_wire(uint64_t p_bytes_in, uint64_t p_bytes_out) {
+	total_bytes_in += p_bytes_in;
+	total_bytes_out += p_bytes_out;
+	window_bytes_in += p_bytes_in;
+	window_bytes_out += p_bytes_out;
+}
+
+void BridgeStats::record_queue_depth(int p_depth) {
+	peak_queue_depth = MAX(peak_queue_depth, p_depth);
+}
+
+void BridgeStats::update_rates(uint64_t p_now_msec) {
+	uint64_t elapsed = p_now_msec - rate_window_msec;
+	if (elapsed < 1000) {
+		return;
+	}
+
+	double seconds = elapsed / 1000.0;
+	calls_per_sec = window_calls / seconds;
+	bytes_in_per_sec = window_bytes_in / seconds;
+	bytes_out_per_sec = window_bytes_out / seconds;
+	window_calls = 0;
+	window_bytes_in = 0;
+	window_bytes_out = 0;
+	rate_window_msec = p_now_msec;
+}
+
+void BridgeStats::reset(uint64_t p_now_msec) {
+	*this = BridgeStats();
+	started_msec = p_now_msec;
+	rate_window_msec = p_now_msec;
+}
+
+Dictionary BridgeStats::to_dictionary(uint64_t p_now_msec) const {
+	Dictionary result;
+
+	Dictionary command_stats;
+	for (const KeyValue<String, CommandStats> &kv : commands) {
+		const CommandStats &stats = kv.value;
+		Dictionary entry;
+		entry["calls"] = stats.calls;
+		entry["errors"] = stats.errors;
+		entry["error_rate"] = stats.calls ? double(stats.errors) / stats.calls : 0.0;
+		entry["p50_msec"] = stats.latency.percentile(0.50f) / 1000.0;
+		entry["p95_msec"] = stats.latency.percentile(0.95f) / 1000.0;
+		entry["p99_msec"] = stats.latency.percentile(0.99f) / 1000.0;
+		entry["mean_msec"] = stats.latency.get_mean() / 1000.0;
+		entry["max_msec"] = stats.latency.get_max() / 1000.0;
+		entry["mean_exec_msec"] = stats.calls ? stats.exec_usec / 1000.0 / stats.calls : 0.0;
+		entry["bytes_in"] = stats.bytes_in;
+		entry["bytes_out"] = stats.bytes_out;
+		command_stats[kv.key] = entry;
+	}
+	result["commands"] = command_stats;
+
+	Dictionary totals;
+	totals["calls"] = total_calls;
+	totals["errors"] = total_errors;
+	totals["error_rate"] = total_calls ? double(total_errors) / total_calls : 0.0;
+	totals["p50_msec"] = overall_latency.percentile(0.50f) / 1000.0;
+	totals["p95_msec"] = overall_latency.percentile(0.95f) / 1000.0;
+	totals["p99_msec"] = overall_latency.percentile(0.99f) / 1000.0;
+	totals["bytes_in"] = total_bytes_in;
+	totals["bytes_out"] = total_bytes_out;
+	totals["calls_per_sec"] = calls_per_sec;
+	totals["peak_queue_depth"] = peak_queue_depth;
+	result["totals"] = totals;
+
+	result["uptime_sec"] = (p_now_msec - started_msec) / 1000.0;
+	return result;
+}
@@ -0,0 +1,82 @@
+#ifndef BRIDGE_STATS_H
+#define BRIDGE_STATS_H
+
+#include "core/string/ustring.h"
+#include "core/templates/hash_map.h"
+#include "core/variant/dictionary.h"
+
+// Fixed-size latency histogram with four log2 sub-buckets per octave
+// (~19% resolution) from 1 usec up to ~16 s. Recording is O(1) and
+// percentiles are read back as bucket upper bounds, so per-command stats
+// never grow with the number of calls.
+class BridgeLatencyHistogram {
+public:
+	static const int SUB_BUCKETS = 4;
+	static const int BUCKET_COUNT = 24 * SUB_BUCKETS;
+
+private:
+	uint32_t buckets[BUCKET_COUNT] = {};
+	uint64_t count = 0;
+	uint64_t total_usec = 0;
+	uint64_t max_usec = 0;
+
+	static int _bucket_for(uint64_t p_usec);
+	static uint64_t _bucket_upper_bound(int p_bucket);
+
+public:
+	void record(uint64_t p_usec);
+	uint64_t percentile(float p_fraction) const;
+	uint64_t get_count() const { return count; }
+	uint64_t get_max() const { return max_usec; }
+	double get_mean() const { return count ? double(total_usec) / count : 0.0; }
+};
+
+// Bridge telemetry, written only from the main thread
+class BridgeStats {
+public:
+	struct CommandStats {
+		uint64_t calls = 0;
+		uint64_t errors = 0;
+		uint64_t bytes_in = 0;
+		uint64_t bytes_out = 0;
+		uint64_t exec_usec = 0;  // Time spent inside the handler
+		BridgeLatencyHistogram latency;  // Arrival to response written
+	};
+
+private:
+	HashMap<String, CommandStats> commands;
+	BridgeLatencyHistogram overall_latency;
+	uint64_t total_calls = 0;
+	uint64_t total_errors = 0;
+	uint64_t total_bytes_in = 0;
+	uint64_t total_bytes_out = 0;
+	uint64_t started_msec = 0;
+	int peak_queue_depth = 0;
+
+	// Per-second rates for the Performance monitors
+	uint64_t rate_window_msec = 0;
+	uint64_t window_calls = 0;
+	uint64_t window_bytes_in = 0;
+	uint64_t window_bytes_out = 0;
+	double calls_per_sec = 0.0;
+	double bytes_in_per_sec = 0.0;
+	double bytes_out_per_sec = 0.0;
+
+public:
+	void record_command(const String &p_method, uint64_t p_latency_usec, uint64_t p_exec_usec, uint64_t p_bytes_in, uint64_t p_bytes_out, bool p_failed);
+	// Raw socket traffic, including events and framing
+	void record_wire(uint64_t p_bytes_in, uint64_t p_bytes_out);
+	void record_queue_depth(int p_depth);
+	void update_rates(uint64_t p_now_msec);
+	void reset(uint64_t p_now_msec);
+
+	double get_calls_per_sec() const { return calls_per_sec; }
+	double get_bytes_in_per_sec() const { return bytes_in_per_sec; }
+	double get_bytes_out_per_sec() const { return bytes_out_per_sec; }
+	double get_p95_msec() const { return overall_latency.percentile(0.95f) / 1000.0; }
+	uint64_t get_total_errors() const { return total_errors; }
+
+	Dictionary to_dictionary(uint64_t p_now_msec) const;
+};
+
+#endif // BRIDGE_STATS_H
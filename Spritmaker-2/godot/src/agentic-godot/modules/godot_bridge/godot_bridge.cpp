@@ -5,6 +5,7 @@
 // - bridge_commands_filesystem.cpp
 // - bridge_commands_input.cpp
 // - bridge_commands_advanced.cpp
+// - bridge_commands_protocol.cpp
 
 #include "godot_bridge.h"
 #include "bridge_command_registry.h"
@@ -14,10 +15,16 @@
 #include "core/config/project_settings.h"
 #include "core/os/os.h"
 #include "core/os/thread.h"
+#include "core/object/worker_thread_pool.h"
+#include "core/io/marshalls.h"
+#include "bridge_msgpack.h"
+#include "main/performance.h"
+#include "scene/main/scene_tree.h"
 
 #ifdef TOOLS_ENABLED
 #include "editor/editor_node.h"
 #include "editor/editor_interface.h"
+#include "editor/editor_file_system.h"
 #include "editor/plugins/script_editor_plugin.h"
 #endif
 
@@ -25,7 +32,11 @@
 
 void GodotBridge::_init_command_registry() {
 	// Scene/Node commands
-	REGISTER_COMMAND_1(command_registry, "get_scene_tree", get_scene_tree, "max_depth", int, 5);
+	REGISTER_COMMAND_2(command_registry, "get_scene_tree", get_scene_tree, "max_depth", int, 5, "page_size", int, 0);
+	REGISTER_COMMAND_1(command_registry, "get_scene_changes", get_scene_changes, "since_version", int64_t, 0);
+	command_registry["query_nodes"] = [](GodotBridge* bridge, const Dictionary& params) -> Dictionary {
+		return bridge->query_nodes(params);
+	};
 	REGISTER_COMMAND_2(command_registry, "create_scene", create_scene, "path", String, "", "root_type", String, "Node2D");
 	REGISTER_COMMAND_3(command_registry, "add_node", add_node, "parent", String, "", "type", String, "Node", "name", String, "NewNode");
 	REGISTER_COMMAND_1(command_registry, "remove_node", remove_node, "path", String, "");
@@ -60,28 +71,66 @@ void GodotBridge::_init_command_registry() {
 	REGISTER_COMMAND_2(command_registry, "create_script", create_script, "path", String, "", "content", String, "");
 	REGISTER_COMMAND_1(command_registry, "read_script", read_script, "path", String, "");
 	REGISTER_COMMAND_2(command_registry, "edit_script", edit_script, "path", String, "", "content", String, "");
+	command_registry["patch_script"] = [](GodotBridge* bridge, const Dictionary& params) -> Dictionary {
+		String path = params.get("path", "");
+		Array edits = params.get("edits", Array());
+		String diff = params.get("diff", "");
+		String base_hash = params.get("base_hash", "");
+		return bridge->patch_script(path, edits, diff, base_hash);
+	};
 	REGISTER_COMMAND_0(command_registry, "get_errors", get_errors);
 	REGISTER_COMMAND_0(command_registry, "get_runtime_errors", get_runtime_errors);
 	REGISTER_COMMAND_0(command_registry, "clear_runtime_errors", clear_runtime_errors);
-	REGISTER_COMMAND_2(command_registry, "search_in_scripts", search_in_scripts, "pattern", String, "", "is_regex", bool, false);
+	REGISTER_COMMAND_3(command_registry, "search_in_scripts", search_in_scripts, "pattern", String, "", "is_regex", bool, false, "page_size", int, 50);
 	
 	// File system commands
-	REGISTER_COMMAND_2(command_registry, "list_files", list_files, "path", String, "res://", "recursive", bool, false);
-	REGISTER_COMMAND_1(command_registry, "read_file", read_file, "path", String, "");
+	command_registry["list_files"] = [](GodotBridge* bridge, const Dictionary& params) -> Dictionary {
+		String path = params.get("path", "res://");
+		bool recursive = params.get("recursive", false);
+		int page_size = params.get("page_size", 0);
+		ListFilesFilter filter;
+		filter.pattern = params.get("pattern", "");
+		Array extensions = params.get("extensions", Array());
+		for (int i = 0; i < extensions.size(); i++) {
+			filter.extensions.insert(String(extensions[i]).trim_prefix(".").to_lower());
+		}
+		filter.changed_since = MAX(int64_t(0), int64_t(params.get("changed_since", 0)));
+		Array seen = params.get("seen", Array());
+		for (int i = 0; i < seen.size(); i++) {
+			filter.seen.insert(seen[i]);
+		}
+		filter.include_size = params.get("include_size", false);
+		bool from_disk = params.get("from_disk", false);
+		return bridge->list_files(path, recursive, page_size, filter, from_disk);
+	};
+	command_registry["read_file"] = [](GodotBridge* bridge, const Dictionary& params) -> Dictionary {
+		String path = params.get("path", "");
+		int64_t offset = params.get("offset", 0);
+		int64_t length = params.get("length", -1);
+		int start_line = params.get("start_line", 0);
+		int line_count = params.get("line_count", 0);
+		String encoding = params.get("encoding", "text");
+		String if_none_match = params.get("if_none_match", "");
+		bool with_hash = params.get("hash", false);
+		return bridge->read_file(path, offset, length, start_line, line_count, encoding, if_none_match, with_hash);
+	};
 	REGISTER_COMMAND_1(command_registry, "create_folder", create_folder, "path", String, "");
 	REGISTER_COMMAND_1(command_registry, "delete_file", delete_file, "path", String, "");
 	REGISTER_COMMAND_2(command_registry, "create_resource", create_resource, "type", String, "", "path", String, "");
 	REGISTER_COMMAND_1(command_registry, "load_resource", load_resource, "path", String, "");
 	REGISTER_COMMAND_0(command_registry, "assets_scan", assets_scan);
-	REGISTER_COMMAND_1(command_registry, "assets_update_file", assets_update_file, "path", String, "");
-	REGISTER_COMMAND_1(command_registry, "assets_update_files", assets_update_files, "paths", Array, Array());
-	REGISTER_COMMAND_1(command_registry, "assets_reimport", assets_reimport, "path", String, "");
+	// These three only queue by default and answer queued: true before anything
+	// is imported; wait: true imports the queue before responding
+	REGISTER_COMMAND_2(command_registry, "assets_update_file", assets_update_file, "path", String, "", "wait", bool, false);
+	REGISTER_COMMAND_2(command_registry, "assets_update_files", assets_update_files, "paths", Array, Array(), "wait", bool, false);
+	REGISTER_COMMAND_2(command_registry, "assets_reimport", assets_reimport, "path", String, "", "wait", bool, false);
+	REGISTER_COMMAND_0(command_registry, "assets_flush_imports", assets_flush_imports);
 	REGISTER_COMMAND_2(command_registry, "assets_move_and_rename", assets_move_and_rename, "from", String, "", "to", String, "");
 	
 	// Input/Settings commands
 	REGISTER_COMMAND_2(command_registry, "add_input_action", add_input_action, "action", String, "", "key", String, "");
 	REGISTER_COMMAND_1(command_registry, "remove_input_action", remove_input_action, "action", String, "");
-	REGISTER_COMMAND_0(command_registry, "list_input_actions", list_input_actions);
+	REGISTER_COMMAND_1(command_registry, "list_input_actions", list_input_actions, "page_size", int, 0);
 	command_registry["set_project_setting"] = [](GodotBridge* bridge, const Dictionary& params) -> Dictionary {
 		String setting = params.get("setting", "");
 		Variant value = params.get("value", Variant());
@@ -119,7 +168,17 @@ void GodotBridge::_init_command_registry() {
 	command_registry["map_set_cells_batch"] = [](GodotBridge* bridge, const Dictionary& params) -> Dictionary {
 		String tilemap = params.get("tilemap_path", "");
 		Array cells = params.get("cells", Array());
-		return bridge->map_set_cells_batch(tilemap, cells);
+		Dictionary packed = params.get("packed", Dictionary());
+		return bridge->map_set_cells_batch(tilemap, cells, packed);
+	};
+	command_registry["map_get_cells"] = [](GodotBridge* bridge, const Dictionary& params) -> Dictionary {
+		String tilemap = params.get("tilemap_path", "");
+		int x = params.get("x", 0);
+		int y = params.get("y", 0);
+		int width = params.get("width", 0);
+		int height = params.get("height", 0);
+		String format = params.get("format", "columns");
+		return bridge->map_get_cells(tilemap, Rect2i(x, y, width, height), format);
 	};
 	command_registry["map_clear_layer"] = [](GodotBridge* bridge, const Dictionary& params) -> Dictionary {
 		String tilemap = params.get("tilemap_path", "");
@@ -137,6 +196,8 @@ void GodotBridge::_init_command_registry() {
 		return bridge->map_fill_rect(tilemap, start_x, start_y, width, height, source, atlas_x, atlas_y);
 	};
 	REGISTER_COMMAND_1(command_registry, "navmesh_bake", navmesh_bake, "region", String, "");
+	REGISTER_COMMAND_1(command_registry, "navmesh_bake_cancel", navmesh_bake_cancel, "job_id", String, "");
+	REGISTER_COMMAND_1(command_registry, "navmesh_bake_status", navmesh_bake_status, "job_id", String, "");
 	
 	// Phase 17: Critical Tool Gap Fixes
 	REGISTER_COMMAND_2(command_registry, "scene_instantiate", scene_instantiate, "scene_path", String, "", "parent", String, "");
@@ -157,7 +218,9 @@ void GodotBridge::_init_command_registry() {
 			}
 		}
 		
-		print_line("GodotBridge: set_collision_shape - size dict: width=" + String::num(float(size.get("width", 32.0))) + " height=" + String::num(float(size.get("height", 32.0))));
+		if (bridge->get_verbosity() >= GodotBridge::LOG_VERBOSE) {
+			print_line("GodotBridge: set_collision_shape - size dict: width=" + String::num(float(size.get("width", 32.0))) + " height=" + String::num(float(size.get("height", 32.0))));
+		}
 		return bridge->set_collision_shape(node, shape_type, size);
 	};
 	REGISTER_COMMAND_2(command_registry, "attach_script", attach_script, "node", String, "", "script_path", String, "");
@@ -183,7 +246,17 @@ void GodotBridge::_init_command_registry() {
 	};
 	
 	// Viewport/Runtime commands
-	REGISTER_COMMAND_2(command_registry, "capture_viewport", capture_viewport, "save_path", String, "", "viewport", String, "editor");
+	command_registry["capture_viewport"] = [](GodotBridge* bridge, const Dictionary& params) -> Dictionary {
+		String save_path = params.get("save_path", "");
+		String viewport = params.get("viewport", "editor");
+		return bridge->capture_viewport(save_path, viewport, params);
+	};
+	command_registry["capture_stream_start"] = [](GodotBridge* bridge, const Dictionary& params) -> Dictionary {
+		String viewport = params.get("viewport", "editor");
+		float fps = params.get("fps", 2.0);
+		return bridge->capture_stream_start(viewport, fps, params);
+	};
+	REGISTER_COMMAND_1(command_registry, "capture_stream_stop", capture_stream_stop, "stream_id", int, 0);
 	command_registry["get_runtime_state"] = [](GodotBridge* bridge, const Dictionary& params) -> Dictionary {
 		String node_path = params.get("node_path", "");
 		Array properties = params.get("properties", Array());
@@ -205,7 +278,7 @@ void GodotBridge::_init_command_registry() {
 	command_registry["create_sprite_frames_from_images"] = [](GodotBridge* bridge, const Dictionary& params) -> Dictionary {
 		String path = params.get("path", "");
 		Array animations = params.get("animations", Array());
-		return bridge->create_sprite_frames_from_images(path, animations);
+		return bridge->create_sprite_frames_from_images(path, animations, params);
 	};
 	
 	// SpriteMancer UI control commands
@@ -217,6 +290,12 @@ void GodotBridge::_init_command_registry() {
 		String code = params.get("code", "");
 		return bridge->spritemancer_execute_js(code);
 	};
+	command_registry["spritemancer_query_js"] = [](GodotBridge* bridge, const Dictionary& params) -> Dictionary {
+		String code = params.get("code", "");
+		int timeout_msec = params.get("timeout_msec", 10000);
+		String save_path = params.get("save_path", "");
+		return bridge->spritemancer_query_js(code, timeout_msec, save_path);
+	};
 	command_registry["spritemancer_retry_postprocess"] = [](GodotBridge* bridge, const Dictionary& params) -> Dictionary {
 		String project_id = params.get("project_id", "");
 		String animation = params.get("animation", "");
@@ -227,6 +306,22 @@ void GodotBridge::_init_command_registry() {
 		return bridge->spritemancer_navigate(view);
 	};
 	
+	// Protocol commands
+	command_registry["batch"] = [](GodotBridge* bridge, const Dictionary& params) -> Dictionary {
+		Array commands = params.get("commands", Array());
+		bool stop_on_error = params.get("stop_on_error", false);
+		return bridge->batch(commands, stop_on_error);
+	};
+	REGISTER_COMMAND_1(command_registry, "set_framing", set_framing, "mode", String, "newline");
+	REGISTER_COMMAND_1(command_registry, "set_encoding", set_encoding, "encoding", String, "json");
+	REGISTER_COMMAND_2(command_registry, "next_page", next_page, "cursor", String, "", "page_size", int, 0);
+	REGISTER_COMMAND_1(command_registry, "close_cursor", close_cursor, "cursor", String, "");
+	REGISTER_COMMAND_1(command_registry, "subscribe", subscribe, "topics", Array, Array());
+	REGISTER_COMMAND_1(command_registry, "unsubscribe", unsubscribe, "topics", Array, Array());
+	REGISTER_COMMAND_1(command_registry, "bridge_stats", bridge_stats, "reset", bool, false);
+	REGISTER_COMMAND_1(command_registry, "trace_start", trace_start, "path", String, "user://bridge_trace.jsonl");
+	REGISTER_COMMAND_0(command_registry, "trace_stop", trace_stop);
+	
 	// Get current project path (for automatic sprite saving)
 	command_registry["get_project_path"] = [](GodotBridge* bridge, const Dictionary& params) -> Dictionary {
 		Dictionary result;
@@ -234,6 +329,39 @@ void GodotBridge::_init_command_registry() {
 		result["success"] = true;
 		return result;
 	};
+	
+	// Read-only file commands that never touch the scene tree or editor UI
+	// run on WorkerThreadPool so large reads and searches don't stall a frame.
+	// list_files stays on the main thread: it reads EditorFileSystem's tree.
+	SET_COMMAND_THREAD_SAFE(command_registry, "read_file");
+	SET_COMMAND_THREAD_SAFE(command_registry, "read_script");
+	SET_COMMAND_THREAD_SAFE(command_registry, "list_scenes");
+	SET_COMMAND_THREAD_SAFE(command_registry, "search_in_scripts");
+	SET_COMMAND_THREAD_SAFE(command_registry, "get_project_path");
+	
+	// Connection negotiation must not interleave with in-flight responses
+	SET_COMMAND_CONNECTION(command_registry, "set_framing");
+	SET_COMMAND_CONNECTION(command_registry, "set_encoding");
+	
+	// Scheduling priorities: cheap queries jump ahead of other clients' bulk work
+	static const char *interactive_commands[] = {
+		"get_scene_tree", "get_scene_changes", "query_nodes", "get_node_info", "get_property", "get_open_scenes",
+		"get_selected_nodes", "get_selected_text", "get_selected_files",
+		"get_errors", "get_runtime_errors", "get_project_setting", "get_runtime_state",
+		"get_sprite_dimensions", "list_groups", "list_signals", "list_input_actions",
+		"read_file", "read_script", "get_project_path", "bridge_stats", "navmesh_bake_status",
+	};
+	for (const char *name : interactive_commands) {
+		SET_COMMAND_PRIORITY(command_registry, name, COMMAND_PRIORITY_INTERACTIVE);
+	}
+	static const char *bulk_commands[] = {
+		"batch", "map_set_cells_batch", "map_fill_rect", "tileset_create_atlas",
+		"create_sprite_frames", "create_sprite_frames_from_images", "navmesh_bake",
+		"assets_scan", "search_in_scripts",
+	};
+	for (const char *name : bulk_commands) {
+		SET_COMMAND_PRIORITY(command_registry, name, COMMAND_PRIORITY_BULK);
+	}
 }
 
 // ============ Binding ============
@@ -243,6 +371,17 @@ void GodotBridge::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("stop"), &GodotBridge::stop);
 	ClassDB::bind_method(D_METHOD("is_running"), &GodotBridge::is_running);
 	ClassDB::bind_method(D_METHOD("broadcast_event", "event", "data"), &GodotBridge::broadcast_event);
+	ClassDB::bind_method(D_METHOD("set_frame_budget_msec", "msec"), &GodotBridge::set_frame_budget_msec);
+	ClassDB::bind_method(D_METHOD("get_frame_budget_msec"), &GodotBridge::get_frame_budget_msec);
+	ClassDB::bind_method(D_METHOD("set_max_client_queue", "max"), &GodotBridge::set_max_client_queue);
+	ClassDB::bind_method(D_METHOD("get_max_client_queue"), &GodotBridge::get_max_client_queue);
+	ClassDB::bind_method(D_METHOD("set_verbosity", "level"), &GodotBridge::set_verbosity);
+	ClassDB::bind_method(D_METHOD("get_verbosity"), &GodotBridge::get_verbosity);
+	ClassDB::bind_method(D_METHOD("bridge_stats", "reset"), &GodotBridge::bridge_stats, DEFVAL(false));
+
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "frame_budget_msec", PROPERTY_HINT_RANGE, "0,100,0.1"), "set_frame_budget_msec", "get_frame_budget_msec");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "max_client_queue", PROPERTY_HINT_RANGE, "1,4096,1"), "set_max_client_queue", "get_max_client_queue");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "verbosity", PROPERTY_HINT_ENUM, "Quiet,Normal,Verbose"), "set_verbosity", "get_verbosity");
 
 	ADD_SIGNAL(MethodInfo("client_connected", PropertyInfo(Variant::INT, "id")));
 	ADD_SIGNAL(MethodInfo("client_disconnected", PropertyInfo(Variant::INT, "id")));
@@ -258,20 +397,39 @@ void GodotBridge::_notification(int p_what) {
 	if (p_what == NOTIFICATION_READY) {
 		_connect_editor_signals();
 	}
+	if (p_what == NOTIFICATION_PROCESS && !running) {
+		// Not serving (start() failed, or stopped): editor code such as the
+		// SpriteMancer dock still queues imports, so keep draining them
+		_pump_imports();
+		if (pending_imports.is_empty()) {
+			set_process(false);
+		}
+	}
 	if (p_what == NOTIFICATION_PROCESS && running) {
 		if (server.is_valid()) {
 			while (server->is_connection_available()) {
-				Ref<StreamPeerTCP> client = server->take_connection();
-				clients.push_back(client);
-				client_buffers.push_back(String());  // Initialize receive buffer for new client
+				ClientConnection conn;
+				conn.id = next_client_id++;
+				conn.peer = server->take_connection();
+				conn.connected_msec = OS::get_singleton()->get_ticks_msec();
+				clients.push_back(conn);
 				int id = clients.size() - 1;
 				emit_signal("client_connected", id);
-				print_line("GodotBridge: Client connected, id=" + itos(id));
+				BRIDGE_LOG("GodotBridge: Client connected, id=" + itos(id));
 			}
 
 			for (int i = clients.size() - 1; i >= 0; i--) {
 				_process_client(i);
 			}
+
+			_pump_jobs();
+			_pump_nav_bakes();
+			_pump_captures();
+			_pump_imports();
+			_drain_errors();
+			_broadcast_errors();
+			_flush_events();
+			stats.update_rates(OS::get_singleton()->get_ticks_msec());
 		}
 	}
 }
@@ -284,7 +442,15 @@ Error GodotBridge::start(int p_port) {
 		running = true;
 		set_process(true);
 		_init_command_registry();
-		print_line("GodotBridge: Listening on port " + itos(port));
+		stats.reset(OS::get_singleton()->get_ticks_msec());
+		_register_monitors();
+
+		// Benchmarks record from startup without a client having to ask
+		String trace_path = OS::get_singleton()->get_environment("GODOT_BRIDGE_TRACE");
+		if (!trace_path.is_empty()) {
+			trace_start(trace_path);
+		}
+		BRIDGE_LOG("GodotBridge: Listening on port " + itos(port));
 	}
 	return err;
 }
@@ -293,99 +459,520 @@ void GodotBridge::stop() {
 	if (server.is_valid()) {
 		server->stop();
 	}
+	_cancel_all_jobs();
+	_cancel_captures();
+	if (!pending_imports.is_empty()) {
+		assets_flush_imports();  // Files are already on disk; don't leave them unimported
+	}
+	_clear_cursors();
+	nav_bake_jobs.clear();  // Bakes keep running; their results are just no longer reported
+	pending_events.clear();
+	pending_event_index.clear();
 	clients.clear();
+	_unregister_monitors();
+	trace_stop();
 	running = false;
 	set_process(false);
-	print_line("GodotBridge: Stopped");
+	BRIDGE_LOG("GodotBridge: Stopped");
 }
 
 bool GodotBridge::is_running() const {
 	return running;
 }
 
+void GodotBridge::set_frame_budget_msec(float p_msec) {
+	frame_budget_usec = MAX(0, int(p_msec * 1000.0f));
+}
+
+float GodotBridge::get_frame_budget_msec() const {
+	return frame_budget_usec / 1000.0f;
+}
+
+void GodotBridge::set_max_client_queue(int p_max) {
+	max_client_queue = MAX(1, p_max);
+}
+
+int GodotBridge::get_max_client_queue() const {
+	return max_client_queue;
+}
+
+void GodotBridge::set_verbosity(int p_level) {
+	verbosity = CLAMP(p_level, (int)LOG_QUIET, (int)LOG_VERBOSE);
+}
+
+int GodotBridge::get_verbosity() const {
+	return verbosity;
+}
+
 // ============ Client Handling ============
 
 void GodotBridge::_process_client(int index) {
-	Ref<StreamPeerTCP> client = clients[index];
+	Ref<StreamPeerTCP> client = clients[index].peer;
 
 	StreamPeerTCP::Status status = client->get_status();
 	if (status == StreamPeerTCP::STATUS_ERROR || status == StreamPeerTCP::STATUS_NONE) {
 		emit_signal("client_disconnected", index);
+		BRIDGE_LOG("GodotBridge: Client disconnected, id=" + itos(index));
+		_drop_client_jobs(index);
 		clients.remove_at(index);
-		if (index < client_buffers.size()) {
-			client_buffers.remove_at(index);
-		}
+		return;
+	}
+
+	// Backpressure: leave bytes in the socket until the queue drains
+	if (clients[index].paused) {
 		return;
 	}
 
 	int available = client->get_available_bytes();
 	if (available > 0) {
-		PackedByteArray data;
-		data.resize(available);
-		client->get_data(data.ptrw(), available);
-		String chunk = String::utf8((const char *)data.ptr(), available);
-
-		// Append to per-client buffer
-		if (index < client_buffers.size()) {
-			client_buffers.write[index] += chunk;
+		// Read straight into the tail of the per-client byte buffer
+		// Frame size limits are enforced per frame in _extract_frames
+		ClientConnection &conn = clients.write[index];
+		uint32_t old_size = conn.recv_buffer.size();
+		conn.recv_buffer.resize(old_size + available);
+		client->get_data(conn.recv_buffer.ptr() + old_size, available);
+		conn.bytes_in += available;
+		stats.record_wire(available, 0);
+	}
+
+	// Also resumes frames left buffered while the client was paused
+	if (clients[index].recv_buffer.size() > clients[index].recv_offset) {
+		_extract_frames(index);
+	}
+}
+
+void GodotBridge::_extract_frames(int p_index) {
+	while (p_index < clients.size() && !clients[p_index].paused) {
+		ClientConnection &conn = clients.write[p_index];
+		const uint8_t *data = conn.recv_buffer.ptr() + conn.recv_offset;
+		uint32_t pending = conn.recv_buffer.size() - conn.recv_offset;
+		if (pending == 0) {
+			break;
+		}
+
+		// Frames are handed to workers as raw bytes; decoding happens off the main thread
+		const uint8_t *frame = nullptr;
+		uint32_t frame_size = 0;
+		if (conn.recv_framing == FRAMING_LENGTH_PREFIXED) {
+			if (pending < 4) {
+				break;
+			}
+			uint32_t length = (uint32_t(data[0]) << 24) | (uint32_t(data[1]) << 16) | (uint32_t(data[2]) << 8) | uint32_t(data[3]);
+			if (length > MAX_FRAME_SIZE) {
+				print_line("GodotBridge: Invalid frame length from client " + itos(p_index) + ", disconnecting");
+				conn.peer->disconnect_from_host();
+				conn.recv_buffer.clear();
+				conn.recv_offset = 0;
+				return;
+			}
+			if (pending - 4 < length) {
+				break;
+			}
+			frame = data + 4;
+			frame_size = length;
+			conn.recv_offset += 4 + length;
+			conn.scan_offset = conn.recv_offset;
 		} else {
-			// Safety: buffer not yet allocated
-			while (client_buffers.size() <= index) {
-				client_buffers.push_back(String());
+			// Resume scanning where the previous pass stopped
+			uint32_t scan_from = MAX(conn.scan_offset, conn.recv_offset);
+			const uint8_t *newline = (const uint8_t *)memchr(conn.recv_buffer.ptr() + scan_from, '\n', conn.recv_buffer.size() - scan_from);
+			if (newline) {
+				uint32_t length = newline - data;
+				if (length > MAX_FRAME_SIZE) {
+					print_line("GodotBridge: Client " + itos(p_index) + " exceeded max frame size, disconnecting");
+					conn.peer->disconnect_from_host();
+					conn.recv_buffer.clear();
+					conn.recv_offset = 0;
+					return;
+				}
+				frame = data;
+				frame_size = length;
+				conn.recv_offset += length + 1;
+				conn.scan_offset = conn.recv_offset;
+			} else {
+				// Only the unterminated frame itself is held against the limit
+				if (pending > MAX_FRAME_SIZE) {
+					print_line("GodotBridge: Client " + itos(p_index) + " exceeded max frame size, disconnecting");
+					conn.peer->disconnect_from_host();
+					conn.recv_buffer.clear();
+					conn.recv_offset = 0;
+					return;
+				}
+				conn.scan_offset = conn.recv_buffer.size();
+
+				// Fallback: if buffer has no newline but looks like complete JSON,
+				// try to parse it directly (backward compat with non-delimited senders)
+				uint32_t first = 0;
+				uint32_t last = pending;
+				while (first < last && is_whitespace(data[first])) {
+					first++;
+				}
+				while (last > first && is_whitespace(data[last - 1])) {
+					last--;
+				}
+				if (last > first && data[first] == '{' && data[last - 1] == '}') {
+					frame = data + first;
+					frame_size = last - first;
+					conn.recv_offset = conn.recv_buffer.size();
+					conn.scan_offset = conn.recv_offset;
+				} else {
+					break;
+				}
 			}
-			client_buffers.write[index] = chunk;
 		}
 
-		// Extract complete newline-delimited messages from buffer
-		String &buf = client_buffers.write[index];
-		int newline_pos;
-		while ((newline_pos = buf.find("\n")) != -1) {
-			String message = buf.substr(0, newline_pos).strip_edges();
-			buf = buf.substr(newline_pos + 1);
-			if (!message.is_empty()) {
-				_handle_message(message, index);
+		if (frame_size > 0) {
+			_enqueue_message(frame, frame_size, p_index);
+		}
+	}
+
+	if (p_index >= clients.size()) {
+		return;
+	}
+
+	// Compact once the consumed prefix dominates the buffer
+	ClientConnection &conn = clients.write[p_index];
+	uint32_t size = conn.recv_buffer.size();
+	if (conn.recv_offset == size) {
+		conn.recv_buffer.clear();
+		conn.recv_offset = 0;
+		conn.scan_offset = 0;
+	} else if (conn.recv_offset > 0 && conn.recv_offset >= size / 2) {
+		uint32_t remaining = size - conn.recv_offset;
+		memmove(conn.recv_buffer.ptr(), conn.recv_buffer.ptr() + conn.recv_offset, remaining);
+		conn.recv_buffer.resize(remaining);
+		conn.scan_offset -= conn.recv_offset;
+		conn.recv_offset = 0;
+	}
+}
+
+// ============ Job Pipeline ============
+// Messages are parsed on WorkerThreadPool and queued per client in arrival
+// order. Each frame the scheduler dispatches queue heads within a time budget,
+// highest priority first and round-robin between clients. Thread-safe commands
+// run on workers; a main-thread command waits until earlier worker commands
+// from the same client have finished, so every client observes its own
+// requests in order.
+
+void GodotBridge::_enqueue_message(const uint8_t *p_data, int p_size, int p_client_index) {
+	BridgeJob *job = memnew(BridgeJob);
+	job->client_id = clients[p_client_index].id;
+	job->raw.resize(p_size);
+	memcpy(job->raw.ptrw(), p_data, p_size);
+	job->raw_encoding = clients[p_client_index].recv_encoding;
+	job->bytes_in = p_size;
+	job->received_usec = OS::get_singleton()->get_ticks_usec();
+	job->traced = trace_file.is_valid();
+	job->state.set(BridgeJob::STATE_PARSING);
+	job->task_id = WorkerThreadPool::get_singleton()->add_template_task(this, &GodotBridge::_parse_job_task, job, false, "GodotBridge parse");
+	clients.write[p_client_index].queue.push_back(job);
+	_update_backpressure(p_client_index);
+}
+
+void GodotBridge::_parse_job_task(BridgeJob *p_job) {
+	Dictionary msg;
+	if (_decode_message(p_job->raw, p_job->raw_encoding, msg) == OK) {
+		p_job->id = msg.get("id", "");
+		p_job->method = msg.get("method", "");
+		p_job->params = msg.get("params", Dictionary());
+		p_job->valid = true;
+
+		// Registry is only written in start(), so concurrent lookups are safe
+		const BridgeCommand *command = command_registry.getptr(p_job->method);
+		if (command) {
+			p_job->threading = command->threading;
+			p_job->priority = command->priority;
+		}
+	}
+	if (!p_job->traced) {
+		p_job->raw = Vector<uint8_t>();
+	}
+	p_job->state.set(BridgeJob::STATE_READY);
+}
+
+void GodotBridge::_run_job_task(BridgeJob *p_job) {
+	uint64_t start = OS::get_singleton()->get_ticks_usec();
+	dispatch_client_id = p_job->client_id;
+	p_job->result = _dispatch_command(p_job->method, p_job->params);
+	dispatch_client_id = 0;
+	p_job->exec_usec = OS::get_singleton()->get_ticks_usec() - start;
+	p_job->failed = _result_failed(p_job->result);
+	p_job->cursor = p_job->result.get("cursor", "");
+	if (!p_job->id.is_empty()) {
+		p_job->encoded = _encode_response(p_job->id, p_job->result, p_job->encoding);
+	}
+	p_job->result = Dictionary();
+	p_job->state.set(BridgeJob::STATE_DONE);
+}
+
+void GodotBridge::_encode_job_task(BridgeJob *p_job) {
+	p_job->cursor = p_job->result.get("cursor", "");
+	p_job->encoded = _encode_response(p_job->id, p_job->result, p_job->encoding);
+	p_job->result = Dictionary();
+	p_job->state.set(BridgeJob::STATE_DONE);
+}
+
+void GodotBridge::_reap_job_task(BridgeJob *p_job) {
+	if (p_job->task_id != WorkerThreadPool::INVALID_TASK_ID) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(p_job->task_id);
+		p_job->task_id = WorkerThreadPool::INVALID_TASK_ID;
+	}
+}
+
+void GodotBridge::_pump_jobs() {
+	_collect_finished_jobs();
+	stats.record_queue_depth(_total_queue_depth());
+
+	// Always dispatch at least one job so a slow command can't stall a client forever
+	uint64_t frame_start = OS::get_singleton()->get_ticks_usec();
+	int client_index;
+	while ((client_index = _pick_next_client()) != -1) {
+		_dispatch_job(client_index);
+		round_robin_cursor = client_index + 1;
+		if (OS::get_singleton()->get_ticks_usec() - frame_start >= (uint64_t)frame_budget_usec) {
+			break;
+		}
+	}
+
+	// Write anything that completed on the main thread this frame
+	_collect_finished_jobs();
+
+	_pump_streams(frame_start);
+
+	for (int i = 0; i < clients.size(); i++) {
+		_update_backpressure(i);
+	}
+}
+
+void GodotBridge::_collect_finished_jobs() {
+	uint32_t kept = 0;
+	bool events_flushed = false;
+	for (uint32_t i = 0; i < in_flight_jobs.size(); i++) {
+		BridgeJob *job = in_flight_jobs[i];
+		uint32_t state = job->state.get();
+		// Orphaned parse jobs (client disconnected) finish in STATE_READY
+		bool orphan_ready = state == BridgeJob::STATE_READY && _find_client(job->client_id) == -1;
+		if (state == BridgeJob::STATE_DONE || orphan_ready) {
+			// Events raised so far (often by the command itself) go out ahead of
+			// the response, as they did before events were batched per frame
+			if (!events_flushed) {
+				events_flushed = true;
+				_flush_events();
 			}
+			_finish_job(job);
+		} else {
+			in_flight_jobs[kept++] = job;
 		}
+	}
+	in_flight_jobs.resize(kept);
+}
 
-		// Fallback: if buffer has no newline but looks like complete JSON,
-		// try to parse it directly (backward compat with non-delimited senders)
-		if (!buf.is_empty() && buf.begins_with("{") && buf.ends_with("}")) {
-			String message = buf.strip_edges();
-			buf = String();
-			_handle_message(message, index);
+void GodotBridge::_finish_job(BridgeJob *p_job) {
+	_reap_job_task(p_job);
+	int client_index = _find_client(p_job->client_id);
+	if (client_index != -1 && p_job->valid) {
+		ClientConnection &conn = clients.write[client_index];
+		conn.jobs_in_flight--;
+		if (p_job->threading == COMMAND_THREAD_SAFE) {
+			conn.reads_in_flight--;
 		}
+		_write_job_response(p_job);
+	}
+	if (p_job->valid) {
+		_record_job_stats(p_job, p_job->encoded.size());
+	}
+	if (!p_job->cursor.is_empty()) {
+		// Claimed even if the client is gone, so the cursor expires with it
+		_claim_cursor(p_job->cursor, p_job->client_id, p_job->id, p_job->params.get("stream", false));
 	}
+	memdelete(p_job);
 }
 
-void GodotBridge::_handle_message(const String &p_message, int p_client_index) {
-	JSON json;
-	Error err = json.parse(p_message);
-	if (err != OK) {
+int GodotBridge::_pick_next_client() const {
+	int client_count = clients.size();
+	int best = -1;
+	int best_priority = -1;
+
+	// Scan starting after the last served client so equal priorities rotate
+	for (int offset = 0; offset < client_count; offset++) {
+		int i = (round_robin_cursor + offset) % client_count;
+		const ClientConnection &conn = clients[i];
+		if (conn.queue.is_empty()) {
+			continue;
+		}
+
+		const BridgeJob *head = conn.queue[0];
+		if (head->state.get() != BridgeJob::STATE_READY) {
+			continue;  // Still parsing; later jobs must wait their turn
+		}
+		if (head->valid && head->threading == COMMAND_MAIN_THREAD && conn.reads_in_flight > 0) {
+			continue;  // Keep writes behind this client's earlier reads
+		}
+		if (head->valid && head->threading == COMMAND_CONNECTION && conn.jobs_in_flight > 0) {
+			continue;  // Renegotiate only once every earlier response is out
+		}
+
+		int priority = head->valid ? (int)head->priority : (int)COMMAND_PRIORITY_INTERACTIVE;
+		if (priority > best_priority) {
+			best = i;
+			best_priority = priority;
+		}
+	}
+	return best;
+}
+
+void GodotBridge::_dispatch_job(int p_client_index) {
+	ClientConnection &conn = clients.write[p_client_index];
+	BridgeJob *job = conn.queue[0];
+	conn.queue.remove_at(0);
+	_reap_job_task(job);
+
+	if (!job->valid) {
+		memdelete(job);
 		return;
 	}
 
-	Dictionary msg = json.get_data();
-	String id = msg.get("id", "");
-	String method = msg.get("method", "");
-	Dictionary params = msg.get("params", Dictionary());
+	job->framing = conn.send_framing;
+	job->encoding = conn.send_encoding;
 
-	emit_signal("message_received", p_client_index, method, params);
-	print_line("GodotBridge: Received method=" + method);
+	if (job->threading == COMMAND_CONNECTION) {
+		// Execute, then write the reply in the old format before anything else
+		emit_signal("message_received", p_client_index, job->method, job->params);
+		BRIDGE_LOG_VERBOSE("GodotBridge: Received method=" + job->method);
+		conn.requests++;
+		current_client = p_client_index;
+		uint64_t start = OS::get_singleton()->get_ticks_usec();
+		Dictionary result = _dispatch_command(job->method, job->params);
+		job->exec_usec = OS::get_singleton()->get_ticks_usec() - start;
+		job->failed = _result_failed(result);
+		current_client = -1;
+		Vector<uint8_t> encoded;
+		if (!job->id.is_empty()) {
+			encoded = _encode_response(job->id, result, job->encoding);
+			_send_frame(p_client_index, job->framing, encoded.ptr(), encoded.size());
+		}
+		_record_job_stats(job, encoded.size());
+		memdelete(job);
+		return;
+	}
 
-	Dictionary result;
-	
-	// Command registry dispatch
-	if (command_registry.has(method)) {
-		result = command_registry[method](this, params);
+	conn.jobs_in_flight++;
+	conn.requests++;
+	if (job->threading == COMMAND_THREAD_SAFE) {
+		emit_signal("message_received", p_client_index, job->method, job->params);
+		BRIDGE_LOG_VERBOSE("GodotBridge: Received method=" + job->method + " (worker)");
+		conn.reads_in_flight++;
+		job->state.set(BridgeJob::STATE_RUNNING);
+		job->task_id = WorkerThreadPool::get_singleton()->add_template_task(this, &GodotBridge::_run_job_task, job, false, "GodotBridge " + job->method);
 	} else {
-		print_line("GodotBridge: Unknown method: " + method);
-		result["error"] = "Unknown method: " + method;
+		_execute_main_job(job, p_client_index);
+	}
+	in_flight_jobs.push_back(job);
+}
+
+void GodotBridge::_update_backpressure(int p_client_index) {
+	ClientConnection &conn = clients.write[p_client_index];
+	int depth = conn.queue.size();
+
+	if (!conn.paused && depth >= max_client_queue) {
+		conn.paused = true;
+		Dictionary data;
+		data["queue_depth"] = depth;
+		data["limit"] = max_client_queue;
+		send_event(p_client_index, "bridge_busy", data);
+		BRIDGE_LOG_VERBOSE("GodotBridge: Client " + itos(p_client_index) + " paused, queue depth " + itos(depth));
+	} else if (conn.paused && depth <= max_client_queue / 2) {
+		conn.paused = false;
+		Dictionary data;
+		data["queue_depth"] = depth;
+		send_event(p_client_index, "bridge_ready", data);
 	}
+}
 
-	if (!id.is_empty()) {
-		send_response(p_client_index, id, result);
-		print_line("GodotBridge: Sent response for id=" + id);
+void GodotBridge::_drop_client_jobs(int p_client_index) {
+	ClientConnection &conn = clients.write[p_client_index];
+	for (BridgeJob *job : conn.queue) {
+		if (job->state.get() == BridgeJob::STATE_PARSING) {
+			in_flight_jobs.push_back(job);  // Freed once the parse task finishes
+		} else {
+			_reap_job_task(job);
+			memdelete(job);
+		}
 	}
+	conn.queue.clear();
+}
+
+void GodotBridge::_execute_main_job(BridgeJob *p_job, int p_client_index) {
+	emit_signal("message_received", p_client_index, p_job->method, p_job->params);
+	BRIDGE_LOG_VERBOSE("GodotBridge: Received method=" + p_job->method);
+
+	current_client = p_client_index;
+	dispatch_client_id = p_job->client_id;
+	uint64_t start = OS::get_singleton()->get_ticks_usec();
+	p_job->result = _dispatch_command(p_job->method, p_job->params);
+	p_job->exec_usec = OS::get_singleton()->get_ticks_usec() - start;
+	p_job->failed = _result_failed(p_job->result);
+	dispatch_client_id = 0;
+	current_client = -1;
+
+	if (p_job->id.is_empty()) {
+		p_job->cursor = p_job->result.get("cursor", "");
+		p_job->result = Dictionary();
+		p_job->state.set(BridgeJob::STATE_DONE);
+		return;
+	}
+
+	p_job->state.set(BridgeJob::STATE_ENCODING);
+	p_job->task_id = WorkerThreadPool::get_singleton()->add_template_task(this, &GodotBridge::_encode_job_task, p_job, false, "GodotBridge encode");
+}
+
+void GodotBridge::_write_job_response(BridgeJob *p_job) {
+	int client_index = _find_client(p_job->client_id);
+	if (client_index == -1) {
+		return;
+	}
+
+	if (p_job->encoded.size() > 0) {
+		_send_frame(client_index, p_job->framing, p_job->encoded.ptr(), p_job->encoded.size());
+		BRIDGE_LOG_VERBOSE("GodotBridge: Sent response for id=" + p_job->id);
+	}
+}
+
+void GodotBridge::_cancel_all_jobs() {
+	for (int i = 0; i < clients.size(); i++) {
+		for (BridgeJob *job : clients[i].queue) {
+			_reap_job_task(job);
+			memdelete(job);
+		}
+		clients.write[i].queue.clear();
+	}
+	for (BridgeJob *job : in_flight_jobs) {
+		_reap_job_task(job);
+		memdelete(job);
+	}
+	in_flight_jobs.clear();
+}
+
+int GodotBridge::_find_client(uint32_t p_client_id) const {
+	for (int i = 0; i < clients.size(); i++) {
+		if (clients[i].id == p_client_id) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+Dictionary GodotBridge::_dispatch_command(const String &p_method, const Dictionary &p_params) {
+	const BridgeCommand *command = command_registry.getptr(p_method);
+	if (command) {
+		return command->handler(this, p_params);
+	}
+
+	BRIDGE_LOG_VERBOSE("GodotBridge: Unknown method: " + p_method);
+	Dictionary result;
+	result["error"] = "Unknown method: " + p_method;
+	result["success"] = false;
+	return result;
 }
 
 // ============ Communication ============
@@ -395,31 +982,282 @@ void GodotBridge::send_response(int p_client, const String &p_id, const Variant
 		return;
 	}
 
+	Vector<uint8_t> encoded = _encode_response(p_id, p_result, clients[p_client].send_encoding);
+	_send_frame(p_client, clients[p_client].send_framing, encoded.ptr(), encoded.size());
+}
+
+Vector<uint8_t> GodotBridge::_encode_message(const Dictionary &p_message, WireEncoding p_encoding) {
+	Vector<uint8_t> bytes;
+	switch (p_encoding) {
+		case ENCODING_VARIANT: {
+			int len = 0;
+			if (encode_variant(p_message, nullptr, len, false) == OK) {
+				bytes.resize(len);
+				encode_variant(p_message, bytes.ptrw(), len, false);
+			}
+		} break;
+		case ENCODING_MSGPACK: {
+			BridgeMsgPack::encode(p_message, bytes);
+		} break;
+		default: {
+			CharString utf8 = JSON::stringify(p_message).utf8();
+			bytes.resize(utf8.length());
+			memcpy(bytes.ptrw(), utf8.get_data(), utf8.length());
+		} break;
+	}
+	return bytes;
+}
+
+Vector<uint8_t> GodotBridge::_encode_response(const String &p_id, const Variant &p_result, WireEncoding p_encoding) {
 	Dictionary response;
 	response["id"] = p_id;
 	response["type"] = "response";
 	response["result"] = p_result;
+	return _encode_message(response, p_encoding);
+}
+
+Error GodotBridge::_decode_message(const Vector<uint8_t> &p_data, WireEncoding p_encoding, Dictionary &r_message) {
+	Variant decoded;
+	Error err;
+	switch (p_encoding) {
+		case ENCODING_VARIANT: {
+			err = decode_variant(decoded, p_data.ptr(), p_data.size(), nullptr, false);
+		} break;
+		case ENCODING_MSGPACK: {
+			err = BridgeMsgPack::decode(p_data.ptr(), p_data.size(), decoded);
+		} break;
+		default: {
+			JSON json;
+			err = json.parse(String::utf8((const char *)p_data.ptr(), p_data.size()).strip_edges());
+			decoded = json.get_data();
+		} break;
+	}
+	if (err != OK || decoded.get_type() != Variant::DICTIONARY) {
+		return ERR_PARSE_ERROR;
+	}
+	r_message = decoded;
+	return OK;
+}
 
-	String json_str = JSON::stringify(response) + "\n";
-	clients[p_client]->put_data((const uint8_t *)json_str.utf8().get_data(), json_str.utf8().length());
+// Commands can return PackedByteArray instead of base64 when this is true
+bool GodotBridge::_current_client_accepts_binary() const {
+	if (current_client < 0 || current_client >= clients.size()) {
+		return false;
+	}
+	return clients[current_client].send_encoding != ENCODING_JSON;
 }
 
-void GodotBridge::broadcast_event(const String &p_event, const Variant &p_data) {
+void GodotBridge::send_event(int p_client, const String &p_event, const Variant &p_data) {
+	if (p_client < 0 || p_client >= clients.size()) {
+		return;
+	}
+
 	Dictionary event_msg;
 	event_msg["type"] = "event";
 	event_msg["event"] = p_event;
 	event_msg["data"] = p_data;
 
-	String json_str = JSON::stringify(event_msg) + "\n";
-	PackedByteArray bytes;
-	bytes.resize(json_str.utf8().length());
-	memcpy(bytes.ptrw(), json_str.utf8().get_data(), json_str.utf8().length());
+	Vector<uint8_t> encoded = _encode_message(event_msg, clients[p_client].send_encoding);
+	_send_frame(p_client, clients[p_client].send_framing, encoded.ptr(), encoded.size());
+}
+
+// Queue an event for this frame's flush. Coalesced topics merge with an event
+// of the same topic that is already pending.
+void GodotBridge::broadcast_event(const String &p_event, const Variant &p_data) {
+	if (!_has_event_subscribers(p_event)) {
+		return;
+	}
+
+	const EventCoalescing *policy = event_coalescing.getptr(p_event);
+	EventCoalescing coalescing = policy ? *policy : EVENT_QUEUE;
+
+	if (coalescing != EVENT_QUEUE) {
+		const uint32_t *slot = pending_event_index.getptr(p_event);
+		if (slot) {
+			PendingEvent &pending = pending_events[*slot];
+			if (coalescing == EVENT_BATCH) {
+				pending.batch.push_back(p_data);
+			} else {
+				pending.data = p_data;
+			}
+			return;
+		}
+		pending_event_index.insert(p_event, pending_events.size());
+	}
+
+	PendingEvent pending;
+	pending.topic = p_event;
+	if (coalescing == EVENT_BATCH) {
+		pending.batch.push_back(p_data);
+	} else {
+		pending.data = p_data;
+	}
+	pending_events.push_back(pending);
+}
+
+void GodotBridge::_flush_events() {
+	if (selection_dirty) {
+		selection_dirty = false;
+		_emit_selection_changed();
+	}
+	_broadcast_scene_delta();
+	if (pending_events.is_empty()) {
+		return;
+	}
+
+	for (const PendingEvent &pending : pending_events) {
+		Dictionary event_msg;
+		event_msg["type"] = "event";
+		event_msg["event"] = pending.topic;
+		if (pending.batch.is_empty()) {
+			event_msg["data"] = pending.data;
+		} else {
+			Dictionary data;
+			data["events"] = pending.batch;
+			data["count"] = pending.batch.size();
+			event_msg["data"] = data;
+		}
+
+		// Serialize once per encoding in use, shared by every subscribed client
+		Vector<uint8_t> encoded[3];
+		for (int i = 0; i < clients.size(); i++) {
+			if (!_client_wants_event(clients[i], pending.topic)) {
+				continue;
+			}
+			WireEncoding encoding = clients[i].send_encoding;
+			if (encoded[encoding].is_empty()) {
+				encoded[encoding] = _encode_message(event_msg, encoding);
+			}
+			_send_frame(i, clients[i].send_framing, encoded[encoding].ptr(), encoded[encoding].size());
+		}
+	}
+
+	pending_events.clear();
+	pending_event_index.clear();
+}
+
+bool GodotBridge::_client_wants_event(const ClientConnection &p_conn, const String &p_topic) {
+	return p_conn.all_topics || p_conn.topics.has(p_topic);
+}
+
+bool GodotBridge::_has_event_subscribers(const String &p_topic) const {
+	for (int i = 0; i < clients.size(); i++) {
+		if (_client_wants_event(clients[i], p_topic)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+void GodotBridge::_send_frame(int p_client, FramingMode p_framing, const uint8_t *p_data, int p_size) {
+	const Ref<StreamPeerTCP> &peer = clients[p_client].peer;
+	uint64_t wire_size = p_size + (p_framing == FRAMING_LENGTH_PREFIXED ? 4 : 1);
+	clients.write[p_client].bytes_out += wire_size;
+	stats.record_wire(0, wire_size);
+	if (p_framing == FRAMING_LENGTH_PREFIXED) {
+		uint8_t header[4] = {
+			uint8_t((p_size >> 24) & 0xFF),
+			uint8_t((p_size >> 16) & 0xFF),
+			uint8_t((p_size >> 8) & 0xFF),
+			uint8_t(p_size & 0xFF),
+		};
+		peer->put_data(header, 4);
+		peer->put_data(p_data, p_size);
+	} else {
+		const uint8_t newline = '\n';
+		peer->put_data(p_data, p_size);
+		peer->put_data(&newline, 1);
+	}
+}
+
+// ============ Telemetry ============
+
+void GodotBridge::_record_job_stats(const BridgeJob *p_job, uint64_t p_bytes_out) {
+	uint64_t latency = OS::get_singleton()->get_ticks_usec() - p_job->received_usec;
+	stats.record_command(p_job->method, latency, p_job->exec_usec, p_job->bytes_in, p_bytes_out, p_job->failed);
+	if (p_job->traced && trace_file.is_valid()) {
+		_trace_job(p_job, p_bytes_out, latency);
+	}
+}
+
+bool GodotBridge::_result_failed(const Dictionary &p_result) {
+	return p_result.has("error") || !bool(p_result.get("success", true));
+}
 
+int GodotBridge::_total_queue_depth() const {
+	int depth = 0;
 	for (int i = 0; i < clients.size(); i++) {
-		clients[i]->put_data(bytes.ptr(), bytes.size());
+		depth += clients[i].queue.size();
+	}
+	return depth;
+}
+
+// Shown under "GodotBridge" in the debugger's Monitors tab
+static const char *bridge_monitor_names[] = {
+	"GodotBridge/Queue Depth",
+	"GodotBridge/Jobs In Flight",
+	"GodotBridge/Requests Per Second",
+	"GodotBridge/Bytes In Per Second",
+	"GodotBridge/Bytes Out Per Second",
+	"GodotBridge/P95 Latency (ms)",
+};
+
+void GodotBridge::_register_monitors() {
+	Performance *performance = Performance::get_singleton();
+	if (!performance) {
+		return;
+	}
+	_unregister_monitors();
+
+	Callable monitors[] = {
+		callable_mp(this, &GodotBridge::_monitor_queue_depth),
+		callable_mp(this, &GodotBridge::_monitor_jobs_in_flight),
+		callable_mp(this, &GodotBridge::_monitor_requests_per_sec),
+		callable_mp(this, &GodotBridge::_monitor_bytes_in_per_sec),
+		callable_mp(this, &GodotBridge::_monitor_bytes_out_per_sec),
+		callable_mp(this, &GodotBridge::_monitor_p95_latency),
+	};
+	for (int i = 0; i < int(sizeof(bridge_monitor_names) / sizeof(bridge_monitor_names[0])); i++) {
+		performance->add_custom_monitor(bridge_monitor_names[i], monitors[i], Vector<Variant>());
 	}
 }
 
+void GodotBridge::_unregister_monitors() {
+	Performance *performance = Performance::get_singleton();
+	if (!performance) {
+		return;
+	}
+	for (const char *name : bridge_monitor_names) {
+		if (performance->has_custom_monitor(name)) {
+			performance->remove_custom_monitor(name);
+		}
+	}
+}
+
+double GodotBridge::_monitor_queue_depth() {
+	return _total_queue_depth();
+}
+
+double GodotBridge::_monitor_jobs_in_flight() {
+	return in_flight_jobs.size();
+}
+
+double GodotBridge::_monitor_requests_per_sec() {
+	return stats.get_calls_per_sec();
+}
+
+double GodotBridge::_monitor_bytes_in_per_sec() {
+	return stats.get_bytes_in_per_sec();
+}
+
+double GodotBridge::_monitor_bytes_out_per_sec() {
+	return stats.get_bytes_out_per_sec();
+}
+
+double GodotBridge::_monitor_p95_latency() {
+	return stats.get_p95_msec();
+}
+
 // ============ Helper ============
 
 Node *GodotBridge::_get_node_by_path(const String &p_path) {
@@ -435,6 +1273,11 @@ Node *GodotBridge::_get_node_by_path(const String &p_path) {
 	if (p_path.is_empty() || p_path == "/" || p_path == ".") {
 		return edited_root;
 	}
+	// "#<handle>" from get_scene_tree / scene_delta
+	if (p_path.begins_with("#") && p_path.substr(1).is_valid_int()) {
+		Node *node = get_node_by_handle(uint32_t(p_path.substr(1).to_int()));
+		return node && (node == edited_root || edited_root->is_ancestor_of(node)) ? node : nullptr;
+	}
 	return edited_root->get_node_or_null(NodePath(p_path));
 #else
 	return nullptr;
@@ -443,76 +1286,168 @@ Node *GodotBridge::_get_node_by_path(const String &p_path) {
 
 // ============ Constructor/Destructor ============
 
+void GodotBridge::_init_event_topics() {
+	// State snapshots: only the newest one matters
+	event_coalescing["selection_changed"] = EVENT_LATEST;
+	event_coalescing["scene_changed"] = EVENT_LATEST;
+	event_coalescing["script_opened"] = EVENT_LATEST;
+	event_coalescing["plan_updated"] = EVENT_LATEST;
+	// Every occurrence matters, but one message per frame is enough
+	event_coalescing["runtime_error"] = EVENT_BATCH;
+	event_coalescing["diff_entry_added"] = EVENT_BATCH;
+	event_coalescing["navmesh_bake_progress"] = EVENT_BATCH;
+}
+
+thread_local uint32_t GodotBridge::dispatch_client_id = 0;
+
 GodotBridge::GodotBridge() {
+	_init_event_topics();
+	error_queue = memnew(BridgeErrorQueue);
+
 	// Set up error handler to capture runtime errors
 	error_handler.errfunc = _error_handler_callback;
 	error_handler.userdata = this;
 	add_error_handler(&error_handler);
-	print_line("GodotBridge: Runtime error handler registered");
+	BRIDGE_LOG("GodotBridge: Runtime error handler registered");
 }
 
 GodotBridge::~GodotBridge() {
 	remove_error_handler(&error_handler);
 	stop();
+	memdelete(error_queue);
+	error_queue = nullptr;
 }
 
 // ============ Runtime Error Handler ============
 
+// Called on whichever thread raised the error. Only copies into the
+// preallocated queue; everything else happens in _drain_errors().
 void GodotBridge::_error_handler_callback(void *p_self, const char *p_func, const char *p_file, int p_line, const char *p_error, const char *p_errorexp, bool p_editor_notify, ErrorHandlerType p_type) {
 	GodotBridge *self = static_cast<GodotBridge *>(p_self);
-	if (!self) return;
+	if (!self || !self->error_queue) return;
 	
-	// Build error message
-	String err_str;
-	if (p_errorexp && p_errorexp[0]) {
-		err_str = String::utf8(p_errorexp);
-	} else {
-		err_str = String::utf8(p_file) + ":" + itos(p_line) + " - " + String::utf8(p_error);
-	}
-	
-	// Create error dictionary
-	Dictionary error;
-	error["type"] = (p_type == ERR_HANDLER_WARNING) ? "warning" : "error";
-	error["message"] = err_str;
-	error["file"] = String::utf8(p_file);
-	error["line"] = p_line;
-	error["function"] = String::utf8(p_func);
-	error["error"] = String::utf8(p_error);
-	error["timestamp"] = OS::get_singleton()->get_ticks_msec();
-	
-	// Thread-safe storage (errors can come from any thread)
-	if (Thread::is_main_thread()) {
-		// Limit the number of stored errors
-		if (self->captured_errors.size() >= MAX_CAPTURED_ERRORS) {
-			self->captured_errors.remove_at(0);
-		}
-		self->captured_errors.push_back(error);
+	self->error_queue->push(p_func, p_file, p_line, p_error, p_errorexp, p_type == ERR_HANDLER_WARNING, Thread::is_main_thread(), OS::get_singleton()->get_ticks_msec());
+}
+
+// Move queued errors into the ring. Repeats of an error still in the ring
+// bump its count instead of taking a new slot.
+void GodotBridge::_drain_errors() {
+	BridgeErrorQueue::Entry entry;
+	while (error_queue->pop(entry)) {
+		String file = String::utf8(entry.file);
+		String error_text = String::utf8(entry.error);
+		String key = file + ":" + itos(entry.line) + ":" + error_text;
 		
-		// Broadcast error event to connected clients
-		if (self->is_running()) {
-			self->broadcast_event("runtime_error", error);
+		Dictionary error;
+		const uint64_t *seq = captured_error_index.getptr(key);
+		if (seq) {
+			error = captured_errors[*seq % MAX_CAPTURED_ERRORS];
+			error["count"] = int64_t(error["count"]) + 1;
+			error["timestamp"] = entry.timestamp_msec;
+		} else {
+			// Build error message
+			String err_str;
+			if (entry.errorexp[0]) {
+				err_str = String::utf8(entry.errorexp);
+			} else {
+				err_str = file + ":" + itos(entry.line) + " - " + error_text;
+			}
+			
+			error["type"] = entry.warning ? "warning" : "error";
+			error["message"] = err_str;
+			error["file"] = file;
+			error["line"] = entry.line;
+			error["function"] = String::utf8(entry.function);
+			error["error"] = error_text;
+			error["timestamp"] = entry.timestamp_msec;
+			error["first_timestamp"] = entry.timestamp_msec;
+			error["count"] = 1;
+			error["main_thread"] = entry.main_thread;
+			
+			// Evict the oldest entry once the ring is full
+			uint64_t slot_seq = captured_error_total++;
+			Dictionary &slot = captured_errors[slot_seq % MAX_CAPTURED_ERRORS];
+			if (!slot.is_empty()) {
+				String old_key = String(slot["file"]) + ":" + itos(int(slot["line"])) + ":" + String(slot["error"]);
+				captured_error_index.erase(old_key);
+			}
+			slot = error;
+			captured_error_index.insert(key, slot_seq);
+		}
+		
+		// Dictionaries are shared, so a pending entry sees later count updates
+		if (pending_error_keys.has(key)) {
+			continue;
+		}
+		if (pending_error_events.size() >= (uint32_t)MAX_CAPTURED_ERRORS) {
+			// An error storm: the ring holds only this many anyway
+			pending_error_overflow++;
+			continue;
 		}
+		pending_error_keys.insert(key);
+		pending_error_events.push_back(error);
+	}
+	dropped_errors += error_queue->take_dropped();
+}
+
+void GodotBridge::_broadcast_errors() {
+	if (pending_error_events.is_empty() && pending_error_overflow == 0) {
+		return;
 	}
+	uint64_t now = OS::get_singleton()->get_ticks_msec();
+	if (now - last_error_broadcast_msec < ERROR_BROADCAST_INTERVAL_MSEC) {
+		return;
+	}
+	
+	// runtime_error is a batched topic, so this goes out as one message
+	for (const Dictionary &error : pending_error_events) {
+		broadcast_event("runtime_error", error);
+	}
+	if (pending_error_overflow > 0) {
+		Dictionary overflow;
+		overflow["type"] = "overflow";
+		overflow["count"] = pending_error_overflow;
+		overflow["message"] = itos(pending_error_overflow) + " more errors since the last broadcast";
+		broadcast_event("runtime_error", overflow);
+		pending_error_overflow = 0;
+	}
+	pending_error_events.clear();
+	pending_error_keys.clear();
+	last_error_broadcast_msec = now;
 }
 
 Dictionary GodotBridge::get_runtime_errors() {
+	_drain_errors();
+	
 	Dictionary result;
 	Array errors;
 	
-	for (int i = 0; i < captured_errors.size(); i++) {
-		errors.push_back(captured_errors[i]);
+	uint64_t count = MIN(captured_error_total, (uint64_t)MAX_CAPTURED_ERRORS);
+	for (uint64_t seq = captured_error_total - count; seq < captured_error_total; seq++) {
+		errors.push_back(captured_errors[seq % MAX_CAPTURED_ERRORS]);
 	}
 	
 	result["errors"] = errors;
 	result["count"] = errors.size();
+	result["dropped"] = dropped_errors;
 	result["success"] = true;
 	return result;
 }
 
 Dictionary GodotBridge::clear_runtime_errors() {
+	_drain_errors();
+	
 	Dictionary result;
-	int count = captured_errors.size();
-	captured_errors.clear();
+	int count = MIN(captured_error_total, (uint64_t)MAX_CAPTURED_ERRORS);
+	for (int i = 0; i < MAX_CAPTURED_ERRORS; i++) {
+		captured_errors[i] = Dictionary();
+	}
+	captured_error_total = 0;
+	captured_error_index.clear();
+	pending_error_events.clear();
+	pending_error_keys.clear();
+	pending_error_overflow = 0;
+	dropped_errors = 0;
 	
 	result["cleared_count"] = count;
 	result["success"] = true;
@@ -529,35 +1464,58 @@ void GodotBridge::_connect_editor_signals() {
 	
 	EditorInterface *editor = EditorInterface::get_singleton();
 	if (!editor) {
-		print_line("GodotBridge: EditorInterface not available yet");
+		BRIDGE_LOG("GodotBridge: EditorInterface not available yet");
 		return;
 	}
 	
 	EditorSelection *selection = editor->get_selection();
 	if (selection) {
 		selection->connect("selection_changed", callable_mp(this, &GodotBridge::_on_selection_changed));
-		print_line("GodotBridge: Connected to selection_changed signal");
+		BRIDGE_LOG("GodotBridge: Connected to selection_changed signal");
 	}
 	
 	EditorNode *editor_node = EditorNode::get_singleton();
 	if (editor_node) {
 		editor_node->connect("scene_changed", callable_mp(this, &GodotBridge::_on_scene_changed));
-		print_line("GodotBridge: Connected to scene_changed signal");
+		BRIDGE_LOG("GodotBridge: Connected to scene_changed signal");
 	}
 	
 	ScriptEditor *script_editor = ScriptEditor::get_singleton();
 	if (script_editor) {
 		script_editor->connect("editor_script_changed", callable_mp(this, &GodotBridge::_on_script_opened));
-		print_line("GodotBridge: Connected to editor_script_changed signal");
+		BRIDGE_LOG("GodotBridge: Connected to editor_script_changed signal");
+	}
+
+	EditorFileSystem *efs = EditorFileSystem::get_singleton();
+	if (efs) {
+		efs->connect("filesystem_changed", callable_mp(this, &GodotBridge::_on_filesystem_changed));
+		BRIDGE_LOG("GodotBridge: Connected to filesystem_changed signal");
+	}
+
+	SceneTree *tree = get_tree();
+	if (tree) {
+		tree->connect("node_added", callable_mp(this, &GodotBridge::_on_tree_node_added));
+		tree->connect("node_removed", callable_mp(this, &GodotBridge::_on_tree_node_removed));
+		tree->connect("node_renamed", callable_mp(this, &GodotBridge::_on_tree_node_renamed));
+		BRIDGE_LOG("GodotBridge: Connected to scene tree node signals");
 	}
 	
 	editor_hooks_connected = true;
-	print_line("GodotBridge: Editor hooks connected!");
+	BRIDGE_LOG("GodotBridge: Editor hooks connected!");
 #endif
 }
 
+// Box selection fires this once per node; the event is built at flush time
 void GodotBridge::_on_selection_changed() {
+	selection_dirty = true;
+}
+
+void GodotBridge::_emit_selection_changed() {
 #ifdef TOOLS_ENABLED
+	if (!_has_event_subscribers("selection_changed")) {
+		return;
+	}
+
 	EditorInterface *editor = EditorInterface::get_singleton();
 	if (!editor) return;
 	
@@ -583,7 +1541,7 @@ void GodotBridge::_on_selection_changed() {
 	event_data["count"] = selected_nodes.size();
 	
 	broadcast_event("selection_changed", event_data);
-	print_line("GodotBridge: Selection changed - " + itos(selected_nodes.size()) + " nodes");
+	BRIDGE_LOG_VERBOSE("GodotBridge: Selection changed - " + itos(selected_nodes.size()) + " nodes");
 #endif
 }
 
@@ -606,7 +1564,7 @@ void GodotBridge::_on_scene_changed() {
 	}
 	
 	broadcast_event("scene_changed", event_data);
-	print_line("GodotBridge: Scene changed - " + String(event_data.get("path", "")));
+	BRIDGE_LOG_VERBOSE("GodotBridge: Scene changed - " + String(event_data.get("path", "")));
 #endif
 }
 
@@ -625,6 +1583,38 @@ void GodotBridge::_on_script_opened(const Ref<Script> &p_script) {
 	}
 	
 	broadcast_event("script_opened", event_data);
-	print_line("GodotBridge: Script opened - " + String(event_data.get("path", "")));
+	BRIDGE_LOG_VERBOSE("GodotBridge: Script opened - " + String(event_data.get("path", "")));
+#endif
+}
+
+// The next search_in_scripts re-reads whatever changed. Scripts are listed
+// from the editor's in-memory tree, so the index never walks the disk itself,
+// and the same walk logs deleted files for list_files.
+void GodotBridge::_on_filesystem_changed() {
+#ifdef TOOLS_ENABLED
+	EditorFileSystem *efs = EditorFileSystem::get_singleton();
+	if (efs && efs->get_filesystem()) {
+		HashMap<String, uint64_t> scripts;
+		HashSet<String> all_files;
+		LocalVector<EditorFileSystemDirectory *> dirs;
+		dirs.push_back(efs->get_filesystem());
+		for (uint32_t d = 0; d < dirs.size(); d++) {
+			EditorFileSystemDirectory *dir = dirs[d];
+			for (int i = 0; i < dir->get_subdir_count(); i++) {
+				dirs.push_back(dir->get_subdir(i));
+			}
+			for (int i = 0; i < dir->get_file_count(); i++) {
+				String path = dir->get_file_path(i);
+				all_files.insert(path);
+				if (dir->get_file(i).ends_with(".gd")) {
+					scripts.insert(path, dir->get_file_modified_time(i));
+				}
+			}
+		}
+		script_index.set_file_list(scripts);
+		_track_deleted_files(all_files);
+		return;
+	}
 #endif
+	script_index.mark_dirty();
 }
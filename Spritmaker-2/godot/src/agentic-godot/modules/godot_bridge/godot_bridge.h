@@ -5,17 +5,279 @@
 #include "core/io/tcp_server.h"
 #include "core/io/stream_peer_tcp.h"
 #include "core/io/json.h"
+#include "core/io/file_access.h"
 #include "core/error/error_macros.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/hash_set.h"
+#include "core/templates/safe_refcount.h"
+#include "core/object/worker_thread_pool.h"
+#include "core/os/mutex.h"
 #include "bridge_command_registry.h"
+#include "bridge_result_stream.h"
+#include "bridge_stats.h"
+#include "bridge_error_queue.h"
+#include "bridge_script_index.h"
+
+// Optional list_files filters, matched against EditorFileSystem's cached entries
+// or, when the editor can't serve the path, against a disk walk
+struct ListFilesFilter {
+	String pattern;                // Glob on the file name, case-insensitive ("*_enemy.tscn")
+	HashSet<String> extensions;    // Lowercase, without the dot
+	uint64_t changed_since = 0;    // Unix time; only files modified at or after it
+	HashSet<String> seen;          // Paths already reported at changed_since, skipped
+	bool include_size = false;     // Sizes cost one file open each
+	bool is_active() const { return !pattern.is_empty() || !extensions.is_empty() || changed_since > 0; }
+	bool is_changed(const String &p_path, uint64_t p_time) const {
+		return changed_since == 0 || p_time > changed_since || (p_time == changed_since && !seen.has(p_path));
+	}
+};
+
+// Where a changed_since poll continues. Times have one-second resolution, so
+// besides the newest time it keeps the paths reported at that second.
+struct ListFilesCursor {
+	uint64_t timestamp = 0;
+	HashSet<String> seen;
+	void note(const String &p_path, uint64_t p_time) {
+		if (p_time > timestamp) {
+			timestamp = p_time;
+			seen.clear();
+		}
+		if (p_time == timestamp) {
+			seen.insert(p_path);
+		}
+	}
+	void write(Dictionary &r_info) const {
+		Array paths;
+		for (const String &path : seen) {
+			paths.push_back(path);
+		}
+		r_info["timestamp"] = timestamp;
+		r_info["seen"] = paths;
+	}
+	ListFilesCursor() {}
+	ListFilesCursor(const ListFilesFilter &p_filter) :
+			timestamp(p_filter.changed_since), seen(p_filter.seen) {}
+};
 
 class GodotBridge : public Node {
 	GDCLASS(GodotBridge, Node);
 
+public:
+	// Wire framing, negotiated per client via the set_framing command
+	enum FramingMode {
+		FRAMING_NEWLINE,         // UTF-8 JSON terminated by '\n' (default)
+		FRAMING_LENGTH_PREFIXED, // 4-byte big-endian length followed by the payload
+	};
+
+	// Message encoding, negotiated per client via the set_encoding command.
+	// Binary encodings always use length-prefixed framing.
+	enum WireEncoding {
+		ENCODING_JSON,     // UTF-8 JSON text (default, used by older clients)
+		ENCODING_VARIANT,  // Godot encode_variant() binary
+		ENCODING_MSGPACK,  // MessagePack, Godot types as ext values
+	};
+
+	// Console logging level (the "verbosity" property)
+	enum LogVerbosity {
+		LOG_QUIET,    // Errors only
+		LOG_NORMAL,   // Lifecycle: listening, connects, disconnects (default)
+		LOG_VERBOSE,  // Every message and response
+	};
+
 private:
+	struct BridgeJob;
+
+	// Per-client connection state. Received bytes are appended to recv_buffer
+	// and consumed from recv_offset; the buffer is compacted lazily so large
+	// payloads are never re-copied while a frame is still incomplete.
+	struct ClientConnection {
+		uint32_t id = 0;  // Stable across disconnects of other clients
+		Ref<StreamPeerTCP> peer;
+		LocalVector<uint8_t> recv_buffer;
+		uint32_t recv_offset = 0;
+		uint32_t scan_offset = 0;  // Resume point for newline scanning
+		FramingMode recv_framing = FRAMING_NEWLINE;
+		FramingMode send_framing = FRAMING_NEWLINE;
+		WireEncoding recv_encoding = ENCODING_JSON;
+		WireEncoding send_encoding = ENCODING_JSON;
+
+		// Jobs not yet dispatched, in arrival order
+		LocalVector<BridgeJob *> queue;
+		int jobs_in_flight = 0;   // Dispatched jobs whose response is not written yet
+		int reads_in_flight = 0;  // Thread-safe jobs still running on workers
+		bool paused = false;      // Backpressure: socket reads suspended
+
+		// Event topics this client receives; every topic until its first subscribe
+		bool all_topics = true;
+		HashSet<String> topics;
+
+		// Telemetry
+		uint64_t connected_msec = 0;
+		uint64_t bytes_in = 0;
+		uint64_t bytes_out = 0;
+		uint64_t requests = 0;
+	};
+
+	// A request moving through the pipeline. Jobs are owned by the main thread,
+	// which hands them to WorkerThreadPool for parsing, thread-safe execution and
+	// response encoding. Worker tasks only touch the job they were given.
+	struct BridgeJob {
+		enum State {
+			STATE_PARSING,   // Worker is decoding the message
+			STATE_READY,     // Parsed, waiting for its turn in client order
+			STATE_RUNNING,   // Thread-safe command executing on a worker
+			STATE_ENCODING,  // Main-thread result being serialized on a worker
+			STATE_DONE,      // Response encoded (or nothing to send)
+		};
+
+		uint32_t client_id = 0;
+		Vector<uint8_t> raw;
+		WireEncoding raw_encoding = ENCODING_JSON;
+		String id;
+		String method;
+		Dictionary params;
+		Dictionary result;
+		Vector<uint8_t> encoded;
+		String cursor;  // Result cursor opened by the command, claimed on finish
+		bool valid = false;
+		bool failed = false;  // Result carried an error
+		uint32_t bytes_in = 0;
+		uint64_t received_usec = 0;
+		uint64_t exec_usec = 0;
+		bool traced = false;  // Keep raw after parsing for the trace file
+		BridgeCommandThreading threading = COMMAND_MAIN_THREAD;
+		BridgeCommandPriority priority = COMMAND_PRIORITY_NORMAL;
+		// Response format, captured at dispatch so a later renegotiation
+		// can't change how this response is framed
+		FramingMode framing = FRAMING_NEWLINE;
+		WireEncoding encoding = ENCODING_JSON;
+		SafeNumeric<uint32_t> state;
+		WorkerThreadPool::TaskID task_id = WorkerThreadPool::INVALID_TASK_ID;
+	};
+
+	static const uint32_t MAX_FRAME_SIZE = 64 * 1024 * 1024;
+
 	Ref<TCPServer> server;
-	Vector<Ref<StreamPeerTCP>> clients;
-	Vector<String> client_buffers;  // Per-client TCP receive buffers for message framing
+	Vector<ClientConnection> clients;
+	uint32_t next_client_id = 1;
+	int current_client = -1;  // Client whose message is being dispatched
+	LocalVector<BridgeJob *> in_flight_jobs;  // Dispatched jobs awaiting their response; main thread only
+
+	// Scheduler limits
+	static const int DEFAULT_FRAME_BUDGET_USEC = 5000;
+	static const int DEFAULT_MAX_CLIENT_QUEUE = 256;
+	int frame_budget_usec = DEFAULT_FRAME_BUDGET_USEC;
+	int max_client_queue = DEFAULT_MAX_CLIENT_QUEUE;
+	int round_robin_cursor = 0;
+	int verbosity = LOG_NORMAL;
+	BridgeStats stats;  // Main thread only
+	BridgeScriptIndex script_index;  // search_in_scripts, dirtied by filesystem changes
+
+	// read_file content hashes, valid while mtime and size are unchanged and the
+	// file was last modified in an earlier second than it was hashed (mtimes
+	// have one-second resolution). Bridge writes drop the entry outright.
+	struct FileHashEntry {
+		uint64_t mtime = 0;
+		uint64_t size = 0;
+		uint64_t hashed_at = 0;  // Unix time the hash was computed
+		String hash;
+	};
+	static const uint32_t MAX_FILE_HASH_CACHE = 4096;
+	HashMap<String, FileHashEntry> file_hash_cache;
+	Mutex file_hash_mutex;  // read_file runs on worker threads
+	String _file_content_hash(const String &p_path, uint64_t p_mtime, uint64_t p_size);
+	void _store_file_hash(const String &p_path, uint64_t p_mtime, uint64_t p_size, const String &p_hash);
+	void _invalidate_file_hash(const String &p_path);
+
+	// Files in EditorFileSystem's tree at its last change. Paths that disappear
+	// are logged with the unix time they were noticed, so list_files
+	// changed_since polls can report deletions. Main thread only.
+	struct DeletedFile {
+		String path;
+		uint64_t deleted_at = 0;
+	};
+	static const uint32_t MAX_DELETED_FILES = 4096;
+	HashSet<String> known_files;
+	bool known_files_ready = false;
+	LocalVector<DeletedFile> deleted_files;  // Oldest first
+	uint64_t deleted_log_since = 0;          // Deletions before this are not in the log
+	void _track_deleted_files(const HashSet<String> &p_files);
+	void _list_deleted_files(const String &p_dir, bool p_recursive, const ListFilesFilter &p_filter, ListFilesCursor &r_cursor, Dictionary &r_result) const;
+
+	// Protocol trace (trace_start / GODOT_BRIDGE_TRACE), replayed by tools/bridge_replay.py
+	Ref<FileAccess> trace_file;
+	uint64_t trace_start_usec = 0;
+
+	// Paginated results. Cursors may be opened by worker commands, so the map
+	// is guarded by cursor_mutex; paging and closing only happen on the main thread.
+	struct ResultCursor {
+		BridgeResultStream *stream = nullptr;
+		String items_key;
+		int page_size = 0;
+		uint32_t client_id = 0;  // Client whose command opened it (0 for internal calls)
+		String request_id;       // Pushed chunks are tagged with the original request id
+		bool claimed = false;    // Top-level response written; request_id and push are set
+		bool push = false;
+		int seq = 0;
+		uint64_t last_used_msec = 0;
+	};
+	static const int DEFAULT_PAGE_SIZE = 200;
+	static const int MAX_PAGE_SIZE = 5000;
+	static const uint64_t CURSOR_TIMEOUT_MSEC = 5 * 60 * 1000;
+	HashMap<String, ResultCursor> result_cursors;
+	Mutex cursor_mutex;
+	// Client whose command is executing on this thread, including every step of
+	// a batch, so cursors are owned by the requester from the moment they open
+	static thread_local uint32_t dispatch_client_id;
+	SafeNumeric<uint32_t> next_cursor_id;
 	CommandRegistry command_registry;
+
+	// Events are queued by broadcast_event() and flushed once per frame, merged
+	// per topic, serialized once per encoding and sent to subscribed clients only
+	enum EventCoalescing {
+		EVENT_QUEUE,   // Deliver every event in order (default for unknown topics)
+		EVENT_LATEST,  // Deliver only the frame's latest event
+		EVENT_BATCH,   // Deliver the frame's events as one {events, count} message
+	};
+	struct PendingEvent {
+		String topic;
+		Variant data;
+		Array batch;
+	};
+	HashMap<String, EventCoalescing> event_coalescing;
+	LocalVector<PendingEvent> pending_events;
+	HashMap<String, uint32_t> pending_event_index;  // Coalesced topic -> pending_events slot
+	bool selection_dirty = false;  // Selection event is built at flush, once per frame
+
+	// Stable node handles: small integers instead of ObjectIDs, which don't
+	// survive JSON number precision
+	HashMap<uint64_t, uint32_t> node_handles;  // ObjectID -> handle
+	HashMap<uint32_t, uint64_t> handle_nodes;  // handle -> ObjectID
+	uint32_t next_node_handle = 1;
+	LocalVector<uint32_t> removed_handles;  // Left the tree this frame; released unless re-added
+
+	// Versioned change log of the edited scene for incremental sync
+	enum SceneChangeOp {
+		SCENE_NODE_ADDED,
+		SCENE_NODE_REMOVED,
+		SCENE_NODE_RENAMED,
+	};
+	struct SceneChange {
+		uint64_t version = 0;
+		SceneChangeOp op = SCENE_NODE_ADDED;
+		uint32_t handle = 0;
+		uint32_t parent_handle = 0;
+		String name;
+		String type;
+		String path;
+	};
+	static const uint32_t MAX_SCENE_CHANGES = 4096;
+	static const int MAX_DELTA_EVENT_CHANGES = 256;
+	uint64_t scene_version = 1;
+	uint64_t scene_log_base = 1;          // Oldest version the log can catch up from
+	uint64_t broadcast_scene_version = 1;  // Last version sent as scene_delta
+	LocalVector<SceneChange> scene_changes;
+	ObjectID tracked_scene_root;
 	int port = 9876;
 	bool running = false;
 	bool editor_hooks_connected = false;
@@ -24,29 +286,200 @@ private:
 	Vector<Dictionary> action_history;
 	Dictionary current_plan;
 	
-	// Runtime error capture
+	// Runtime error capture. Any thread pushes into error_queue without locking
+	// or allocating; the main thread drains it into a fixed ring of
+	// deduplicated entries and broadcasts new ones at a limited rate.
 	ErrorHandlerList error_handler;
 	static void _error_handler_callback(void *p_self, const char *p_func, const char *p_file, int p_line, const char *p_error, const char *p_errorexp, bool p_editor_notify, ErrorHandlerType p_type);
-	Vector<Dictionary> captured_errors;
+	BridgeErrorQueue *error_queue = nullptr;
 	static const int MAX_CAPTURED_ERRORS = 50;
+	static const uint64_t ERROR_BROADCAST_INTERVAL_MSEC = 250;
+	Dictionary captured_errors[MAX_CAPTURED_ERRORS];  // Ring, oldest at captured_error_total - count
+	uint64_t captured_error_total = 0;                // Entries ever stored
+	HashMap<String, uint64_t> captured_error_index;   // Dedup key -> entry sequence number
+	uint64_t dropped_errors = 0;
+	LocalVector<Dictionary> pending_error_events;     // New or repeated errors not yet broadcast, at most MAX_CAPTURED_ERRORS
+	HashSet<String> pending_error_keys;
+	uint64_t pending_error_overflow = 0;              // Errors past that cap, sent as one count
+	uint64_t last_error_broadcast_msec = 0;
+	void _drain_errors();
+	void _broadcast_errors();
+
+	// Navigation bakes run on the navigation server's threads; the bridge only
+	// tracks them and reports progress until the region's bake_finished arrives
+	struct NavBakeJob {
+		ObjectID region;
+		String region_path;
+		bool is_3d = false;
+		bool cancelled = false;
+		Ref<Resource> backup;  // Navigation resource before the bake, restored on cancel
+		uint64_t started_msec = 0;
+		uint64_t idle_since_msec = 0;  // Region stopped baking but bake_finished hasn't arrived
+	};
+	static const uint64_t NAV_BAKE_PROGRESS_INTERVAL_MSEC = 250;
+	static const uint64_t NAV_BAKE_IDLE_TIMEOUT_MSEC = 1000;
+	HashMap<String, NavBakeJob> nav_bake_jobs;
+	uint32_t next_nav_bake_id = 1;
+	uint64_t last_nav_bake_progress_msec = 0;
+	void _on_nav_bake_finished(const String &p_job_id);
+	void _drop_nav_bake(const String &p_job_id, const String &p_error, uint64_t p_now_msec);
+	void _pump_nav_bakes();
+	static Dictionary _nav_bake_info(const String &p_job_id, const NavBakeJob &p_job, uint64_t p_now_msec);
+
+	// Viewport captures: the readback happens on the main thread, resizing,
+	// change detection and encoding on WorkerThreadPool. Async captures and
+	// capture streams deliver their frames as events to the requesting client.
+	struct CaptureSettings {
+		int max_size = 0;        // Longest side in pixels, 0 keeps the full size
+		String format = "png";   // png, jpg or webp
+		float quality = 0.8f;    // jpg/webp
+		bool binary = false;     // Raw bytes for binary encodings instead of base64
+	};
+	struct CaptureTask {
+		uint32_t client_id = 0;
+		uint32_t capture_id = 0;
+		uint32_t stream_id = 0;  // 0 for one-shot captures
+		String viewport;
+		String save_path;        // Empty returns the encoded bytes
+		CaptureSettings settings;
+		Ref<Image> image;
+		uint32_t previous_hash = 0;
+		// Written by the worker
+		Vector<uint8_t> data;
+		String base64;
+		int width = 0;
+		int height = 0;
+		int source_width = 0;
+		int source_height = 0;
+		uint32_t hash = 0;
+		bool unchanged = false;
+		String error;
+		WorkerThreadPool::TaskID task_id = WorkerThreadPool::INVALID_TASK_ID;
+	};
+	struct CaptureStream {
+		uint32_t client_id = 0;
+		String viewport;
+		CaptureSettings settings;
+		uint64_t interval_usec = 0;
+		uint64_t next_capture_usec = 0;
+		uint32_t last_hash = 0;
+		uint32_t seq = 0;
+		bool encoding = false;  // One frame in flight; due frames are skipped meanwhile
+		uint64_t frames_sent = 0;
+		uint64_t frames_unchanged = 0;
+		uint64_t frames_skipped = 0;
+	};
+	LocalVector<CaptureTask *> capture_tasks;
+	HashMap<uint32_t, CaptureStream> capture_streams;
+	uint32_t next_capture_id = 1;
+	static void _encode_capture(CaptureTask *p_task);
+	static void _encode_capture_task(void *p_task);
+	Viewport *_get_capture_viewport(const String &p_viewport, String &r_error);
+	CaptureSettings _read_capture_settings(const Dictionary &p_options) const;
+	static void _capture_result(const CaptureTask *p_task, Dictionary &r_result);
+	void _pump_captures();
+	void _cancel_captures();
+
+	// Paths written in a burst (one per frame file, typically) are imported
+	// together: assets_update_file/_files/_reimport only queue, and the queue
+	// is flushed once it has been quiet for IMPORT_DEBOUNCE_MSEC, or after
+	// IMPORT_MAX_DELAY_MSEC at the latest, as one reimport_files call. The
+	// queue is pumped even while the server isn't running.
+	static const uint64_t IMPORT_DEBOUNCE_MSEC = 250;
+	static const uint64_t IMPORT_MAX_DELAY_MSEC = 2000;
+	LocalVector<String> pending_imports;
+	HashSet<String> pending_import_set;
+	uint64_t import_first_msec = 0;
+	uint64_t import_last_msec = 0;
+	void _pump_imports();
+
+	// Embedded editor JS queries answer through GDBrowserView::query_javascript
+	Object *_get_spritemancer_browser(String &r_error);
+	void _on_js_query_result(int p_query_id, const Variant &p_result, const String &p_error, uint32_t p_client_id, const String &p_save_path);
+	static Variant _js_value_for_client(const Variant &p_value, bool p_binary, const String &p_save_path, Array &r_saved);
 
 	void _process_client(int index);
-	void _handle_message(const String &p_message, int p_client_index);
+	void _extract_frames(int p_index);
+	void _send_frame(int p_client, FramingMode p_framing, const uint8_t *p_data, int p_size);
+	void _enqueue_message(const uint8_t *p_data, int p_size, int p_client_index);
+	void _pump_jobs();
+	void _collect_finished_jobs();
+	int _pick_next_client() const;
+	void _dispatch_job(int p_client_index);
+	void _update_backpressure(int p_client_index);
+	void _drop_client_jobs(int p_client_index);
+	void _finish_job(BridgeJob *p_job);
+	void _execute_main_job(BridgeJob *p_job, int p_client_index);
+	void _write_job_response(BridgeJob *p_job);
+	void _reap_job_task(BridgeJob *p_job);
+	void _cancel_all_jobs();
+	int _find_client(uint32_t p_client_id) const;
+	void _parse_job_task(BridgeJob *p_job);
+	void _run_job_task(BridgeJob *p_job);
+	void _encode_job_task(BridgeJob *p_job);
+	static Vector<uint8_t> _encode_message(const Dictionary &p_message, WireEncoding p_encoding);
+	static Vector<uint8_t> _encode_response(const String &p_id, const Variant &p_result, WireEncoding p_encoding);
+	static Error _decode_message(const Vector<uint8_t> &p_data, WireEncoding p_encoding, Dictionary &r_message);
+	bool _current_client_accepts_binary() const;
+	Dictionary _dispatch_command(const String &p_method, const Dictionary &p_params);
+
+	// Result paging helpers
+	void _page_result(Dictionary &r_result, const String &p_items_key, BridgeResultStream *p_stream, int p_page_size);
+	void _claim_cursor(const String &p_cursor, uint32_t p_client_id, const String &p_request_id, bool p_push);
+	void _pump_streams(uint64_t p_frame_start);
+	void _expire_cursors();
+	void _clear_cursors();
+
+	// Telemetry
+	void _record_job_stats(const BridgeJob *p_job, uint64_t p_bytes_out);
+	void _trace_job(const BridgeJob *p_job, uint64_t p_bytes_out, uint64_t p_latency_usec);
+	static bool _result_failed(const Dictionary &p_result);
+	int _total_queue_depth() const;
+	void _register_monitors();
+	void _unregister_monitors();
+	double _monitor_queue_depth();
+	double _monitor_jobs_in_flight();
+	double _monitor_requests_per_sec();
+	double _monitor_bytes_in_per_sec();
+	double _monitor_bytes_out_per_sec();
+	double _monitor_p95_latency();
+	
+	// Batch helpers: resolve "${N.key}" references to earlier step results
+	Variant _resolve_batch_refs(const Variant &p_value, const Array &p_results);
+	String _resolve_batch_string(const String &p_value, const Array &p_results);
 	
 	// Helper to get node from scene tree
 	Node *_get_node_by_path(const String &p_path);
 	
 	// Helper for deep scene tree serialization (Phase 0)
-	Dictionary _serialize_node_recursive(Node *p_node, int p_current_depth, int p_max_depth);
+	Dictionary _serialize_node_recursive(Node *p_node, const String &p_path, int p_current_depth, int p_max_depth);
+
+	// Incremental scene sync
+	bool _track_scene_node(Node *p_node);
+	void _release_removed_handles();
+	void _record_scene_change(SceneChangeOp p_op, Node *p_node);
+	bool _scene_changes_since(uint64_t p_since_version, Array &r_changes, int p_limit) const;
+	void _broadcast_scene_delta();
+	void _on_tree_node_added(Node *p_node);
+	void _on_tree_node_removed(Node *p_node);
+	void _on_tree_node_renamed(Node *p_node);
 	
 	// Command registry initialization
 	void _init_command_registry();
+	void _init_event_topics();
+
+	// Event delivery
+	void _flush_events();
+	bool _has_event_subscribers(const String &p_topic) const;
+	static bool _client_wants_event(const ClientConnection &p_conn, const String &p_topic);
 	
 	// Editor event hooks
 	void _connect_editor_signals();
 	void _on_selection_changed();
+	void _emit_selection_changed();
 	void _on_scene_changed();
 	void _on_script_opened(const Ref<Script> &p_script);
+	void _on_filesystem_changed();
 	
 	// Helper to collect node configuration warnings
 	void _collect_node_warnings(Node *p_node, Array &r_warnings);
@@ -60,14 +493,26 @@ public:
 	void stop();
 	bool is_running() const;
 
+	void set_frame_budget_msec(float p_msec);
+	float get_frame_budget_msec() const;
+	void set_max_client_queue(int p_max);
+	int get_max_client_queue() const;
+	void set_verbosity(int p_level);
+	int get_verbosity() const;
+
 	void send_response(int p_client, const String &p_id, const Variant &p_result);
+	void send_event(int p_client, const String &p_event, const Variant &p_data);
 	void broadcast_event(const String &p_event, const Variant &p_data);
 	
 	// Plan accessor for AI Panel
 	Dictionary get_current_plan() const { return current_plan; }
 
 	// Real Godot API implementations
-	Dictionary get_scene_tree(int p_max_depth = 5);
+	Dictionary get_scene_tree(int p_max_depth = 5, int p_page_size = 0);
+	Dictionary get_scene_changes(int64_t p_since_version);
+	Dictionary query_nodes(const Dictionary &p_query);
+	uint32_t get_node_handle(Node *p_node);
+	Node *get_node_by_handle(uint32_t p_handle);
 	Dictionary create_scene(const String &p_path, const String &p_root_type);
 	Dictionary add_node(const String &p_parent, const String &p_type, const String &p_name);
 	Dictionary remove_node(const String &p_path);
@@ -87,6 +532,7 @@ public:
 	// Phase 5: Advanced AI
 	Dictionary read_script(const String &p_path);
 	Dictionary edit_script(const String &p_path, const String &p_content);
+	Dictionary patch_script(const String &p_path, const Array &p_edits, const String &p_diff, const String &p_base_hash);
 	Dictionary get_errors();
 	Dictionary get_runtime_errors();
 	Dictionary clear_runtime_errors();
@@ -97,9 +543,9 @@ public:
 	Dictionary get_node_info(const String &p_path);
 	Dictionary copy_node(const String &p_from, const String &p_to_scene);
 	// File System
-	Dictionary list_files(const String &p_path, bool p_recursive = false);
+	Dictionary list_files(const String &p_path, bool p_recursive = false, int p_page_size = 0, const ListFilesFilter &p_filter = ListFilesFilter(), bool p_from_disk = false);
 	void _list_files_internal(const String &p_path, bool p_recursive, Array &r_files, Array &r_folders);
-	Dictionary read_file(const String &p_path);
+	Dictionary read_file(const String &p_path, int64_t p_offset = 0, int64_t p_length = -1, int p_start_line = 0, int p_line_count = 0, const String &p_encoding = "text", const String &p_if_none_match = "", bool p_with_hash = false);
 	Dictionary create_folder(const String &p_path);
 	Dictionary delete_file(const String &p_path);
 	// Signals & Connections
@@ -108,7 +554,7 @@ public:
 	
 	// Phase 7: Input & Project Config
 	Dictionary add_input_action(const String &p_action, const String &p_key);
-	Dictionary list_input_actions();
+	Dictionary list_input_actions(int p_page_size = 0);
 	Dictionary set_project_setting(const String &p_setting, const Variant &p_value);
 	Dictionary get_project_setting(const String &p_setting);
 	
@@ -126,7 +572,7 @@ public:
 	
 	// Phase 10: Enhanced Agent Capabilities
 	Dictionary undo_last_action();
-	Dictionary search_in_scripts(const String &p_pattern, bool p_is_regex);
+	Dictionary search_in_scripts(const String &p_pattern, bool p_is_regex, int p_page_size = 50);
 	Dictionary get_selected_nodes();
 	Dictionary get_selected_text();
 	Dictionary get_selected_files();
@@ -136,9 +582,11 @@ public:
 	// Phase 11: Context & Asset Pipeline
 	Dictionary get_open_scenes();
 	Dictionary assets_scan();
-	Dictionary assets_update_file(const String &p_path);
-	Dictionary assets_update_files(const Array &p_paths);
-	Dictionary assets_reimport(const String &p_path);
+	Dictionary assets_update_file(const String &p_path, bool p_wait = false);
+	Dictionary assets_update_files(const Array &p_paths, bool p_wait = false);
+	Dictionary assets_reimport(const String &p_path, bool p_wait = false);
+	Dictionary assets_flush_imports();
+	void queue_import(const String &p_path);
 	Dictionary assets_move_and_rename(const String &p_from, const String &p_to);
 	
 	// Phase 12: Scene Persistence
@@ -154,10 +602,13 @@ public:
 	
 	// Phase 13: TileMap & Navigation
 	Dictionary tileset_create_atlas(const String &p_tileset_path, const String &p_texture_path, int p_tile_size);
-	Dictionary map_set_cells_batch(const String &p_tilemap, const Array &p_cells);
+	Dictionary map_set_cells_batch(const String &p_tilemap, const Array &p_cells, const Dictionary &p_packed = Dictionary());
+	Dictionary map_get_cells(const String &p_tilemap, const Rect2i &p_rect, const String &p_format = "columns");
 	Dictionary map_clear_layer(const String &p_tilemap);
 	Dictionary map_fill_rect(const String &p_tilemap, int p_start_x, int p_start_y, int p_width, int p_height, int p_source, int p_atlas_x, int p_atlas_y);
 	Dictionary navmesh_bake(const String &p_region);
+	Dictionary navmesh_bake_cancel(const String &p_job_id);
+	Dictionary navmesh_bake_status(const String &p_job_id);
 	
 	// Phase 14: Build Pipeline
 	Dictionary build_execute(const String &p_preset, const String &p_output_path);
@@ -167,19 +618,49 @@ public:
 	Dictionary set_current_plan(const String &p_name, const Array &p_steps);
 	Dictionary add_diff_entry(const String &p_file, const String &p_status);
 	Dictionary clear_diff_entries();
-	Dictionary capture_viewport(const String &p_save_path, const String &p_viewport);
+	Dictionary capture_viewport(const String &p_save_path, const String &p_viewport, const Dictionary &p_options = Dictionary());
+	Dictionary capture_stream_start(const String &p_viewport, float p_fps, const Dictionary &p_options);
+	Dictionary capture_stream_stop(int p_stream_id);
 	Dictionary get_runtime_state(const String &p_node_path, const Array &p_properties);
 	Dictionary create_sprite_frames(const String &p_path, const String &p_sprite_sheet, int p_frame_width, int p_frame_height, int p_columns, const Array &p_animations);
 	
 	// Phase 16: Individual Frame Animation & SpriteMancer UI Control
-	Dictionary create_sprite_frames_from_images(const String &p_path, const Array &p_animations);
+	Dictionary create_sprite_frames_from_images(const String &p_path, const Array &p_animations, const Dictionary &p_options = Dictionary());
 	Dictionary spritemancer_open_project(const String &p_project_id);
 	Dictionary spritemancer_execute_js(const String &p_code);
+	Dictionary spritemancer_query_js(const String &p_code, int p_timeout_msec, const String &p_save_path);
 	Dictionary spritemancer_retry_postprocess(const String &p_project_id, const String &p_animation);
 	Dictionary spritemancer_navigate(const String &p_view);
+	
+	// Phase 18: Bridge Protocol
+	Dictionary batch(const Array &p_commands, bool p_stop_on_error = false);
+	Dictionary set_framing(const String &p_mode);
+	Dictionary set_encoding(const String &p_encoding);
+	Dictionary next_page(const String &p_cursor, int p_page_size = 0);
+	Dictionary close_cursor(const String &p_cursor);
+	Dictionary subscribe(const Array &p_topics);
+	Dictionary unsubscribe(const Array &p_topics);
+	Dictionary bridge_stats(bool p_reset = false);
+	Dictionary trace_start(const String &p_path);
+	Dictionary trace_stop();
 
 	GodotBridge();
 	~GodotBridge();
 };
 
+// Logging gated on GodotBridge::verbosity; the message is only built when printed
+#define BRIDGE_LOG(m_msg) \
+	do { \
+		if (verbosity >= LOG_NORMAL) { \
+			print_line(m_msg); \
+		} \
+	} while (0)
+
+#define BRIDGE_LOG_VERBOSE(m_msg) \
+	do { \
+		if (verbosity >= LOG_VERBOSE) { \
+			print_line(m_msg); \
+		} \
+	} while (0)
+
 #endif // GODOT_BRIDGE_H
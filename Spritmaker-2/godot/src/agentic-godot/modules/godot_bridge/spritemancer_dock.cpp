@@ -5,6 +5,8 @@
 #include "core/io/dir_access.h"
 #include "core/io/file_access.h"
 #include "editor/editor_file_system.h"
+#include "core/templates/hash_set.h"
+#include "editor/editor_paths.h"
 
 void SpriteMancerDock::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("_on_type_selected", "index"), &SpriteMancerDock::_on_type_selected);
@@ -300,14 +302,47 @@ SpriteMancerDock::SpriteMancerDock() {
 	gallery_grid->set_columns(3);
 	gallery_scroll->add_child(gallery_grid);
 
+	gallery_empty_label = memnew(Label);
+	gallery_empty_label->set_text("No generated assets yet");
+	gallery_empty_label->set_horizontal_alignment(HORIZONTAL_ALIGNMENT_CENTER);
+	gallery_grid->add_child(gallery_empty_label);
+
+	// Thumbnails load as items come into view
+	gallery_scroll->get_v_scroll_bar()->connect("value_changed", callable_mp(this, &SpriteMancerDock::_queue_visible_thumbnails).unbind(1));
+	gallery_scroll->connect("resized", callable_mp(this, &SpriteMancerDock::_queue_visible_thumbnails));
+	gallery_grid->connect("sort_children", callable_mp(this, &SpriteMancerDock::_queue_visible_thumbnails), CONNECT_DEFERRED);
+
+	// New, changed and deleted sheets show up without a full rebuild
+	if (EditorFileSystem::get_singleton()) {
+		EditorFileSystem::get_singleton()->connect("filesystem_changed", callable_mp(this, &SpriteMancerDock::_on_filesystem_changed));
+	}
+
 	// HTTP Request node
 	http_request = memnew(HTTPRequest);
 	http_request->connect("request_completed", callable_mp(this, &SpriteMancerDock::_on_http_completed));
 	add_child(http_request);
 
+	// Bodies go straight to disk as they arrive
+	download_path = EditorPaths::get_singleton()->get_cache_dir().path_join("spritemancer_download.bin");
+	http_request->set_download_file(download_path);
+
+	download_timer = memnew(Timer);
+	download_timer->set_wait_time(0.1);
+	download_timer->connect("timeout", callable_mp(this, &SpriteMancerDock::_on_download_progress));
+	add_child(download_timer);
+
 	_set_state(STATE_IDLE);
 }
 
+SpriteMancerDock::~SpriteMancerDock() {
+	// Thumbnail jobs hold this dock
+	for (ThumbJob *job : thumb_jobs) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(job->task_id);
+		memdelete(job);
+	}
+	thumb_jobs.clear();
+}
+
 // ============================================================================
 // Tab handling
 // ============================================================================
@@ -318,7 +353,11 @@ void SpriteMancerDock::_on_tab_changed(int p_tab) {
 	gallery_scroll->set_visible(p_tab == 1);
 
 	if (p_tab == 1) {
-		_refresh_gallery();
+		if (gallery_dirty) {
+			_refresh_gallery();
+		} else {
+			_queue_visible_thumbnails();
+		}
 	}
 }
 
@@ -474,11 +513,13 @@ void SpriteMancerDock::_generate_asset() {
 	}
 
 	body["asset_type"] = asset_type_str;
+	body["response_format"] = "png";  // Sheet as the raw body, project id in X-Project-Id
 
 	String json_body = JSON::stringify(body);
 
 	PackedStringArray headers;
 	headers.push_back("Content-Type: application/json");
+	headers.push_back("Accept: image/png, application/json");
 
 	String url = "https://api.zerograft.online/api/ai/generate-asset";
 	Error err = http_request->request(url, headers, HTTPClient::METHOD_POST, json_body);
@@ -486,18 +527,91 @@ void SpriteMancerDock::_generate_asset() {
 	if (err != OK) {
 		status_label->set_text("Request failed");
 		_set_state(STATE_IDLE);
+	} else {
+		_start_download_progress();
 	}
 }
 
+void SpriteMancerDock::_start_download_progress() {
+	download_sheet_size = Size2i();
+	download_timer->start();
+}
+
+void SpriteMancerDock::_on_download_progress() {
+	int downloaded = http_request->get_downloaded_bytes();
+	if (downloaded <= 0) {
+		return;  // Still generating server-side; keep the current status
+	}
+
+	// The PNG header lands first, so the sheet size is known long before the pixels
+	if (download_sheet_size == Size2i() && downloaded >= 24) {
+		Ref<FileAccess> f = FileAccess::open(download_path, FileAccess::READ);
+		if (f.is_valid() && f->get_length() >= 24) {
+			PackedByteArray head = f->get_buffer(24);
+			static const uint8_t png_signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+			if (memcmp(head.ptr(), png_signature, 8) == 0) {
+				const uint8_t *ihdr = head.ptr() + 16;
+				download_sheet_size.x = (ihdr[0] << 24) | (ihdr[1] << 16) | (ihdr[2] << 8) | ihdr[3];
+				download_sheet_size.y = (ihdr[4] << 24) | (ihdr[5] << 16) | (ihdr[6] << 8) | ihdr[7];
+			}
+		}
+	}
+
+	String text = "Downloading";
+	if (download_sheet_size != Size2i()) {
+		text += " " + itos(download_sheet_size.x) + "x" + itos(download_sheet_size.y) + " sheet";
+	}
+	text += ": " + String::humanize_size(downloaded);
+	int total = http_request->get_body_size();
+	if (total > 0) {
+		text += " / " + String::humanize_size(total) + " (" + itos(int64_t(downloaded) * 100 / total) + "%)";
+	}
+	status_label->set_text(text);
+}
+
 void SpriteMancerDock::_on_http_completed(int p_result, int p_code, const PackedStringArray &p_headers, const PackedByteArray &p_body) {
+	download_timer->stop();
+	// A dropped connection or timeout can still leave a partial body on disk
+	// (and p_code from the headers); it must never be read as a sheet
+	if (p_result != HTTPRequest::RESULT_SUCCESS) {
+		DirAccess::remove_absolute(download_path);
+		status_label->set_text("Generation failed: request error " + itos(p_result));
+		_set_state(STATE_IDLE);
+		return;
+	}
 	if (p_code != 200) {
+		DirAccess::remove_absolute(download_path);
 		status_label->set_text("Generation failed: " + String::num(p_code));
 		_set_state(STATE_IDLE);
 		return;
 	}
 
+	// With a download file set the body arrives on disk, not in p_body
+	PackedByteArray body = p_body.is_empty() ? FileAccess::get_file_as_bytes(download_path) : p_body;
+
+	String content_type;
+	String header_project_id;
+	for (int i = 0; i < p_headers.size(); i++) {
+		String header = p_headers[i];
+		String name = header.get_slice(":", 0).strip_edges().to_lower();
+		if (name == "content-type") {
+			content_type = header.get_slice(":", 1).strip_edges().to_lower();
+		} else if (name == "x-project-id") {
+			header_project_id = header.get_slice(":", 1).strip_edges();
+		}
+	}
+
+	// Raw sheet: decoded once, no JSON or base64 in between
+	if (!pending_animation_request && content_type.begins_with("image/png")) {
+		current_image_data = body;
+		current_project_id = header_project_id;
+		_load_preview_image(current_image_data);
+		_set_state(STATE_PREVIEW);
+		return;
+	}
+
 	String response_text;
-	response_text.parse_utf8((const char *)p_body.ptr(), p_body.size());
+	response_text.parse_utf8((const char *)body.ptr(), body.size());
 
 	JSON json;
 	Error err = json.parse(response_text);
@@ -553,10 +667,11 @@ void SpriteMancerDock::_on_http_completed(int p_result, int p_code, const Packed
 	}
 
 	if (!base64_key.is_empty()) {
-		current_image_base64 = response[base64_key];
+		// Older servers: decode the base64 once and keep the raw PNG
+		current_image_data = core_bind::Marshalls::get_singleton()->base64_to_raw(response[base64_key]);
 		current_project_id = response.get("project_id", "");
 
-		_load_preview_image(current_image_base64);
+		_load_preview_image(current_image_data);
 		_set_state(STATE_PREVIEW);
 	} else {
 		status_label->set_text("No image in response");
@@ -564,14 +679,10 @@ void SpriteMancerDock::_on_http_completed(int p_result, int p_code, const Packed
 	}
 }
 
-void SpriteMancerDock::_load_preview_image(const String &p_base64) {
-	// Decode base64 to image
-	PackedByteArray data = p_base64.to_utf8_buffer();
-	data = core_bind::Marshalls::get_singleton()->base64_to_raw(p_base64);
-
+void SpriteMancerDock::_load_preview_image(const PackedByteArray &p_png) {
 	Ref<Image> img;
 	img.instantiate();
-	Error err = img->load_png_from_buffer(data);
+	Error err = img->load_png_from_buffer(p_png);
 
 	if (err == OK) {
 		Ref<ImageTexture> tex = ImageTexture::create_from_image(img);
@@ -586,7 +697,7 @@ void SpriteMancerDock::_load_preview_image(const String &p_base64) {
 
 void SpriteMancerDock::_clear_preview() {
 	preview_image->set_texture(nullptr);
-	current_image_base64 = "";
+	current_image_data.clear();
 	current_project_id = "";
 }
 
@@ -603,7 +714,7 @@ void SpriteMancerDock::_on_regenerate_pressed() {
 }
 
 void SpriteMancerDock::_on_save_pressed() {
-	if (current_image_base64.is_empty()) {
+	if (current_image_data.is_empty()) {
 		status_label->set_text("No image to save");
 		return;
 	}
@@ -625,16 +736,17 @@ void SpriteMancerDock::_on_save_pressed() {
 
 	String full_path = save_path + filename;
 
-	// Decode and save
-	PackedByteArray data = core_bind::Marshalls::get_singleton()->base64_to_raw(current_image_base64);
-
 	Ref<FileAccess> file = FileAccess::open(full_path, FileAccess::WRITE);
 	if (file.is_valid()) {
-		file->store_buffer(data);
+		file->store_buffer(current_image_data);
 		file->close();
 
-		// Refresh Godot filesystem
-		EditorFileSystem::get_singleton()->scan();
+		// Import along with whatever else was just written
+		if (bridge) {
+			bridge->queue_import(full_path);
+		} else {
+			EditorFileSystem::get_singleton()->scan();
+		}
 
 		status_label->set_text("Saved: " + full_path);
 	} else {
@@ -690,84 +802,228 @@ void SpriteMancerDock::_on_animation_tick() {
 // ============================================================================
 
 void SpriteMancerDock::_refresh_gallery() {
-	// Clear existing items
-	while (gallery_grid->get_child_count() > 0) {
-		Node *child = gallery_grid->get_child(0);
-		gallery_grid->remove_child(child);
-		child->queue_free();
-	}
+	gallery_dirty = false;
 
-	// Load images from save_path
+	// Sync items with save_path instead of rebuilding: unchanged sheets keep
+	// their control and thumbnail, changed ones are marked for a reload
+	Vector<String> files;
 	Ref<DirAccess> dir = DirAccess::open(save_path);
-	if (!dir.is_valid()) {
-		// Show empty state
-		Label *empty = memnew(Label);
-		empty->set_text("No generated assets yet");
-		empty->set_horizontal_alignment(HORIZONTAL_ALIGNMENT_CENTER);
-		gallery_grid->add_child(empty);
-		return;
+	if (dir.is_valid()) {
+		dir->list_dir_begin();
+		String filename = dir->get_next();
+		while (!filename.is_empty()) {
+			if (!dir->current_is_dir() && filename.ends_with(".png")) {
+				files.push_back(filename);
+			}
+			filename = dir->get_next();
+		}
+		files.sort();
 	}
 
-	dir->list_dir_begin();
-	String filename = dir->get_next();
-	int count = 0;
+	HashSet<String> present;
+	for (int i = 0; i < files.size(); i++) {
+		present.insert(save_path + files[i]);
+	}
+	Vector<String> removed;
+	for (const KeyValue<String, GalleryEntry> &kv : gallery_entries) {
+		if (!present.has(kv.key)) {
+			removed.push_back(kv.key);
+		}
+	}
+	for (int i = 0; i < removed.size(); i++) {
+		GalleryEntry &entry = gallery_entries[removed[i]];
+		gallery_grid->remove_child(entry.item);
+		entry.item->queue_free();
+		gallery_entries.erase(removed[i]);
+	}
 
-	while (!filename.is_empty()) {
-		if (!dir->current_is_dir() && filename.ends_with(".png")) {
-			String full_path = save_path + filename;
+	for (int i = 0; i < files.size(); i++) {
+		const String &filename = files[i];
+		String full_path = save_path + filename;
+		uint64_t modified_time = FileAccess::get_modified_time(full_path);
+
+		GalleryEntry *entry = gallery_entries.getptr(full_path);
+		if (!entry) {
+			GalleryEntry new_entry;
 
 			// Create thumbnail container
-			VBoxContainer *item = memnew(VBoxContainer);
-			item->set_custom_minimum_size(Size2(72, 80));
-			item->set_meta("path", full_path);
-
-			// Load image as texture
-			Ref<Image> img;
-			img.instantiate();
-			Error err = img->load(full_path);
-
-			Button *thumb = memnew(Button);
-			thumb->set_custom_minimum_size(Size2(64, 64));
-			thumb->set_meta("path", full_path);
-			thumb->set_tooltip_text(filename);
-
-			if (err == OK) {
-				// Resize for thumbnail
-				img->resize(64, 64, Image::INTERPOLATE_NEAREST);
-				Ref<ImageTexture> tex = ImageTexture::create_from_image(img);
-				thumb->set_icon(tex);
-				thumb->set_icon_alignment(HORIZONTAL_ALIGNMENT_CENTER);
-			} else {
-				thumb->set_text(filename.get_basename().substr(0, 6));
-			}
+			new_entry.item = memnew(VBoxContainer);
+			new_entry.item->set_custom_minimum_size(Size2(72, 80));
+			new_entry.item->set_meta("path", full_path);
+
+			// Placeholder text until the thumbnail arrives
+			new_entry.thumb = memnew(Button);
+			new_entry.thumb->set_custom_minimum_size(Size2(THUMB_SIZE, THUMB_SIZE));
+			new_entry.thumb->set_meta("path", full_path);
+			new_entry.thumb->set_tooltip_text(filename);
+			new_entry.thumb->set_text(filename.get_basename().substr(0, 6));
+			new_entry.thumb->set_icon_alignment(HORIZONTAL_ALIGNMENT_CENTER);
 
 			// Connect click handlers
-			thumb->connect("pressed", callable_mp(this, &SpriteMancerDock::_on_gallery_item_clicked).bind(full_path));
-			thumb->connect("gui_input", callable_mp(this, &SpriteMancerDock::_on_gallery_item_input).bind(full_path));
+			new_entry.thumb->connect("pressed", callable_mp(this, &SpriteMancerDock::_on_gallery_item_clicked).bind(full_path));
+			new_entry.thumb->connect("gui_input", callable_mp(this, &SpriteMancerDock::_on_gallery_item_input).bind(full_path));
 
-			item->add_child(thumb);
+			new_entry.item->add_child(new_entry.thumb);
 
 			// Label below thumbnail
 			Label *name_label = memnew(Label);
 			name_label->set_text(filename.get_basename().substr(0, 8));
 			name_label->set_horizontal_alignment(HORIZONTAL_ALIGNMENT_CENTER);
 			name_label->add_theme_font_size_override("font_size", 10);
-			item->add_child(name_label);
+			new_entry.item->add_child(name_label);
+
+			gallery_grid->add_child(new_entry.item);
+			new_entry.modified_time = modified_time;
+			entry = &gallery_entries.insert(full_path, new_entry)->value;
+		} else if (entry->modified_time != modified_time) {
+			entry->modified_time = modified_time;
+			entry->requested = false;
+		}
+
+		// Keep the grid in filename order
+		gallery_grid->move_child(entry->item, i);
+	}
+
+	gallery_empty_label->set_visible(gallery_entries.is_empty());
+	gallery_grid->move_child(gallery_empty_label, -1);
+	if (!thumb_cache_pruned) {
+		_prune_thumb_cache();
+	}
+	callable_mp(this, &SpriteMancerDock::_queue_visible_thumbnails).call_deferred();
+}
+
+void SpriteMancerDock::_on_filesystem_changed() {
+	if (gallery_scroll->is_visible_in_tree()) {
+		_refresh_gallery();
+	} else {
+		gallery_dirty = true;
+	}
+}
 
-			gallery_grid->add_child(item);
-			count++;
+// Per project, so pruning against this project's gallery leaves others alone
+String SpriteMancerDock::_get_thumb_cache_path(const String &p_path, uint64_t p_modified_time, uint64_t p_size) {
+	String key = p_path + ":" + itos(p_modified_time) + ":" + itos(p_size) + ":" + itos(THUMB_SIZE);
+	return EditorPaths::get_singleton()->get_project_settings_dir().path_join("spritemancer_thumbs").path_join(key.md5_text() + ".png");
+}
+
+// Every rewrite of a sheet leaves its old thumbnail behind, since the key
+// changes with mtime and size. Drop the files no current sheet maps to.
+void SpriteMancerDock::_prune_thumb_cache() {
+	thumb_cache_pruned = true;
+	String cache_dir = _get_thumb_cache_path("", 0, 0).get_base_dir();
+	Ref<DirAccess> dir = DirAccess::open(cache_dir);
+	if (dir.is_null()) {
+		return;
+	}
+
+	HashSet<String> keep;
+	for (const KeyValue<String, GalleryEntry> &kv : gallery_entries) {
+		// Same size as _thumb_job_task reads, 0 if the sheet can't be opened
+		uint64_t size = 0;
+		Ref<FileAccess> f = FileAccess::open(kv.key, FileAccess::READ);
+		if (f.is_valid()) {
+			size = f->get_length();
+		}
+		keep.insert(_get_thumb_cache_path(kv.key, kv.value.modified_time, size).get_file());
+	}
+
+	Vector<String> stale;
+	dir->list_dir_begin();
+	String filename = dir->get_next();
+	while (!filename.is_empty()) {
+		if (!dir->current_is_dir() && filename.ends_with(".png") && !keep.has(filename)) {
+			stale.push_back(filename);
 		}
 		filename = dir->get_next();
 	}
+	dir->list_dir_end();
+	for (int i = 0; i < stale.size(); i++) {
+		dir->remove(stale[i]);
+	}
+}
 
-	if (count == 0) {
-		Label *empty = memnew(Label);
-		empty->set_text("No generated assets yet");
-		empty->set_horizontal_alignment(HORIZONTAL_ALIGNMENT_CENTER);
-		gallery_grid->add_child(empty);
+void SpriteMancerDock::_queue_visible_thumbnails() {
+	if (!gallery_scroll->is_visible_in_tree() || thumb_jobs.size() >= (uint32_t)MAX_THUMB_JOBS) {
+		return;
+	}
+
+	// One screen of slack above and below so scrolling rarely shows placeholders
+	float view_height = gallery_scroll->get_size().y;
+	float top = gallery_scroll->get_v_scroll() - view_height;
+	float bottom = gallery_scroll->get_v_scroll() + view_height * 2.0f;
+
+	for (int i = 0; i < gallery_grid->get_child_count() && thumb_jobs.size() < (uint32_t)MAX_THUMB_JOBS; i++) {
+		Control *item = Object::cast_to<Control>(gallery_grid->get_child(i));
+		if (!item || !item->has_meta("path")) {
+			continue;
+		}
+		float y = item->get_position().y;
+		if (y + item->get_size().y < top || y > bottom) {
+			continue;
+		}
+		GalleryEntry *entry = gallery_entries.getptr(item->get_meta("path"));
+		if (!entry || entry->requested) {
+			continue;
+		}
+
+		entry->requested = true;
+		ThumbJob *job = memnew(ThumbJob);
+		job->path = item->get_meta("path");
+		job->modified_time = entry->modified_time;
+		job->task_id = WorkerThreadPool::get_singleton()->add_template_task(this, &SpriteMancerDock::_thumb_job_task, job, false, "SpriteMancer thumbnail");
+		thumb_jobs.push_back(job);
 	}
 }
 
+void SpriteMancerDock::_thumb_job_task(ThumbJob *p_job) {
+	uint64_t size = 0;
+	{
+		Ref<FileAccess> f = FileAccess::open(p_job->path, FileAccess::READ);
+		if (f.is_valid()) {
+			size = f->get_length();
+		}
+	}
+	String cache_path = _get_thumb_cache_path(p_job->path, p_job->modified_time, size);
+
+	Ref<Image> img;
+	img.instantiate();
+	if (FileAccess::exists(cache_path) && img->load(cache_path) == OK) {
+		p_job->image = img;
+	} else if (img->load(p_job->path) == OK) {
+		// Resize for thumbnail
+		img->resize(THUMB_SIZE, THUMB_SIZE, Image::INTERPOLATE_NEAREST);
+		DirAccess::make_dir_recursive_absolute(cache_path.get_base_dir());
+		img->save_png(cache_path);
+		p_job->image = img;
+	}
+
+	p_job->done.set();
+	callable_mp(this, &SpriteMancerDock::_collect_thumbnails).call_deferred();
+}
+
+void SpriteMancerDock::_collect_thumbnails() {
+	for (uint32_t i = 0; i < thumb_jobs.size();) {
+		ThumbJob *job = thumb_jobs[i];
+		if (!job->done.is_set()) {
+			i++;
+			continue;
+		}
+		// Only the task's return is left to wait for
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(job->task_id);
+		thumb_jobs.remove_at(i);
+
+		// The sheet may have been deleted or rewritten while decoding
+		GalleryEntry *entry = gallery_entries.getptr(job->path);
+		if (entry && entry->modified_time == job->modified_time && job->image.is_valid()) {
+			entry->thumb->set_icon(ImageTexture::create_from_image(job->image));
+			entry->thumb->set_text("");
+		}
+		memdelete(job);
+	}
+
+	_queue_visible_thumbnails();
+}
+
 void SpriteMancerDock::_on_gallery_item_clicked(const String &p_path) {
 	// Load selected asset into preview
 	Ref<Image> img;
@@ -890,6 +1146,7 @@ void SpriteMancerDock::_on_path_selected(const String &p_path) {
 	if (!save_path.ends_with("/")) {
 		save_path += "/";
 	}
+	gallery_dirty = true;
 	if (save_path_input) {
 		save_path_input->set_text(save_path);
 	}
@@ -932,5 +1189,7 @@ void SpriteMancerDock::_on_generate_animation_pressed() {
 	if (err != OK) {
 		status_label->set_text("Animation request failed");
 		pending_animation_request = false;
+	} else {
+		_start_download_progress();
 	}
 }
@@ -20,6 +20,10 @@
 #include "scene/resources/image_texture.h"
 #include "core/input/input_event.h"
 #include "core/io/marshalls.h"
+#include "core/object/worker_thread_pool.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
 #include "godot_bridge.h"
 
 class SpriteMancerDock : public VBoxContainer {
@@ -46,8 +50,34 @@ private:
 	VBoxContainer *generate_tab = nullptr;
 	ScrollContainer *gallery_scroll = nullptr;
 	GridContainer *gallery_grid = nullptr;
+	Label *gallery_empty_label = nullptr;
 	int current_tab = 0;
 
+	// Gallery items are kept across refreshes and synced against save_path.
+	// Thumbnails load only once an item scrolls into view, decoded on
+	// WorkerThreadPool through an on-disk cache keyed by path, mtime and size.
+	struct GalleryEntry {
+		VBoxContainer *item = nullptr;
+		Button *thumb = nullptr;
+		uint64_t modified_time = 0;
+		bool requested = false;  // Thumbnail queued or shown for modified_time
+	};
+	struct ThumbJob {
+		String path;
+		uint64_t modified_time = 0;
+		Ref<Image> image;  // Worker output; null if the source failed to load
+		WorkerThreadPool::TaskID task_id = WorkerThreadPool::INVALID_TASK_ID;
+		// Set by the worker before it posts _collect_thumbnails(); the pool may
+		// not report the task completed yet when that call runs
+		SafeFlag done;
+	};
+	static const int THUMB_SIZE = 64;
+	static const int MAX_THUMB_JOBS = 4;
+	HashMap<String, GalleryEntry> gallery_entries;
+	LocalVector<ThumbJob *> thumb_jobs;
+	bool gallery_dirty = true;  // save_path changed on disk while the tab was hidden
+	bool thumb_cache_pruned = false;  // Once per session, on the first gallery load
+
 	// Generate tab elements
 	OptionButton *type_picker = nullptr;
 	OptionButton *preset_picker = nullptr;
@@ -90,15 +120,19 @@ private:
 	// Status
 	Label *status_label = nullptr;
 
-	// HTTP client
+	// HTTP client. Responses are streamed to download_path rather than
+	// buffered; the server is asked for a raw PNG, with JSON+base64 as fallback.
 	HTTPRequest *http_request = nullptr;
+	String download_path;
+	Timer *download_timer = nullptr;  // Progress while a request is in flight
+	Size2i download_sheet_size;       // From the PNG header, once it has arrived
 	GodotBridge *bridge = nullptr;
 
 	// State
 	DockState current_state = STATE_IDLE;
 	AssetType current_type = ASSET_CHARACTER;
 	String current_project_id = "";
-	String current_image_base64 = "";
+	PackedByteArray current_image_data;  // Raw PNG of the current result
 	int current_frame = 0;
 	int total_frames = 1;
 	bool is_playing = false;
@@ -134,6 +168,8 @@ private:
 
 	// HTTP handling
 	void _on_http_completed(int p_result, int p_code, const PackedStringArray &p_headers, const PackedByteArray &p_body);
+	void _on_download_progress();
+	void _start_download_progress();
 	void _request_presets();
 	void _generate_asset();
 
@@ -143,11 +179,17 @@ private:
 	void _on_gallery_item_input(const Ref<InputEvent> &p_event, const String &p_path);
 	void _show_gallery_context_menu(const String &p_path, const Vector2 &p_pos);
 	void _on_gallery_context_action(int p_id, const String &p_path);
+	void _on_filesystem_changed();
+	void _queue_visible_thumbnails();
+	void _thumb_job_task(ThumbJob *p_job);
+	void _collect_thumbnails();
+	static String _get_thumb_cache_path(const String &p_path, uint64_t p_modified_time, uint64_t p_size);
+	void _prune_thumb_cache();
 
 	// State management
 	void _set_state(DockState p_state);
 	void _update_ui();
-	void _load_preview_image(const String &p_base64);
+	void _load_preview_image(const PackedByteArray &p_png);
 	void _clear_preview();
 
 protected:
@@ -155,7 +197,10 @@ protected:
 
 public:
 	void set_bridge(GodotBridge *p_bridge);
-	void set_save_path(const String &p_path) { save_path = p_path; }
+	void set_save_path(const String &p_path) {
+		save_path = p_path;
+		gallery_dirty = true;
+	}
 	String get_save_path() const { return save_path; }
 
 	// External control (for AI)
@@ -166,6 +211,7 @@ public:
 	Ref<ImageTexture> get_current_texture() const { return preview_image ? Object::cast_to<ImageTexture>(preview_image->get_texture().ptr()) : nullptr; }
 
 	SpriteMancerDock();
+	~SpriteMancerDock();
 };
 
 VARIANT_ENUM_CAST(SpriteMancerDock::AssetType);
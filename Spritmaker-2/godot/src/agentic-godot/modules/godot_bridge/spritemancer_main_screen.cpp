@@ -8,6 +8,7 @@
 #include "core/io/resource_loader.h"
 #include "core/io/dir_access.h"
 #include "core/config/project_settings.h"
+#include "scene/main/scene_tree.h"
 
 void SpriteMancerMainScreen::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("_on_open_browser"), &SpriteMancerMainScreen::_on_open_browser);
@@ -177,6 +178,65 @@ void SpriteMancerMainScreen::toggle_embedded_mode(bool p_enabled) {
 	}
 }
 
+// Create and initialize the GDCef node once. It lives under the main screen
+// (not the embedded editor) so the pool can be warmed before the editor opens.
+bool SpriteMancerMainScreen::_ensure_cef() {
+	if (cef_node) {
+		return true;
+	}
+	if (cef_init_failed || !ClassDB::class_exists("GDCef")) {
+		return false;
+	}
+	
+	print_line("[SpriteMancer] GDCef class found - initializing browser...");
+	Node *node = Object::cast_to<Node>(ClassDB::instantiate("GDCef"));
+	if (!node) {
+		cef_init_failed = true;
+		return false;
+	}
+	node->set_name("GDCef");
+	add_child(node);
+	
+	// CEF is bundled with Godot - no artifacts path needed!
+	// The gdcef module automatically finds cefsimple.app next to the executable
+	Dictionary init_params;
+	// Disable keychain access to avoid macOS password prompts
+	init_params["disable_keychain"] = true;
+	// Additional command line switches to disable cookie encryption
+	Array switches;
+	switches.push_back("--use-mock-keychain");  // Use mock keychain on macOS
+	switches.push_back("--disable-features=PasswordManager");
+	init_params["command_line_switches"] = switches;
+	bool init_success = node->call("initialize", init_params);
+	if (!init_success) {
+		cef_init_failed = true;
+		remove_child(node);
+		node->queue_free();
+		return false;
+	}
+	cef_node = node;
+	return true;
+}
+
+String SpriteMancerMainScreen::_embedded_editor_url() const {
+	if (!current_project_id.is_empty()) {
+		return frontend_url + "/editor/" + current_project_id;
+	}
+	return frontend_url;
+}
+
+// Start CEF and load the editor shell into a hidden pooled browser, so the
+// first toggle into embedded mode only attaches it
+void SpriteMancerMainScreen::_prewarm_embedded_editor() {
+	if (embedded_editor || !_ensure_cef()) {
+		return;
+	}
+	Dictionary config;
+	config["frame_rate"] = 30;
+	cef_node->call("warm_pool", _embedded_editor_url(), 1, config);
+	print_line("[SpriteMancer] Embedded editor pre-warmed");
+}
+
 void SpriteMancerMainScreen::_load_embedded_editor() {
 	if (embedded_editor) {
 		content->set_visible(false);
@@ -184,11 +244,7 @@ void SpriteMancerMainScreen::_load_embedded_editor() {
 		if (cef_browser) {
 			cef_browser->call("set_hidden", false);
 		}
-		String url = frontend_url;
-		if (!current_project_id.is_empty()) {
-			url = frontend_url + "/editor/" + current_project_id;
-		}
-		status_label->set_text("Embedded editor loaded: " + url);
+		status_label->set_text("Embedded editor loaded: " + _embedded_editor_url());
 		return;
 	}
 	
@@ -216,62 +272,31 @@ void SpriteMancerMainScreen::_load_embedded_editor() {
 	
 	content_panel->add_child(embedded_editor);
 	
-	// Try to instantiate GDCef browser if available
-	if (ClassDB::class_exists("GDCef")) {
-		print_line("[SpriteMancer] GDCef class found - initializing browser...");
+	// Take a pre-warmed browser from GDCef's pool if available
+	if (_ensure_cef()) {
+		String url = _embedded_editor_url();
 		
-		// Create GDCef node dynamically
-		Object *cef_obj = ClassDB::instantiate("GDCef");
-		if (cef_obj) {
-			Node *cef_node = Object::cast_to<Node>(cef_obj);
-			if (cef_node) {
-				cef_node->set_name("GDCef");
-				embedded_editor->add_child(cef_node);
-				
-				// CEF is bundled with Godot - no artifacts path needed!
-				// The gdcef module automatically finds cefsimple.app next to the executable
-				Dictionary init_params;
-				// Disable keychain access to avoid macOS password prompts
-				init_params["disable_keychain"] = true;
-				init_params["incognito"] = true;  // No persistent storage
-				// Additional command line switches to disable cookie encryption
-				Array switches;
-				switches.push_back("--use-mock-keychain");  // Use mock keychain on macOS
-				switches.push_back("--disable-features=PasswordManager");
-				init_params["command_line_switches"] = switches;
-				bool init_success = cef_node->call("initialize", init_params);
-				
-				if (init_success) {
-					// Create browser with frontend URL
-					String url = frontend_url;
-					if (!current_project_id.is_empty()) {
-						url = frontend_url + "/editor/" + current_project_id;
-					}
-					
-					Dictionary config;
-					config["javascript"] = true;
-					config["webgl"] = true;
-					config["frame_rate"] = 30;
-					
-					Object *browser = cef_node->call("create_browser", url, texture_rect, config);
-					if (browser) {
-						cef_browser = browser;  // Store browser reference
-						texture_rect->set_cef_browser(browser);  // Give DragDropTextureRect access to browser
-						print_line("[SpriteMancer] Browser created successfully!");
-						status_label->set_text("Embedded editor loaded: " + url);
-						
-						// Connect gui_input signal for mouse/keyboard forwarding
-						texture_rect->connect("gui_input", callable_mp(this, &SpriteMancerMainScreen::_on_browser_input));
-					} else {
-						print_line("[SpriteMancer] Failed to create browser");
-						status_label->set_text("Failed to create browser");
-					}
-				} else {
-					print_line("[SpriteMancer] GDCef initialization failed");
-					status_label->set_text("CEF initialization failed");
-				}
-			}
+		Dictionary config;
+		config["javascript"] = true;
+		config["webgl"] = true;
+		config["frame_rate"] = 30;
+		
+		Object *browser = cef_node->call("acquire_browser", url, texture_rect, config);
+		if (browser) {
+			cef_browser = browser;  // Store browser reference
+			texture_rect->set_cef_browser(browser);  // Give DragDropTextureRect access to browser
+			print_line("[SpriteMancer] Browser created successfully!");
+			status_label->set_text("Embedded editor loaded: " + url);
+			
+			// Connect gui_input signal for mouse/keyboard forwarding
+			texture_rect->connect("gui_input", callable_mp(this, &SpriteMancerMainScreen::_on_browser_input));
+		} else {
+			print_line("[SpriteMancer] Failed to create browser");
+			status_label->set_text("Failed to create browser");
 		}
+	} else if (ClassDB::class_exists("GDCef")) {
+		print_line("[SpriteMancer] GDCef initialization failed");
+		status_label->set_text("CEF initialization failed");
 	} else {
 		print_line("[SpriteMancer] GDCef not found - using placeholder");
 		
@@ -395,6 +420,12 @@ void SpriteMancerMainScreen::_on_browser_resized() {
 
 void SpriteMancerMainScreen::_notification(int p_what) {
 	switch (p_what) {
+		case NOTIFICATION_READY: {
+			if (ClassDB::class_exists("GDCef") && get_tree()) {
+				get_tree()->create_timer(PREWARM_DELAY_SEC)->connect("timeout", callable_mp(this, &SpriteMancerMainScreen::_prewarm_embedded_editor));
+			}
+			break;
+		}
 		case NOTIFICATION_VISIBILITY_CHANGED: {
 			// Auto-pause/resume browser when tab becomes visible/hidden
 			if (cef_browser && embedded_mode) {
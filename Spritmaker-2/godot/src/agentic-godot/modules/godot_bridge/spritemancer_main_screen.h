@@ -57,6 +57,12 @@ private:
 	Control *embedded_editor = nullptr;
 	TextureRect *browser_texture_rect = nullptr;
 	Object *cef_browser = nullptr;  // GDBrowserView*
+	Node *cef_node = nullptr;       // GDCef, owns the browser pool
+	bool cef_init_failed = false;
+	
+	// Browser pool warm-up starts this long after the editor is up, so CEF's
+	// process startup doesn't compete with the editor's own
+	static constexpr double PREWARM_DELAY_SEC = 3.0;
 
 	void _on_open_browser();
 	void _on_refresh();
@@ -64,6 +70,9 @@ private:
 	void _on_next_frame();
 	void _on_play();
 	void _on_toggle_embedded();
+	bool _ensure_cef();
+	String _embedded_editor_url() const;
+	void _prewarm_embedded_editor();
 	void _load_embedded_editor();
 	void _unload_embedded_editor();
 	void _on_browser_input(const Ref<InputEvent> &p_event);
@@ -0,0 +1,335 @@
+#!/usr/bin/env python3
+"""Record/replay benchmark harness for the godot_bridge protocol.
+
+Subcommands:
+  make-fixture SIZE DIR   Generate a small/medium/large fixture project
+  make-trace SIZE FILE    Generate a benchmark trace for a fixture size
+  replay TRACE            Replay a trace against a running editor and report
+                          commands/sec and per-command latency
+
+Traces are the JSON-lines files written by the bridge (trace_start command or
+GODOT_BRIDGE_TRACE environment variable). Only JSON-encoded messages can be
+replayed; binary entries are counted and skipped.
+"""
+
+import argparse
+import json
+import os
+import socket
+import struct
+import sys
+import time
+import zlib
+
+FIXTURE_SIZES = {
+    # nodes in main.tscn, scripts, lines per script, tilemap cells per batch
+    "small": {"nodes": 50, "scripts": 20, "lines": 40, "cells": 256},
+    "medium": {"nodes": 1000, "scripts": 200, "lines": 120, "cells": 4096},
+    "large": {"nodes": 10000, "scripts": 2000, "lines": 200, "cells": 65536},
+}
+
+BENCH_ITERATIONS = 20
+
+
+# ============ Fixture Generation ============
+
+def write_tile_png(path, side=16):
+    """Solid-colour RGBA PNG used as the fixture's single atlas tile."""
+    def chunk(tag, data):
+        return struct.pack(">I", len(data)) + tag + data + struct.pack(">I", zlib.crc32(tag + data) & 0xFFFFFFFF)
+    rows = b"".join(b"\x00" + b"\x40\x80\xc0\xff" * side for _ in range(side))
+    with open(path, "wb") as f:
+        f.write(b"\x89PNG\r\n\x1a\n")
+        f.write(chunk(b"IHDR", struct.pack(">IIBBBBB", side, side, 8, 6, 0, 0, 0)))
+        f.write(chunk(b"IDAT", zlib.compress(rows)))
+        f.write(chunk(b"IEND", b""))
+
+
+def make_fixture(size, out_dir):
+    spec = FIXTURE_SIZES[size]
+    os.makedirs(os.path.join(out_dir, "scripts"), exist_ok=True)
+
+    with open(os.path.join(out_dir, "project.godot"), "w") as f:
+        f.write("config_version=5\n\n[application]\n\n")
+        f.write('config/name="bridge_bench_%s"\n' % size)
+        f.write('run/main_scene="res://main.tscn"\n')
+
+    for i in range(spec["scripts"]):
+        with open(os.path.join(out_dir, "scripts", "script_%04d.gd" % i), "w") as f:
+            f.write("extends Node2D\n\n")
+            for line in range(spec["lines"]):
+                if line % 10 == 0:
+                    f.write("func step_%d(delta: float) -> void:\n" % line)
+                elif line % 10 == 5:
+                    f.write("\t# TODO: tune speed_%d\n" % line)
+                else:
+                    f.write("\tposition.x += delta * %d\n" % line)
+
+    # One atlas source with tile (0, 0), so map benchmarks place real cells
+    write_tile_png(os.path.join(out_dir, "tile.png"))
+
+    # Balanced tree: children of node k are k*8+1 .. k*8+8
+    with open(os.path.join(out_dir, "main.tscn"), "w") as f:
+        f.write('[gd_scene load_steps=4 format=3]\n\n')
+        f.write('[ext_resource type="Texture2D" path="res://tile.png" id="1_tile"]\n\n')
+        f.write('[sub_resource type="TileSetAtlasSource" id="TileSetAtlasSource_bench"]\n')
+        f.write('texture = ExtResource("1_tile")\n')
+        f.write('0:0/0 = 0\n\n')
+        f.write('[sub_resource type="TileSet" id="TileSet_bench"]\n')
+        f.write('sources/0 = SubResource("TileSetAtlasSource_bench")\n\n')
+        f.write('[node name="Main" type="Node2D"]\n\n')
+        f.write('[node name="Tiles" type="TileMapLayer" parent="."]\n')
+        f.write('tile_set = SubResource("TileSet_bench")\n\n')
+        paths = {0: "."}
+        for k in range(1, spec["nodes"]):
+            parent = (k - 1) // 8
+            name = "Node%d" % k
+            f.write('[node name="%s" type="Node2D" parent="%s"]\n\n' % (name, paths[parent]))
+            paths[k] = name if parent == 0 else paths[parent] + "/" + name
+
+    print("Fixture '%s' written to %s" % (size, out_dir))
+
+
+def make_trace(size, out_file):
+    spec = FIXTURE_SIZES[size]
+    side = int(spec["cells"] ** 0.5)
+    cells = [{"coords": [x, y], "source_id": 0, "atlas_coords": [0, 0]} for y in range(side) for x in range(side)]
+    packed = {"format": "columns", "x": [x for y in range(side) for x in range(side)],
+              "y": [y for y in range(side) for x in range(side)], "source": 0, "atlas_x": 0, "atlas_y": 0}
+
+    requests = []
+    for i in range(BENCH_ITERATIONS):
+        requests.append(("get_scene_tree", {"max_depth": 10}))
+        requests.append(("search_in_scripts", {"pattern": "TODO", "is_regex": False, "page_size": 500}))
+        requests.append(("map_set_cells_batch", {"tilemap_path": "Tiles", "cells": cells}))
+        requests.append(("map_set_cells_batch", {"tilemap_path": "Tiles", "packed": packed}))
+        requests.append(("map_get_cells", {"tilemap_path": "Tiles", "format": "rle"}))
+        requests.append(("capture_viewport", {"viewport": "editor"}))
+
+    with open(out_file, "w") as f:
+        f.write(json.dumps({"trace": "godot_bridge", "version": 1, "synthetic": size}) + "\n")
+        for n, (method, params) in enumerate(requests):
+            message = json.dumps({"id": "bench-%d" % n, "method": method, "params": params})
+            f.write(json.dumps({"t_usec": n * 10000, "client": 1, "method": method,
+                                "encoding": "json", "message": message}) + "\n")
+    print("Trace with %d requests written to %s" % (len(requests), out_file))
+
+
+# ============ Replay ============
+
+class ReplayClient:
+    """One socket per recorded client, speaking the client's negotiated framing."""
+
+    def __init__(self, host, port):
+        self.sock = socket.create_connection((host, port))
+        self.sock.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+        self.buffer = b""
+        self.length_prefixed = False
+
+    def send(self, payload):
+        if self.length_prefixed:
+            self.sock.sendall(struct.pack(">I", len(payload)) + payload)
+        else:
+            self.sock.sendall(payload + b"\n")
+
+    def read_message(self):
+        while True:
+            if self.length_prefixed:
+                if len(self.buffer) >= 4:
+                    size = struct.unpack(">I", self.buffer[:4])[0]
+                    if len(self.buffer) >= 4 + size:
+                        frame = self.buffer[4:4 + size]
+                        self.buffer = self.buffer[4 + size:]
+                        return frame
+            else:
+                newline = self.buffer.find(b"\n")
+                if newline != -1:
+                    frame = self.buffer[:newline]
+                    self.buffer = self.buffer[newline + 1:]
+                    return frame
+            chunk = self.sock.recv(1 << 20)
+            if not chunk:
+                raise ConnectionError("bridge closed the connection")
+            self.buffer += chunk
+
+
+def _percentile(sorted_values, fraction):
+    if not sorted_values:
+        return 0.0
+    index = min(len(sorted_values) - 1, int(fraction * len(sorted_values)))
+    return sorted_values[index]
+
+
+def load_trace(path):
+    entries = []
+    with open(path) as f:
+        for line in f:
+            line = line.strip()
+            if not line:
+                continue
+            entry = json.loads(line)
+            if "trace" in entry:
+                continue
+            entries.append(entry)
+    entries.sort(key=lambda e: e["t_usec"])
+    return entries
+
+
+def replay(args):
+    entries = load_trace(args.trace)
+    clients = {}
+    pending = {}  # request id -> (client key, method, send time)
+    latencies = {}
+    bytes_in = {}
+    errors = {}
+    skipped = 0
+    replayed = 0
+
+    def client_for(key):
+        if key not in clients:
+            clients[key] = ReplayClient(args.host, args.port)
+        return clients[key]
+
+    def await_response(client):
+        # Read until one of our responses arrives
+        while True:
+            frame = client.read_message()
+            message = json.loads(frame)
+            if message.get("type") != "response":
+                continue  # events, chunks
+            request = pending.pop(message.get("id"), None)
+            if request is None:
+                continue
+            method, sent = request[1], request[2]
+            latencies.setdefault(method, []).append(time.perf_counter() - sent)
+            bytes_in[method] = bytes_in.get(method, 0) + len(frame)
+            result = message.get("result", {})
+            if isinstance(result, dict) and ("error" in result or result.get("success") is False):
+                errors[method] = errors.get(method, 0) + 1
+            return result
+
+    def drain(key):
+        client = clients[key]
+        while any(p[0] == key for p in pending.values()):
+            await_response(client)
+
+    start = time.perf_counter()
+    for n, entry in enumerate(entries):
+        if entry.get("encoding", "json") != "json" or "message" not in entry:
+            skipped += 1
+            continue
+
+        message = json.loads(entry["message"])
+        method = message.get("method", "")
+        if method == "set_encoding" and message.get("params", {}).get("encoding", "json") != "json":
+            skipped += 1
+            continue
+
+        if args.pace == "recorded":
+            delay = entry["t_usec"] / 1e6 - (time.perf_counter() - start)
+            if delay > 0:
+                time.sleep(delay)
+
+        key = entry.get("client", 0)
+        client = client_for(key)
+        request_id = "replay-%d" % n
+        message["id"] = request_id
+        in_flight = sum(1 for p in pending.values() if p[0] == key)
+        if in_flight >= args.window:
+            await_response(client)
+
+        pending[request_id] = (key, method, time.perf_counter())
+        client.send(json.dumps(message).encode("utf-8"))
+        replayed += 1
+
+        # Framing switches only apply once their response is back
+        if method == "set_framing":
+            drain(key)
+            client.length_prefixed = message.get("params", {}).get("mode") == "length_prefixed"
+
+    for key in list(clients):
+        drain(key)
+    elapsed = time.perf_counter() - start
+
+    report = {"trace": args.trace, "pace": args.pace, "commands": replayed, "skipped": skipped,
+              "elapsed_sec": elapsed, "commands_per_sec": replayed / elapsed if elapsed > 0 else 0.0,
+              "methods": {}}
+    for method, values in sorted(latencies.items()):
+        values.sort()
+        report["methods"][method] = {
+            "count": len(values),
+            "errors": errors.get(method, 0),
+            "p50_msec": _percentile(values, 0.50) * 1000.0,
+            "p95_msec": _percentile(values, 0.95) * 1000.0,
+            "p99_msec": _percentile(values, 0.99) * 1000.0,
+            "max_msec": values[-1] * 1000.0,
+            "bytes_in": bytes_in.get(method, 0),
+        }
+    return report
+
+
+def print_report(report):
+    print("Replayed %d commands in %.2f s (%.1f commands/sec, %d skipped)" % (
+        report["commands"], report["elapsed_sec"], report["commands_per_sec"], report["skipped"]))
+    print("%-28s %7s %7s %10s %10s %10s %10s" % ("method", "count", "errors", "p50 ms", "p95 ms", "p99 ms", "max ms"))
+    for method, m in report["methods"].items():
+        print("%-28s %7d %7d %10.2f %10.2f %10.2f %10.2f" % (
+            method, m["count"], m["errors"], m["p50_msec"], m["p95_msec"], m["p99_msec"], m["max_msec"]))
+
+
+def compare_baseline(report, baseline_path, tolerance):
+    """Return the methods whose p95 regressed by more than tolerance."""
+    with open(baseline_path) as f:
+        baseline = json.load(f)
+    regressions = []
+    for method, m in report["methods"].items():
+        base = baseline.get("methods", {}).get(method)
+        if base and base["p95_msec"] > 0 and m["p95_msec"] > base["p95_msec"] * (1.0 + tolerance):
+            regressions.append("%s p95 %.2f ms vs baseline %.2f ms" % (method, m["p95_msec"], base["p95_msec"]))
+    return regressions
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    sub = parser.add_subparsers(dest="command", required=True)
+
+    p = sub.add_parser("make-fixture")
+    p.add_argument("size", choices=FIXTURE_SIZES.keys())
+    p.add_argument("dir")
+
+    p = sub.add_parser("make-trace")
+    p.add_argument("size", choices=FIXTURE_SIZES.keys())
+    p.add_argument("file")
+
+    p = sub.add_parser("replay")
+    p.add_argument("trace")
+    p.add_argument("--host", default="127.0.0.1")
+    p.add_argument("--port", type=int, default=9876)
+    p.add_argument("--pace", choices=["max", "recorded"], default="max",
+                   help="max: pipeline as fast as possible; recorded: keep the trace's timing")
+    p.add_argument("--window", type=int, default=32, help="max requests in flight per client")
+    p.add_argument("--json", help="write the report to this file")
+    p.add_argument("--baseline", help="fail if any p95 regresses against this report")
+    p.add_argument("--tolerance", type=float, default=0.2, help="allowed p95 regression (0.2 = 20%%)")
+
+    args = parser.parse_args()
+    if args.command == "make-fixture":
+        make_fixture(args.size, args.dir)
+    elif args.command == "make-trace":
+        make_trace(args.size, args.file)
+    else:
+        report = replay(args)
+        print_report(report)
+        if args.json:
+            with open(args.json, "w") as f:
+                json.dump(report, f, indent=2)
+        if args.baseline:
+            regressions = compare_baseline(report, args.baseline, args.tolerance)
+            for line in regressions:
+                print("REGRESSION: " + line)
+            if regressions:
+                sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
@@ -217,9 +217,10 @@ export class SpriteMancerPipeline {
         // For pixel art, we set filter=false, mipmaps=false
         // This would be done via editor settings or resource import config
 
-        // Update specific file in Godot filesystem (synchronous, more reliable)
+        // Update specific file in Godot filesystem; wait so it is imported
+        // before the SpriteFrames that reference it are built
         try {
-            await executeGodot('assets_update_file', { path: imagePath });
+            await executeGodot('assets_update_file', { path: imagePath, wait: true });
             console.log(`[Pipeline] File updated in Godot: ${imagePath}`);
         } catch (e) {
             // Fallback to scan if update_file not available
@@ -299,18 +299,20 @@ export const TOOL_DEFINITIONS: ToolDefinition[] = [
     },
     {
         name: "assets_update_file",
-        description: "Update Godot's knowledge of a specific file that was changed or added externally",
+        description: "Update Godot's knowledge of a specific file that was changed or added externally. Queues the import and returns at once unless wait is true",
         params: {
             path: { type: "string", description: "Path to file (res://sprites/knight.png)", required: true },
+            wait: { type: "boolean", description: "Import before returning (needed if the next step loads the file)", required: false },
             explanation: { type: "string", description: "Why updating this file", required: true }
         },
         whenToUse: "When you know a specific file was modified externally and need Godot to reimport it"
     },
     {
         name: "assets_reimport",
-        description: "Force reimport of a specific resource file with current import settings",
+        description: "Force reimport of a specific resource file with current import settings. Queues the import and returns at once unless wait is true",
         params: {
             path: { type: "string", description: "Path to resource (res://sprites/knight.png)", required: true },
+            wait: { type: "boolean", description: "Import before returning (needed if the next step loads the file)", required: false },
             explanation: { type: "string", description: "Why reimporting this asset", required: true }
         },
         whenToUse: "When sprite import settings need to be applied (e.g., pixel art filter disabled)"
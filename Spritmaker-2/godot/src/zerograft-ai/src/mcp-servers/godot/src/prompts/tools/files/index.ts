@@ -98,12 +98,16 @@ export const assets_update_file: GodotToolSpec = {
     id: "assets_update_file",
     variant: ModelFamily.GENERIC,
     name: "assets_update_file",
-    description: "Update Godot's knowledge of a specific file that was changed externally",
+    description: "Update Godot's knowledge of a specific file that was changed externally. Queues the import and returns at once unless wait is true",
     parameters: [
         {
             name: "path", required: true, type: "string",
             description: "Path to file (res://sprites/knight.png)"
         },
+        {
+            name: "wait", required: false, type: "boolean",
+            description: "Import before returning (needed if the next step loads the file)"
+        },
         {
             name: "explanation", required: true, type: "string",
             description: "Why updating this file"
@@ -115,12 +119,16 @@ export const assets_reimport: GodotToolSpec = {
     id: "assets_reimport",
     variant: ModelFamily.GENERIC,
     name: "assets_reimport",
-    description: "Force reimport of a specific resource file with current import settings",
+    description: "Force reimport of a specific resource file with current import settings. Queues the import and returns at once unless wait is true",
     parameters: [
         {
             name: "path", required: true, type: "string",
             description: "Path to resource (res://sprites/knight.png)"
         },
+        {
+            name: "wait", required: false, type: "boolean",
+            description: "Import before returning (needed if the next step loads the file)"
+        },
         {
             name: "explanation", required: true, type: "string",
             description: "Why reimporting this asset"